@@ -9,7 +9,7 @@ layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in float a_TexIndex;
 layout(location = 4) in float a_TilingFactor;
 
-layout(std140, binding = 0) uniform Camera
+layout(std140, binding = 0) uniform DynamicCamera
 {
 	mat4 u_ViewProjection;
 };
@@ -0,0 +1,63 @@
+// Basic Texture Shader, bindless
+// TexIndex is a Texture2D::get_bindless_index, sampled from the device-wide table in set 1.
+
+#version 450 core
+#pragma stage : vert
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+
+layout(std140, binding = 0) uniform DynamicCamera
+{
+	mat4 u_ViewProjection;
+};
+
+layout(push_constant) uniform Transform
+{
+	mat4 Transform;
+}
+u_Renderer;
+
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 5) out flat float TexIndex;
+
+void main()
+{
+	Output.Color = a_Color;
+	Output.TexCoord = a_TexCoord;
+	TexIndex = a_TexIndex;
+	Output.TilingFactor = a_TilingFactor;
+	gl_Position = u_ViewProjection * u_Renderer.Transform * vec4(a_Position, 1.0);
+}
+
+#version 450 core
+#pragma stage : frag
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) out vec4 color;
+
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 5) in flat float TexIndex;
+
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+void main()
+{
+	color = texture(u_Textures[nonuniformEXT(int(TexIndex))], Input.TexCoord * Input.TilingFactor) * Input.Color;
+}
+
@@ -6,7 +6,7 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 
-layout (std140, binding = 0) uniform Camera
+layout (std140, binding = 0) uniform DynamicCamera
 {
 	mat4 u_ViewProjection;
 };
@@ -0,0 +1,71 @@
+// Instanced Sprite Shader, bindless
+// One Renderer2D::QuadInstance per sprite, expanded to a quad here.
+
+#version 450 core
+#pragma stage : vert
+
+// Per vertex: the unit quad
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_TexCoord;
+
+// Per instance
+layout(location = 2) in vec3 a_Position;
+layout(location = 3) in uvec2 a_Basis;
+layout(location = 4) in uvec2 a_UVRect;
+layout(location = 5) in uint a_Color;
+layout(location = 6) in uint a_TextureIndex;
+
+layout(std140, binding = 0) uniform DynamicCamera
+{
+	mat4 u_ViewProjection;
+};
+
+layout(push_constant) uniform Transform
+{
+	mat4 Transform;
+}
+u_Renderer;
+
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 5) out flat uint TexIndex;
+
+void main()
+{
+	vec2 axis_x = unpackHalf2x16(a_Basis.x);
+	vec2 axis_y = unpackHalf2x16(a_Basis.y);
+	vec2 position = a_Position.xy + axis_x * a_Corner.x + axis_y * a_Corner.y;
+
+	vec2 uv_min = unpackUnorm2x16(a_UVRect.x);
+	vec2 uv_max = unpackUnorm2x16(a_UVRect.y);
+
+	Output.Color = unpackUnorm4x8(a_Color);
+	Output.TexCoord = mix(uv_min, uv_max, a_TexCoord);
+	TexIndex = a_TextureIndex;
+	gl_Position = u_ViewProjection * u_Renderer.Transform * vec4(position, a_Position.z, 1.0);
+}
+
+#version 450 core
+#pragma stage : frag
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) out vec4 color;
+
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 5) in flat uint TexIndex;
+
+layout(set = 1, binding = 0) uniform sampler2D u_Textures[];
+
+void main()
+{
+	color = texture(u_Textures[nonuniformEXT(TexIndex)], Input.TexCoord) * Input.Color;
+}
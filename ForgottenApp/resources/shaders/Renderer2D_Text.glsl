@@ -8,7 +8,7 @@ layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in float a_TexIndex;
 
-layout (std140, binding = 0) uniform Camera
+layout (std140, binding = 0) uniform DynamicCamera
 {
 	mat4 u_ViewProjection;
 };
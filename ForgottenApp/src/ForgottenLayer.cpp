@@ -3,7 +3,12 @@
 #include "Enumeration.hpp"
 #include "fg.hpp"
 #include "imgui/CoreUserInterface.hpp"
+#include "render/IndexBuffer.hpp"
+#include "render/Material.hpp"
+#include "render/Pipeline.hpp"
 #include "render/RendererAPI.hpp"
+#include "render/Texture.hpp"
+#include "render/VertexBuffer.hpp"
 
 // Note: Switch this to true to enable dockspace
 static auto is_dockspace_open = true;
@@ -201,6 +206,24 @@ void ForgottenLayer::on_ui_render(const TimeStep& ts)
 		ImGui::Begin("Stats");
 		{
 			ImGui::Text("Renderer Stats:");
+			const auto& frame_stats = Renderer::get_frame_stats();
+			ImGui::Text("Heap allocations / frame: %llu (%llu bytes)", (unsigned long long)frame_stats.heap_allocations,
+				(unsigned long long)frame_stats.heap_bytes);
+			ImGui::Text("Frame allocator: %zu / %zu bytes", frame_stats.frame_allocator_bytes, frame_stats.frame_allocator_capacity);
+			const auto& queue_stats = Renderer::get_command_queue_stats();
+			ImGui::Text("Render commands: %u (peak %u)", queue_stats.command_count, queue_stats.peak_command_count);
+			ImGui::Text("Command queue: %zu bytes (peak %zu, committed %zu)", queue_stats.bytes, queue_stats.peak_bytes, queue_stats.committed_bytes);
+			ImGui::Text("Live resources: %u vertex buffers, %u index buffers, %u textures, %u materials, %u pipelines",
+				VertexBuffer::get_pool().size(), IndexBuffer::get_pool().size(), Texture2D::get_pool().size(), Material::get_pool().size(),
+				Pipeline::get_pool().size());
+			uint64_t texture_bytes = 0;
+			Texture2D::get_pool().for_each([&texture_bytes](Texture2D* texture) {
+				texture_bytes += Utils::get_image_memory_size(texture->get_format(), texture->get_width(), texture->get_height());
+			});
+			ImGui::Text("Texture memory: %.2f MB (mips not counted)", (double)texture_bytes / (1024.0 * 1024.0));
+			const auto timings = Application::the().get_render_thread_timings();
+			ImGui::Text("Main thread: %.2f ms work, %.2f ms wait", timings.main_thread_work_time, timings.main_thread_wait_time);
+			ImGui::Text("Render thread: %.2f ms work, %.2f ms wait", timings.render_thread_work_time, timings.render_thread_wait_time);
 			std::string name = "None";
 			ImGui::Text("Hovered Entity: %s", name.c_str());
 		}
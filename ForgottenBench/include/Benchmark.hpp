@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ForgottenBench {
+
+	struct BenchmarkResult {
+		std::string name;
+		uint64_t operations = 0;
+		double seconds = 0.0;
+
+		[[nodiscard]] double operations_per_second() const { return seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0; }
+		[[nodiscard]] double nanoseconds_per_operation() const { return operations ? seconds * 1e9 / static_cast<double>(operations) : 0.0; }
+	};
+
+	/// A benchmark body runs the measured work once and returns how many operations it performed.
+	using BenchmarkFunction = std::function<uint64_t(void)>;
+
+	class Benchmarks {
+	public:
+		static void add(std::string name, BenchmarkFunction&& function);
+
+		/// Runs every benchmark whose name contains `filter`, keeping the fastest of `repetitions` runs.
+		static std::vector<BenchmarkResult> run(std::string_view filter, uint32_t repetitions);
+
+	private:
+		struct Entry {
+			std::string name;
+			BenchmarkFunction function;
+		};
+
+		static std::vector<Entry>& entries();
+	};
+
+	struct BenchmarkRegistrar {
+		BenchmarkRegistrar(std::string name, BenchmarkFunction&& function) { Benchmarks::add(std::move(name), std::move(function)); }
+	};
+
+	/// Keeps the optimiser from discarding a value that is only computed for its side effects.
+	template <typename T> inline void do_not_optimise(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const T* sink;
+		sink = &value;
+#endif
+	}
+
+} // namespace ForgottenBench
+
+#define FORGOTTEN_BENCH_CONCAT_IMPL(a, b) a##b
+#define FORGOTTEN_BENCH_CONCAT(a, b) FORGOTTEN_BENCH_CONCAT_IMPL(a, b)
+#define FORGOTTEN_BENCHMARK(name, function)                                                                                                        \
+	static ForgottenBench::BenchmarkRegistrar FORGOTTEN_BENCH_CONCAT(benchmark_registrar_, __LINE__) { name, function }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Benchmark.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ForgottenBench {
+
+	struct BenchmarkComparison {
+		std::string name;
+		double baseline_nanoseconds = 0.0;
+		double current_nanoseconds = 0.0;
+
+		/// Relative change in ns/op; positive is slower.
+		[[nodiscard]] double change() const
+		{
+			return baseline_nanoseconds > 0.0 ? (current_nanoseconds - baseline_nanoseconds) / baseline_nanoseconds : 0.0;
+		}
+	};
+
+	class BenchmarkReport {
+	public:
+		/// Writes `{ "benchmarks": [ { "name", "operations", "seconds", "ns_per_op", "ops_per_second" }, ... ] }`.
+		static bool write_json(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results);
+
+		/// Reads a file written by write_json. Only name, operations and seconds are used.
+		static std::optional<std::vector<BenchmarkResult>> read_json(const std::filesystem::path& path);
+
+		/// Pairs up results by name. Benchmarks missing from either side are skipped.
+		static std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current);
+	};
+
+} // namespace ForgottenBench
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ForgottenBench {
+
+	/// A check body returns an empty string when it passes, and what went wrong otherwise.
+	using CheckFunction = std::function<std::string(void)>;
+
+	/// Correctness checks for code the benchmarks time, so a faster path cannot also be a wrong one. They run with
+	/// --check instead of the benchmarks, which is how CTest runs them.
+	class Checks {
+	public:
+		static void add(std::string name, CheckFunction&& function);
+
+		/// Runs every check whose name contains `filter`, printing each result, and returns how many failed.
+		static uint32_t run(std::string_view filter);
+
+	private:
+		struct Entry {
+			std::string name;
+			CheckFunction function;
+		};
+
+		static std::vector<Entry>& entries();
+	};
+
+} // namespace ForgottenBench
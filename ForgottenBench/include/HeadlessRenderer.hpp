@@ -0,0 +1,9 @@
+#pragma once
+
+namespace ForgottenBench {
+
+	/// Starts the engine on the Null backend, once per process: no window, no Application and no render thread, so
+	/// submitted commands run on the calling thread in Renderer::wait_and_render. Does not need the resources directory.
+	void init_headless_renderer();
+
+} // namespace ForgottenBench
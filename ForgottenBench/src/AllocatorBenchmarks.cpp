@@ -0,0 +1,114 @@
+#include "Benchmark.hpp"
+#include "Memory.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t allocations_per_thread = 200000;
+	constexpr size_t live_window = 64;
+
+	/// The tracker Allocator used before sharding: one mutex and one std::map for the whole process.
+	/// Kept here so the contended numbers can be compared side by side.
+	class MutexMapTracker {
+	public:
+		void* allocate(size_t size, const char* category)
+		{
+			void* memory = std::malloc(size);
+			std::scoped_lock<std::mutex> lock(mutex);
+			Allocation& alloc = allocations[memory];
+			alloc.Memory = memory;
+			alloc.Size = size;
+			alloc.Category = category;
+			stats.TotalAllocated += size;
+			category_stats[category].TotalAllocated += size;
+			return memory;
+		}
+
+		void free(void* memory)
+		{
+			{
+				std::scoped_lock<std::mutex> lock(mutex);
+				if (auto it = allocations.find(memory); it != allocations.end()) {
+					stats.TotalFreed += it->second.Size;
+					category_stats[it->second.Category].TotalFreed += it->second.Size;
+					allocations.erase(it);
+				}
+			}
+			std::free(memory);
+		}
+
+	private:
+		std::map<const void*, Allocation, std::less<const void*>, Mallocator<std::pair<const void* const, Allocation>>> allocations;
+		std::map<const char*, AllocationStats, std::less<const char*>, Mallocator<std::pair<const char* const, AllocationStats>>> category_stats;
+		AllocationStats stats;
+		std::mutex mutex;
+	};
+
+	/// Every thread keeps a small window of live blocks so frees do not always hit the slot that was just written.
+	template <typename AllocateFn, typename FreeFn> uint64_t run_contended(uint32_t thread_count, AllocateFn&& allocate, FreeFn&& free)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(thread_count);
+
+		for (uint32_t t = 0; t < thread_count; t++) {
+			threads.emplace_back([&allocate, &free, t]() {
+				void* window[live_window] = {};
+				for (uint64_t i = 0; i < allocations_per_thread; i++) {
+					const size_t slot = i % live_window;
+					if (window[slot])
+						free(window[slot]);
+					window[slot] = allocate(16 + ((i * 7 + t) % 256));
+				}
+				for (void* memory : window)
+					free(memory);
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		return thread_count * allocations_per_thread;
+	}
+
+	void register_allocator_benchmarks()
+	{
+		const uint32_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<uint32_t> thread_counts { 1, 4 };
+		if (hardware_threads > 4)
+			thread_counts.push_back(hardware_threads);
+
+		for (uint32_t threads : thread_counts) {
+			const std::string suffix = "/threads:" + std::to_string(threads);
+
+			Benchmarks::add("Allocator/mutex_map" + suffix, [threads]() {
+				MutexMapTracker tracker;
+				return run_contended(
+					threads, [&](size_t size) { return tracker.allocate(size, __FILE__); }, [&](void* memory) { tracker.free(memory); });
+			});
+
+			Benchmarks::add("Allocator/sharded" + suffix, [threads]() {
+				return run_contended(
+					threads, [](size_t size) { return Allocator::allocate(size, __FILE__); }, [](void* memory) { Allocator::free(memory); });
+			});
+		}
+
+		Benchmarks::add("Allocator/get_allocation_stats", []() -> uint64_t {
+			constexpr uint64_t reads = 1000;
+			for (uint64_t i = 0; i < reads; i++)
+				do_not_optimise(Memory::get_allocation_stats().TotalAllocated);
+			return reads;
+		});
+	}
+
+	const bool allocator_benchmarks_registered = (register_allocator_benchmarks(), true);
+
+} // namespace
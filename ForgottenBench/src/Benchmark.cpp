@@ -0,0 +1,42 @@
+#include "Benchmark.hpp"
+
+#include <chrono>
+#include <limits>
+
+namespace ForgottenBench {
+
+	std::vector<Benchmarks::Entry>& Benchmarks::entries()
+	{
+		static std::vector<Entry> registered;
+		return registered;
+	}
+
+	void Benchmarks::add(std::string name, BenchmarkFunction&& function) { entries().push_back({ std::move(name), std::move(function) }); }
+
+	std::vector<BenchmarkResult> Benchmarks::run(std::string_view filter, uint32_t repetitions)
+	{
+		std::vector<BenchmarkResult> results;
+
+		for (auto& entry : entries()) {
+			if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+				continue;
+
+			BenchmarkResult best { entry.name, 0, std::numeric_limits<double>::max() };
+			for (uint32_t i = 0; i < repetitions; i++) {
+				const auto start = std::chrono::steady_clock::now();
+				const uint64_t operations = entry.function();
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+				if (elapsed.count() < best.seconds) {
+					best.seconds = elapsed.count();
+					best.operations = operations;
+				}
+			}
+
+			results.push_back(best);
+		}
+
+		return results;
+	}
+
+} // namespace ForgottenBench
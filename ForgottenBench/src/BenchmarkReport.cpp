@@ -0,0 +1,74 @@
+#include "BenchmarkReport.hpp"
+
+#include "yaml-cpp/yaml.h"
+
+#include <fstream>
+#include <unordered_map>
+
+namespace ForgottenBench {
+
+	bool BenchmarkReport::write_json(const std::filesystem::path& path, const std::vector<BenchmarkResult>& results)
+	{
+		std::ofstream output(path, std::ios::trunc);
+		if (!output)
+			return false;
+
+		// Benchmark names are plain ASCII without quotes or backslashes, so nothing needs escaping.
+		output.precision(17);
+		output << "{\n\t\"benchmarks\": [";
+		for (size_t i = 0; i < results.size(); i++) {
+			const auto& result = results[i];
+			output << (i ? ",\n" : "\n") << "\t\t{ \"name\": \"" << result.name << "\", \"operations\": " << result.operations
+				   << ", \"seconds\": " << result.seconds << ", \"ns_per_op\": " << result.nanoseconds_per_operation()
+				   << ", \"ops_per_second\": " << result.operations_per_second() << " }";
+		}
+		output << "\n\t]\n}\n";
+
+		return output.good();
+	}
+
+	std::optional<std::vector<BenchmarkResult>> BenchmarkReport::read_json(const std::filesystem::path& path)
+	{
+		// JSON is a subset of YAML, so the parser the engine already ships is enough.
+		YAML::Node root;
+		try {
+			root = YAML::LoadFile(path.string());
+		} catch (const YAML::Exception&) {
+			return std::nullopt;
+		}
+
+		const auto benchmarks = root["benchmarks"];
+		if (!benchmarks || !benchmarks.IsSequence())
+			return std::nullopt;
+
+		std::vector<BenchmarkResult> results;
+		results.reserve(benchmarks.size());
+		for (const auto& node : benchmarks) {
+			if (!node["name"] || !node["operations"] || !node["seconds"])
+				return std::nullopt;
+
+			results.push_back({ node["name"].as<std::string>(), node["operations"].as<uint64_t>(), node["seconds"].as<double>() });
+		}
+
+		return results;
+	}
+
+	std::vector<BenchmarkComparison> BenchmarkReport::compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current)
+	{
+		std::unordered_map<std::string, const BenchmarkResult*> baseline_by_name;
+		for (const auto& result : baseline)
+			baseline_by_name[result.name] = &result;
+
+		std::vector<BenchmarkComparison> comparisons;
+		for (const auto& result : current) {
+			auto it = baseline_by_name.find(result.name);
+			if (it == baseline_by_name.end())
+				continue;
+
+			comparisons.push_back({ result.name, it->second->nanoseconds_per_operation(), result.nanoseconds_per_operation() });
+		}
+
+		return comparisons;
+	}
+
+} // namespace ForgottenBench
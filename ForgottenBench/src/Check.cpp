@@ -0,0 +1,35 @@
+#include "Check.hpp"
+
+#include <cstdio>
+
+namespace ForgottenBench {
+
+	std::vector<Checks::Entry>& Checks::entries()
+	{
+		static std::vector<Entry> registered;
+		return registered;
+	}
+
+	void Checks::add(std::string name, CheckFunction&& function) { entries().push_back({ std::move(name), std::move(function) }); }
+
+	uint32_t Checks::run(std::string_view filter)
+	{
+		uint32_t failures = 0;
+
+		for (auto& entry : entries()) {
+			if (!filter.empty() && entry.name.find(filter) == std::string::npos)
+				continue;
+
+			const std::string failure = entry.function();
+			if (failure.empty()) {
+				std::printf("%-56s PASS\n", entry.name.c_str());
+			} else {
+				std::printf("%-56s FAIL: %s\n", entry.name.c_str(), failure.c_str());
+				failures++;
+			}
+		}
+
+		return failures;
+	}
+
+} // namespace ForgottenBench
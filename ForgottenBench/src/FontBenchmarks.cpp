@@ -0,0 +1,126 @@
+#include "Assets.hpp"
+#include "Benchmark.hpp"
+#include "HeadlessRenderer.hpp"
+#include "render/Font.hpp"
+#include "render/FontAtlasCache.hpp"
+#include "render/Renderer.hpp"
+#include "render/TextLayout.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t loads_per_run = 8;
+	constexpr uint64_t strings_per_run = 1000;
+	constexpr uint64_t fonts_per_run = 4;
+
+	/// HUD-sized text mixing ASCII, Latin-1 and Cyrillic, so every sequence length the charset uses is decoded.
+	constexpr std::string_view hud_text = "FPS: 144 | Frame 6.94 ms | Température 21°C | Счёт 1200";
+
+	/// Written once under its own name and key so the benchmark does not depend on a real font having been cached.
+	constexpr const char* synthetic_font_name = "ForgottenBench-Synthetic";
+	constexpr uint64_t synthetic_key = 0x5eed;
+
+	void ensure_synthetic_atlas()
+	{
+		static const bool written = []() {
+			FontAtlasHeader header;
+			header.Key = synthetic_key;
+			header.Width = 512;
+			header.Height = 512;
+			std::vector<uint8_t> pixels(header.Width * header.Height * 4, 128);
+			FontAtlasCache::write(synthetic_font_name, header, {}, pixels.data());
+			return true;
+		}();
+		do_not_optimise(written);
+	}
+
+	/// A real font from the resources directory. Its atlas is cached by the first load, so both load benchmarks
+	/// time the cache-hit path a game takes on every start after the first.
+	const std::filesystem::path& get_benchmark_font_path()
+	{
+		static const std::filesystem::path path = []() {
+			init_headless_renderer();
+			auto found = Assets::find_resources_by_path(Assets::slashed_string_to_filepath("fonts/OpenSans-Regular.ttf"));
+			core_assert(found, "Font benchmarks need fonts/OpenSans-Regular.ttf under {}", Assets::get_base_directory().string());
+			do_not_optimise(make<Font>(*found));
+			Renderer::wait_and_render();
+			return *found;
+		}();
+		return path;
+	}
+
+	void register_font_benchmarks()
+	{
+		Benchmarks::add("Font/load/sync", []() {
+			const auto& path = get_benchmark_font_path();
+			for (uint64_t i = 0; i < fonts_per_run; i++) {
+				Reference<Font> font = make<Font>(path);
+				do_not_optimise(font->get_font_atlas());
+			}
+			Renderer::wait_and_render();
+			return fonts_per_run;
+		});
+
+		// The same fonts started together on the thread pool; the main thread only creates the textures.
+		Benchmarks::add("Font/load/async_wait", []() {
+			const auto& path = get_benchmark_font_path();
+			std::vector<Reference<Font>> fonts;
+			fonts.reserve(fonts_per_run);
+			for (uint64_t i = 0; i < fonts_per_run; i++)
+				fonts.push_back(Font::load_async(path));
+			for (auto& font : fonts) {
+				font->wait();
+				do_not_optimise(font->get_font_atlas());
+			}
+			fonts.clear();
+			Renderer::wait_and_render();
+			return fonts_per_run;
+		});
+
+		// Mapping plus touching every page, which is what the texture upload does with it.
+		Benchmarks::add("Font/atlas_cache/read_512x512", []() {
+			ensure_synthetic_atlas();
+			for (uint64_t i = 0; i < loads_per_run; i++) {
+				MappedFile file;
+				FontAtlasView view;
+				const bool found = FontAtlasCache::read(synthetic_font_name, synthetic_key, file, view);
+				core_assert(found, "Synthetic font atlas was not written to {}", FontAtlasCache::get_path(synthetic_font_name, synthetic_key).string());
+
+				uint32_t sum = 0;
+				const size_t size = (size_t)view.header->Width * view.header->Height * 4;
+				for (size_t offset = 0; offset < size; offset += 4096)
+					sum += view.pixels[offset];
+				do_not_optimise(sum);
+			}
+			return loads_per_run;
+		});
+
+		Benchmarks::add("Font/atlas_cache/quantise_512x512", []() {
+			static const std::vector<float> pixels(512 * 512 * 4, 0.5f);
+			static std::vector<uint8_t> quantised;
+			FontAtlasCache::quantise(pixels.data(), 512 * 512, 4, quantised);
+			do_not_optimise(quantised.back());
+			return uint64_t { 1 };
+		});
+
+		Benchmarks::add("Font/utf8/decode_hud_string", []() {
+			char32_t sum = 0;
+			for (uint64_t i = 0; i < strings_per_run; i++) {
+				size_t offset = 0;
+				char32_t code_point;
+				while (Utf8::decode_next(hud_text, offset, code_point))
+					sum += code_point;
+			}
+			do_not_optimise(sum);
+			return strings_per_run;
+		});
+	}
+
+	const bool font_benchmarks_registered = (register_font_benchmarks(), true);
+
+} // namespace
@@ -0,0 +1,53 @@
+#include "Benchmark.hpp"
+#include "Hash.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t hashes_per_run = 10000;
+
+	/// Asset paths and shader names are what actually get hashed, so keep to those lengths.
+	std::string make_key(size_t length)
+	{
+		std::string key = "resources/shaders/";
+		while (key.size() < length)
+			key += static_cast<char>('a' + key.size() % 26);
+		key.resize(length);
+		return key;
+	}
+
+	void register_hash_benchmarks()
+	{
+		for (size_t length : { 16, 64, 256 }) {
+			const std::string suffix = "/bytes:" + std::to_string(length);
+
+			Benchmarks::add("Hash/fnv" + suffix, [key = make_key(length)]() {
+				uint32_t hash = 0;
+				for (uint64_t i = 0; i < hashes_per_run; i++) {
+					do_not_optimise(key);
+					hash ^= Hash::generate_fnv_hash(key.c_str());
+				}
+				do_not_optimise(hash);
+				return hashes_per_run;
+			});
+
+			Benchmarks::add("Hash/crc_32" + suffix, [key = make_key(length)]() {
+				uint32_t hash = 0;
+				for (uint64_t i = 0; i < hashes_per_run; i++) {
+					do_not_optimise(key);
+					hash ^= Hash::crc_32(key.c_str());
+				}
+				do_not_optimise(hash);
+				return hashes_per_run;
+			});
+		}
+	}
+
+	const bool hash_benchmarks_registered = (register_hash_benchmarks(), true);
+
+} // namespace
@@ -0,0 +1,30 @@
+#include "HeadlessRenderer.hpp"
+
+#include "Assets.hpp"
+#include "Benchmark.hpp"
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+#include "render/Renderer.hpp"
+#include "render/RendererAPI.hpp"
+
+using namespace ForgottenEngine;
+
+namespace ForgottenBench {
+
+	void init_headless_renderer()
+	{
+		static const bool initialised = []() {
+			if (!Logger::get_core_logger())
+				Logger::init();
+			Assets::init();
+			ThreadPool::init();
+
+			RendererAPI::set_api(RendererAPIType::Null);
+			Renderer::get_config().threading_policy = ThreadingPolicy::SingleThreaded;
+			Renderer::init();
+			return true;
+		}();
+		do_not_optimise(initialised);
+	}
+
+} // namespace ForgottenBench
@@ -0,0 +1,66 @@
+#include "Benchmark.hpp"
+#include "Reference.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t copies_per_thread = 1000000;
+
+	struct Payload : public ReferenceCounted {
+		uint64_t value = 1;
+	};
+
+	/// Mimics a Renderer::submit capture: copy the reference into a lambda, then move it into the queue.
+	uint64_t run_copies(uint32_t thread_count, const Reference<Payload>& shared)
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(thread_count);
+		for (uint32_t t = 0; t < thread_count; t++) {
+			threads.emplace_back([&shared]() {
+				uint64_t local = 0;
+				for (uint64_t i = 0; i < copies_per_thread; i++) {
+					Reference<Payload> copy = shared;
+					Reference<Payload> moved = std::move(copy);
+					local += moved->value;
+				}
+				do_not_optimise(local);
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		return copies_per_thread * thread_count;
+	}
+
+	void register_reference_benchmarks()
+	{
+		const uint32_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+		std::vector<uint32_t> thread_counts { 1, 4 };
+		if (hardware_threads > 4)
+			thread_counts.push_back(hardware_threads);
+
+		for (uint32_t threads : thread_counts) {
+			Benchmarks::add("Reference/copy_move/threads:" + std::to_string(threads), [threads]() {
+				auto shared = Reference<Payload>::create();
+				return run_copies(threads, shared);
+			});
+		}
+
+		Benchmarks::add("Reference/weak_is_valid", []() {
+			auto shared = Reference<Payload>::create();
+			WeakReference<Payload> weak = shared;
+			for (uint64_t i = 0; i < copies_per_thread; i++)
+				do_not_optimise(weak.is_valid());
+			return copies_per_thread;
+		});
+	}
+
+	const bool reference_benchmarks_registered = (register_reference_benchmarks(), true);
+
+} // namespace
@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include "render/RenderCommandQueue.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t commands_per_run = 100000;
+
+	struct DrawPayload {
+		std::array<float, 16> transform;
+		uint32_t index_count;
+	};
+
+	uint64_t sink = 0;
+
+	/// What Renderer::submit did before: a std::function placement-newed into the queue.
+	template <typename FuncT> void submit_type_erased(RenderCommandQueue& queue, FuncT&& func)
+	{
+		using SubmittedFunction = std::function<void(void)>;
+		auto render_command = [](void* ptr) {
+			auto function_pointer = static_cast<SubmittedFunction*>(ptr);
+			(*function_pointer)();
+			function_pointer->~SubmittedFunction();
+		};
+		auto storage_buffer = queue.allocate(render_command, sizeof(SubmittedFunction));
+		new (storage_buffer) SubmittedFunction(std::forward<FuncT>(func));
+	}
+
+	RenderCommandQueue& queue()
+	{
+		// Static so the 10 MB buffer is not part of the measured time.
+		static RenderCommandQueue instance;
+		return instance;
+	}
+
+	void register_render_command_queue_benchmarks()
+	{
+		Benchmarks::add("RenderCommandQueue/std_function/small", []() {
+			for (uint64_t i = 0; i < commands_per_run; i++)
+				submit_type_erased(queue(), [i]() { sink += i; });
+			queue().execute();
+			return commands_per_run;
+		});
+
+		Benchmarks::add("RenderCommandQueue/typed/small", []() {
+			for (uint64_t i = 0; i < commands_per_run; i++)
+				queue().submit([i]() { sink += i; });
+			queue().execute();
+			return commands_per_run;
+		});
+
+		// 68 bytes of capture: too large for std::function's small buffer.
+		Benchmarks::add("RenderCommandQueue/std_function/draw_payload", []() {
+			DrawPayload payload {};
+			for (uint64_t i = 0; i < commands_per_run; i++) {
+				payload.index_count = static_cast<uint32_t>(i);
+				submit_type_erased(queue(), [payload]() { sink += payload.index_count; });
+			}
+			queue().execute();
+			return commands_per_run;
+		});
+
+		Benchmarks::add("RenderCommandQueue/typed/draw_payload", []() {
+			DrawPayload payload {};
+			for (uint64_t i = 0; i < commands_per_run; i++) {
+				payload.index_count = static_cast<uint32_t>(i);
+				queue().submit([payload]() { sink += payload.index_count; });
+			}
+			queue().execute();
+			return commands_per_run;
+		});
+
+		// Non-trivially destructible capture, like the Reference<> captures in VulkanRenderer.
+		Benchmarks::add("RenderCommandQueue/typed/shared_capture", []() {
+			auto shared = std::make_shared<uint64_t>(1);
+			for (uint64_t i = 0; i < commands_per_run; i++)
+				queue().submit([shared]() { sink += *shared; });
+			queue().execute();
+			return commands_per_run;
+		});
+	}
+
+	const bool render_command_queue_benchmarks_registered = (register_render_command_queue_benchmarks(), true);
+
+} // namespace
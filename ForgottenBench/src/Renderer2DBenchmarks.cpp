@@ -0,0 +1,233 @@
+#include "Benchmark.hpp"
+#include "HeadlessRenderer.hpp"
+#include "render/Renderer.hpp"
+#include "render/Renderer2D.hpp"
+#include "render/Renderer2DContext.hpp"
+#include "render/SpriteAtlas.hpp"
+#include "render/SpriteTransform.hpp"
+#include "render/Texture.hpp"
+
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	/// One full Renderer2D batch.
+	constexpr uint64_t quads_per_run = 10000;
+
+	std::vector<Renderer2D::QuadVertex>& vertices()
+	{
+		static std::vector<Renderer2D::QuadVertex> storage(quads_per_run * 4);
+		return storage;
+	}
+
+	/// The quads draw_quad/rotated builds one at a time.
+	const std::vector<SpriteInstance>& sprites()
+	{
+		static const std::vector<SpriteInstance> storage = []() {
+			std::vector<SpriteInstance> result(quads_per_run);
+			for (uint64_t i = 0; i < quads_per_run; i++) {
+				result[i].Position = { static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f };
+				result[i].Rotation = static_cast<float>(i) * 0.01f;
+				result[i].Size = { 0.9f, 0.9f };
+				result[i].Color = { 1.0f, 0.5f, 0.25f, 1.0f };
+			}
+			return result;
+		}();
+		return storage;
+	}
+
+	std::vector<Renderer2D::QuadInstance>& instances()
+	{
+		static std::vector<Renderer2D::QuadInstance> storage(quads_per_run);
+		return storage;
+	}
+
+	/// A Renderer2D on the headless Null backend. Never destroyed: its resources would be released through a
+	/// renderer that may already be gone at exit.
+	Renderer2D& null_renderer_2d()
+	{
+		init_headless_renderer();
+		static auto* renderer = new Renderer2D();
+		return *renderer;
+	}
+
+	/// One frame with one scene; `draw` issues the scene's draws.
+	template <typename FN> void run_null_frame(FN&& draw)
+	{
+		Renderer2D& renderer = null_renderer_2d();
+		Renderer::begin_frame();
+		renderer.begin_scene(glm::mat4(1.0f), glm::mat4(1.0f));
+		draw(renderer);
+		renderer.end_scene();
+		Renderer::end_frame();
+		Renderer::wait_and_render();
+	}
+
+	void register_renderer_2d_benchmarks()
+	{
+		// The vertex write alone, as draw_quad(transform, color) does it.
+		Benchmarks::add("Renderer2D/draw_quad/transform", []() {
+			const glm::vec4 color { 1.0f, 0.5f, 0.25f, 1.0f };
+			auto* destination = vertices().data();
+			for (uint64_t i = 0; i < quads_per_run; i++) {
+				const glm::mat4 transform = glm::translate(glm::mat4(1.0f), { static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f });
+				destination = Renderer2D::write_quad_vertices(destination, transform, color, 0.0f, 1.0f);
+			}
+			do_not_optimise(vertices().back());
+			return quads_per_run;
+		});
+
+		// draw_quad(position, size, color): translate * scale per quad.
+		Benchmarks::add("Renderer2D/draw_quad/position_size", []() {
+			const glm::vec4 color { 1.0f, 0.5f, 0.25f, 1.0f };
+			auto* destination = vertices().data();
+			for (uint64_t i = 0; i < quads_per_run; i++) {
+				const glm::vec3 position { static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f };
+				const glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { 0.9f, 0.9f, 1.0f });
+				destination = Renderer2D::write_quad_vertices(destination, transform, color, 0.0f, 1.0f);
+			}
+			do_not_optimise(vertices().back());
+			return quads_per_run;
+		});
+
+		// draw_rotated_quad(position, size, rotation, color): translate * rotate * scale per quad.
+		Benchmarks::add("Renderer2D/draw_quad/rotated", []() {
+			const glm::vec4 color { 1.0f, 0.5f, 0.25f, 1.0f };
+			auto* destination = vertices().data();
+			for (uint64_t i = 0; i < quads_per_run; i++) {
+				const glm::vec3 position { static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f };
+				const glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+					* glm::rotate(glm::mat4(1.0f), static_cast<float>(i) * 0.01f, { 0.0f, 0.0f, 1.0f })
+					* glm::scale(glm::mat4(1.0f), { 0.9f, 0.9f, 1.0f });
+				destination = Renderer2D::write_quad_vertices(destination, transform, color, 0.0f, 1.0f);
+			}
+			do_not_optimise(vertices().back());
+			return quads_per_run;
+		});
+
+		// draw_quads(sprites): the same quads through the SIMD kernel this build selected, and through its scalar fallback.
+		Benchmarks::add("Renderer2D/draw_quads/simd", []() {
+			SpriteTransform::write_quad_vertices(vertices().data(), sprites(), 0.0f, 1.0f);
+			do_not_optimise(vertices().back());
+			return quads_per_run;
+		});
+
+		Benchmarks::add("Renderer2D/draw_quads/scalar", []() {
+			SpriteTransform::write_quad_vertices_scalar(vertices().data(), sprites(), 0.0f, 1.0f);
+			do_not_optimise(vertices().back());
+			return quads_per_run;
+		});
+
+		// draw_sprite(position, size, rotation, color): the same quads as above as instance records.
+		Benchmarks::add("Renderer2D/draw_sprite/rotated", []() {
+			const glm::vec4 color { 1.0f, 0.5f, 0.25f, 1.0f };
+			auto* destination = instances().data();
+			for (uint64_t i = 0; i < quads_per_run; i++) {
+				const glm::vec3 position { static_cast<float>(i % 100), static_cast<float>(i / 100), 0.0f };
+				*destination++
+					= Renderer2D::make_quad_instance(position, { 0.9f, 0.9f }, static_cast<float>(i) * 0.01f, color, 0, { 0.0f, 0.0f, 1.0f, 1.0f });
+			}
+			do_not_optimise(instances().back());
+			return quads_per_run;
+		});
+
+		// Renderer2DContext recording: the same sprites split across one context per hardware thread, as sprite
+		// extraction would record them. Contexts are kept between runs, like Renderer2D keeps them between scenes.
+		Benchmarks::add("Renderer2D/context/draw_quads_threaded", []() {
+			static const uint32_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+			static std::vector<std::unique_ptr<Renderer2DContext>> contexts = []() {
+				std::vector<std::unique_ptr<Renderer2DContext>> result;
+				for (uint32_t i = 0; i < thread_count; i++)
+					result.push_back(std::make_unique<Renderer2DContext>(false));
+				return result;
+			}();
+
+			const std::span<const SpriteInstance> all_sprites = sprites();
+			const size_t per_thread = (all_sprites.size() + thread_count - 1) / thread_count;
+
+			std::vector<std::thread> threads;
+			for (uint32_t i = 0; i < thread_count; i++) {
+				threads.emplace_back([&, i]() {
+					const size_t first = std::min(all_sprites.size(), i * per_thread);
+					const size_t count = std::min(all_sprites.size() - first, per_thread);
+
+					auto& context = *contexts[i];
+					context.reset(i);
+					for (const auto& sprite : all_sprites.subspan(first, count))
+						context.draw_rotated_quad(sprite.Position, sprite.Size, sprite.Rotation, sprite.Color);
+				});
+			}
+			for (auto& thread : threads)
+				thread.join();
+
+			do_not_optimise(contexts.back()->get_quad_vertices().size());
+			return quads_per_run;
+		});
+
+		// A whole Renderer2D frame on the Null backend: batching the same quads through draw_rotated_quad, submitting the
+		// draws and executing the command queue. Shows what the CPU side of the renderer costs without a GPU.
+		Benchmarks::add("Renderer2D/frame/null", []() {
+			run_null_frame([](Renderer2D& renderer) {
+				for (const auto& sprite : sprites())
+					renderer.draw_rotated_quad(sprite.Position, sprite.Size, sprite.Rotation, sprite.Color);
+			});
+			return quads_per_run;
+		});
+
+		// The public draw_quad overloads themselves, texture lookup and batch checks included, each in a Null frame.
+		Benchmarks::add("Renderer2D/draw_quad/null/textured", []() {
+			run_null_frame([](Renderer2D& renderer) {
+				const auto& texture = Renderer::get_white_texture();
+				for (const auto& sprite : sprites())
+					renderer.draw_quad(sprite.Position, sprite.Size, texture, 1.0f, sprite.Color);
+			});
+			return quads_per_run;
+		});
+
+		Benchmarks::add("Renderer2D/draw_quad/null/rotated_textured", []() {
+			run_null_frame([](Renderer2D& renderer) {
+				const auto& texture = Renderer::get_white_texture();
+				for (const auto& sprite : sprites())
+					renderer.draw_rotated_quad(sprite.Position, sprite.Size, sprite.Rotation, texture, 1.0f, sprite.Color);
+			});
+			return quads_per_run;
+		});
+
+		Benchmarks::add("Renderer2D/draw_quad/null/billboard", []() {
+			run_null_frame([](Renderer2D& renderer) {
+				for (const auto& sprite : sprites())
+					renderer.draw_quad_billboard(sprite.Position, sprite.Size, sprite.Color);
+			});
+			return quads_per_run;
+		});
+
+		// SpriteAtlas packing on the CPU: fill a page with 32x32 sprites, drop every other one and refill the gaps.
+		// No update(), so nothing is uploaded.
+		Benchmarks::add("Renderer2D/sprite_atlas/add_remove", []() {
+			constexpr uint32_t sprite_count = 900;
+			static const std::vector<uint32_t> pixels(32 * 32, 0xffffffffu);
+
+			SpriteAtlas atlas;
+			std::vector<SpriteAtlas::Handle> handles(sprite_count);
+			for (auto& handle : handles)
+				handle = atlas.add(32, 32, pixels.data());
+			for (uint32_t i = 0; i < sprite_count; i += 2)
+				atlas.remove(handles[i]);
+			for (uint32_t i = 0; i < sprite_count; i += 2)
+				handles[i] = atlas.add(32, 32, pixels.data());
+
+			do_not_optimise(atlas.get_page_count());
+			return sprite_count * 2;
+		});
+	}
+
+	const bool renderer_2d_benchmarks_registered = (register_renderer_2d_benchmarks(), true);
+
+} // namespace
@@ -0,0 +1,85 @@
+#include "Benchmark.hpp"
+#include "serialize/MemoryStream.hpp"
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t records_per_run = 10000;
+
+	/// Roughly what an asset entry in a pack looks like: an id, a transform, a name and some indices.
+	struct Record {
+		uint64_t id;
+		glm::mat4 transform;
+		std::string name;
+		std::vector<uint32_t> indices;
+	};
+
+	const Record& sample_record()
+	{
+		static const Record record { 0xF0F0F0F0ull, glm::mat4(1.0f), "ForgottenBench/SampleRecord", std::vector<uint32_t>(32, 7u) };
+		return record;
+	}
+
+	uint32_t record_size(const Record& record)
+	{
+		return static_cast<uint32_t>(sizeof(record.id) + sizeof(record.transform) + sizeof(size_t) + record.name.size() + sizeof(uint32_t)
+			+ record.indices.size() * sizeof(uint32_t));
+	}
+
+	Buffer& stream_buffer()
+	{
+		static Buffer buffer;
+		if (!buffer.data)
+			buffer.allocate(record_size(sample_record()) * records_per_run);
+		return buffer;
+	}
+
+	void write_records(StreamWriter& writer)
+	{
+		const Record& record = sample_record();
+		for (uint64_t i = 0; i < records_per_run; i++) {
+			writer.write_raw<uint64_t>(record.id + i);
+			writer.write_raw<glm::mat4>(record.transform);
+			writer.write_string(record.name);
+			writer.write_array(record.indices);
+		}
+	}
+
+	void register_serialization_benchmarks()
+	{
+		Benchmarks::add("StreamWriter/memory/records", []() {
+			MemoryStreamWriter writer(stream_buffer(), stream_buffer().size);
+			write_records(writer);
+			do_not_optimise(writer.get_stream_position());
+			return records_per_run;
+		});
+
+		Benchmarks::add("StreamReader/memory/round_trip", []() {
+			{
+				MemoryStreamWriter writer(stream_buffer(), stream_buffer().size);
+				write_records(writer);
+			}
+
+			MemoryStreamReader reader(stream_buffer());
+			Record record;
+			for (uint64_t i = 0; i < records_per_run; i++) {
+				reader.read_raw<uint64_t>(record.id);
+				reader.read_raw<glm::mat4>(record.transform);
+				reader.read_string(record.name);
+				reader.read_array(record.indices);
+				core_assert(record.id == sample_record().id + i, "Stream round trip lost its position at record {}", i);
+			}
+			do_not_optimise(record.id);
+			return records_per_run;
+		});
+	}
+
+	const bool serialization_benchmarks_registered = (register_serialization_benchmarks(), true);
+
+} // namespace
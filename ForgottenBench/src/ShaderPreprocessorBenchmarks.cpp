@@ -0,0 +1,96 @@
+#include "Benchmark.hpp"
+#include "vulkan/compiler/preprocessor/ShaderPreprocessor.hpp"
+
+#include <string>
+#include <unordered_set>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	constexpr uint64_t shaders_per_run = 100;
+
+	/// Same layout as resources/shaders/Renderer2D.glsl, inlined so the benchmark does not depend on the working directory.
+	constexpr const char* renderer_2d_source = R"(// Basic Texture Shader
+
+#version 450 core
+#pragma stage : vert
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+layout(location = 4) in float a_TilingFactor;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+layout(push_constant) uniform Transform
+{
+	mat4 Transform;
+}
+u_Renderer;
+
+/* Passed through to the fragment stage untouched. */
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) out VertexOutput Output;
+layout(location = 5) out flat float TexIndex;
+
+void main()
+{
+	Output.Color = a_Color;
+	Output.TexCoord = a_TexCoord;
+	TexIndex = a_TexIndex;
+	Output.TilingFactor = a_TilingFactor;
+	gl_Position = u_ViewProjection * u_Renderer.Transform * vec4(a_Position, 1.0);
+}
+
+#version 450 core
+#pragma stage : frag
+
+layout(location = 0) out vec4 color;
+
+struct VertexOutput {
+	vec4 Color;
+	vec2 TexCoord;
+	float TilingFactor;
+};
+
+layout(location = 0) in VertexOutput Input;
+layout(location = 5) in flat float TexIndex;
+
+layout (binding = 1) uniform sampler2D u_Textures[16];
+
+#ifdef __HZ_DEBUG_TEXTURES
+#endif
+
+void main()
+{
+	color = texture(u_Textures[int(TexIndex)], Input.TexCoord * Input.TilingFactor) * Input.Color;
+}
+)";
+
+	void register_shader_preprocessor_benchmarks()
+	{
+		Benchmarks::add("ShaderPreprocessor/glsl/renderer_2d", []() {
+			const std::string source = renderer_2d_source;
+			for (uint64_t i = 0; i < shaders_per_run; i++) {
+				std::unordered_set<std::string> special_macros;
+				auto stages = ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(source, special_macros);
+				do_not_optimise(stages.size());
+			}
+			return shaders_per_run;
+		});
+	}
+
+	const bool shader_preprocessor_benchmarks_registered = (register_shader_preprocessor_benchmarks(), true);
+
+} // namespace
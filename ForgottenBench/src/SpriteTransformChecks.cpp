@@ -0,0 +1,117 @@
+#include "Check.hpp"
+#include "render/Renderer2D.hpp"
+#include "render/SpriteTransform.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+#include <vector>
+
+using namespace ForgottenBench;
+using namespace ForgottenEngine;
+
+namespace {
+
+	/// Positions within [-100, 100] and sizes up to 10 put the corners a few float ulps of 110 apart from the
+	/// reference at most; a wrong corner, sign or swapped axis is off by far more.
+	constexpr float position_tolerance = 1e-4f;
+
+	/// Seeded random sprites, 3 more than a multiple of every lane width so the kernels' tails are covered too.
+	const std::vector<SpriteInstance>& random_sprites()
+	{
+		static const std::vector<SpriteInstance> storage = []() {
+			std::mt19937 generator(1234);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> size(0.01f, 10.0f);
+			std::uniform_real_distribution<float> rotation(-3.14159265f, 3.14159265f);
+			std::uniform_real_distribution<float> channel(0.0f, 1.0f);
+
+			std::vector<SpriteInstance> result(10003);
+			for (auto& sprite : result) {
+				sprite.Position = { position(generator), position(generator), position(generator) };
+				sprite.Size = { size(generator), size(generator) };
+				sprite.Rotation = rotation(generator);
+				sprite.Color = { channel(generator), channel(generator), channel(generator), channel(generator) };
+			}
+			return result;
+		}();
+		return storage;
+	}
+
+	/// What draw_rotated_quad writes for each sprite: the unit quad through translate * rotate * scale.
+	std::vector<Renderer2D::QuadVertex> reference_vertices(float texture_index, float tiling_factor)
+	{
+		static constexpr glm::vec4 corners[] = {
+			{ -0.5f, -0.5f, 0.0f, 1.0f },
+			{ -0.5f, 0.5f, 0.0f, 1.0f },
+			{ 0.5f, 0.5f, 0.0f, 1.0f },
+			{ 0.5f, -0.5f, 0.0f, 1.0f },
+		};
+		static constexpr glm::vec2 texture_coords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		std::vector<Renderer2D::QuadVertex> result;
+		result.reserve(random_sprites().size() * 4);
+		for (const auto& sprite : random_sprites()) {
+			const glm::mat4 transform = glm::translate(glm::mat4(1.0f), sprite.Position)
+				* glm::rotate(glm::mat4(1.0f), sprite.Rotation, { 0.0f, 0.0f, 1.0f })
+				* glm::scale(glm::mat4(1.0f), { sprite.Size.x, sprite.Size.y, 1.0f });
+			for (int corner = 0; corner < 4; corner++) {
+				auto& vertex = result.emplace_back();
+				vertex.Position = transform * corners[corner];
+				vertex.Color = sprite.Color;
+				vertex.TextureCoords = texture_coords[corner];
+				vertex.TextureIndex = texture_index;
+				vertex.TilingFactor = tiling_factor;
+			}
+		}
+		return result;
+	}
+
+	/// Empty when every vertex of `kernel` is within the tolerance of the reference. Everything but the position is
+	/// copied, so it has to match exactly.
+	template <typename Kernel> std::string compare_with_reference(const char* kernel_name, Kernel&& kernel)
+	{
+		constexpr float texture_index = 3.0f;
+		constexpr float tiling_factor = 2.0f;
+
+		const auto expected = reference_vertices(texture_index, tiling_factor);
+		std::vector<Renderer2D::QuadVertex> written(expected.size());
+		kernel(written.data(), random_sprites(), texture_index, tiling_factor);
+
+		float max_error = 0.0f;
+		size_t mismatched_attributes = 0;
+		for (size_t i = 0; i < written.size(); i++) {
+			for (int axis = 0; axis < 3; axis++)
+				max_error = std::max(max_error, std::abs(written[i].Position[axis] - expected[i].Position[axis]));
+
+			mismatched_attributes += written[i].Color != expected[i].Color || written[i].TextureCoords != expected[i].TextureCoords
+				|| written[i].TextureIndex != expected[i].TextureIndex || written[i].TilingFactor != expected[i].TilingFactor;
+		}
+
+		if (max_error <= position_tolerance && !mismatched_attributes)
+			return {};
+
+		char failure[256];
+		std::snprintf(failure, sizeof(failure), "%s kernel: positions off by up to %g (tolerance %g), %zu vertices with other attributes wrong",
+			kernel_name, max_error, position_tolerance, mismatched_attributes);
+		return failure;
+	}
+
+	void register_sprite_transform_checks()
+	{
+		// The kernel this build selected and the scalar fallback, each against the matrix path rather than each other:
+		// they share the polynomial sine and cosine, so comparing them alone would miss an error in it.
+		Checks::add("SpriteTransform/write_quad_vertices/matches_rotated_quad", []() {
+			return compare_with_reference(SpriteTransform::kernel_name(), SpriteTransform::write_quad_vertices);
+		});
+
+		Checks::add("SpriteTransform/write_quad_vertices_scalar/matches_rotated_quad", []() {
+			return compare_with_reference("scalar", SpriteTransform::write_quad_vertices_scalar);
+		});
+	}
+
+	const bool sprite_transform_checks_registered = (register_sprite_transform_checks(), true);
+
+} // namespace
@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+#include "BenchmarkReport.hpp"
+#include "Check.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+	std::string_view filter;
+	uint32_t repetitions = 5;
+	std::string_view json_path;
+	std::string_view baseline_path;
+	double threshold_percent = 10.0;
+	bool check = false;
+
+	for (int i = 1; i < argc; i++) {
+		const std::string_view argument = argv[i];
+		if (argument == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (argument == "--repetitions" && i + 1 < argc) {
+			repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (argument == "--json" && i + 1 < argc) {
+			json_path = argv[++i];
+		} else if (argument == "--baseline" && i + 1 < argc) {
+			baseline_path = argv[++i];
+		} else if (argument == "--threshold" && i + 1 < argc) {
+			threshold_percent = std::strtod(argv[++i], nullptr);
+		} else if (argument == "--check") {
+			check = true;
+		} else {
+			std::fprintf(stderr,
+				"Usage: %s [--filter <substring>] [--repetitions <n>] [--json <output.json>] [--baseline <baseline.json>] "
+				"[--threshold <percent>] [--check]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	// Exit code 3 when a check fails, as with regressions below.
+	if (check) {
+		const uint32_t failures = ForgottenBench::Checks::run(filter);
+		if (failures)
+			std::printf("\n%u check(s) failed\n", failures);
+		return failures ? 3 : 0;
+	}
+
+	std::optional<std::vector<ForgottenBench::BenchmarkResult>> baseline;
+	if (!baseline_path.empty()) {
+		baseline = ForgottenBench::BenchmarkReport::read_json(std::string(baseline_path));
+		if (!baseline) {
+			std::fprintf(stderr, "Could not read baseline %.*s\n", static_cast<int>(baseline_path.size()), baseline_path.data());
+			return 1;
+		}
+	}
+
+	const auto results = ForgottenBench::Benchmarks::run(filter, repetitions ? repetitions : 1);
+	for (const auto& result : results) {
+		std::printf("%-56s %14.0f ops/s %10.2f ns/op\n", result.name.c_str(), result.operations_per_second(), result.nanoseconds_per_operation());
+	}
+
+	if (!json_path.empty() && !ForgottenBench::BenchmarkReport::write_json(std::string(json_path), results)) {
+		std::fprintf(stderr, "Could not write results to %.*s\n", static_cast<int>(json_path.size()), json_path.data());
+		return 1;
+	}
+
+	if (!baseline)
+		return 0;
+
+	// Exit code 2 when anything got slower than the threshold allows, so CI can tell it apart from usage errors.
+	uint32_t regressions = 0;
+	std::printf("\n%-56s %12s %12s %9s\n", "Compared to baseline", "baseline", "current", "change");
+	for (const auto& comparison : ForgottenBench::BenchmarkReport::compare(*baseline, results)) {
+		const double change_percent = comparison.change() * 100.0;
+		const bool regressed = change_percent > threshold_percent;
+		regressions += regressed;
+		std::printf("%-56s %9.2f ns %9.2f ns %+8.1f%%%s\n", comparison.name.c_str(), comparison.baseline_nanoseconds,
+			comparison.current_nanoseconds, change_percent, regressed ? "  REGRESSION" : "");
+	}
+
+	if (regressions) {
+		std::printf("\n%u benchmark(s) regressed by more than %.1f%%\n", regressions, threshold_percent);
+		return 2;
+	}
+
+	return 0;
+}
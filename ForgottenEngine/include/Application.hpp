@@ -6,6 +6,7 @@
 #include "events/MouseEvent.hpp"
 #include "imgui/ImGuiLayer.hpp"
 #include "LayerStack.hpp"
+#include "render/RenderThread.hpp"
 #include "TimeStep.hpp"
 #include "Window.hpp"
 
@@ -45,10 +46,14 @@ namespace ForgottenEngine {
 		}
 
 		static inline Application& the() { return *instance; }
+		/// False in headless hosts that drive the renderer themselves, such as benchmarks on the Null backend.
+		static inline bool exists() { return instance != nullptr; }
 		static std::string_view platform_name();
 		Window& get_window();
 		inline Layer* get_imgui_layer() { return stack.get_imgui_layer(); }
 		[[nodiscard]] inline float get_frametime() const { return frame_time; };
+		inline RenderThread& get_render_thread() { return render_thread; }
+		[[nodiscard]] inline RenderThreadTimings get_render_thread_timings() const { return render_thread.get_timings(); }
 
 		inline bool exit()
 		{
@@ -69,6 +74,8 @@ namespace ForgottenEngine {
 	private:
 		static Application* instance;
 
+		RenderThread render_thread;
+
 		bool is_minimized { false };
 
 		std::mutex event_queue_mutex;
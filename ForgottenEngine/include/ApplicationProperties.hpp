@@ -5,9 +5,26 @@
 
 namespace ForgottenEngine {
 
+	enum class ThreadingPolicy {
+		// Commands execute inline in Renderer::wait_and_render on the main thread.
+		SingleThreaded,
+		// Commands execute on a dedicated render thread. Layers, ImGui included, still update on the main thread.
+		MultiThreaded
+	};
+
+	enum class RenderThreadSyncPolicy {
+		// The main thread records frame N+1 while the render thread executes frame N.
+		Pipelined,
+		// The main thread waits for every frame it hands over. No overlap; useful to rule out threading issues.
+		Strict
+	};
+
 	struct RendererConfig {
 		uint32_t frames_in_flight = 3;
 
+		ThreadingPolicy threading_policy = ThreadingPolicy::SingleThreaded;
+		RenderThreadSyncPolicy sync_policy = RenderThreadSyncPolicy::Pipelined;
+
 		bool compute_environment_maps = true;
 
 		// Tiering settings
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ApplicationProperties.hpp"
+#include "HeapProfiler.hpp"
 
 extern ForgottenEngine::Application* ForgottenEngine::create_application(const ApplicationProperties& props);
 
@@ -10,6 +11,7 @@ extern ForgottenEngine::Application* ForgottenEngine::create_application(const A
 #include <boost/program_options.hpp>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <system_error>
 
 namespace ForgottenEngine {
@@ -44,7 +46,8 @@ int main(int argc, char** argv)
 	desc.add_options()("help", "Show help message")("width", boost::program_options::value<uint32_t>()->default_value(1280), "Width of window")(
 		"height", boost::program_options::value<uint32_t>()->default_value(720), "Height of window")("name",
 		boost::program_options::value<std::string>()->default_value(std::string { "ForgottenEngine" }),
-		"Title of window")("vsync", boost::program_options::value<bool>()->default_value(true), "Window vsync");
+		"Title of window")("vsync", boost::program_options::value<bool>()->default_value(true), "Window vsync")("heap-profile",
+		boost::program_options::value<std::string>(), "Sample heap allocations and write a pprof profile to this path on exit");
 
 	ForgottenEngine::ArgumentMap vm;
 	try {
@@ -95,6 +98,13 @@ int main(int argc, char** argv)
 
 	CORE_TRACE("{}, {}, {}, {}", props.width, props.height, props.title, props.v_sync);
 
+	// Samples are only taken in the Track and Sample memory modes; with None the profile comes out empty.
+	std::optional<std::filesystem::path> heap_profile_path;
+	if (vm.count("heap-profile")) {
+		heap_profile_path = vm["heap-profile"].as<std::string>();
+		ForgottenEngine::HeapProfiler::start();
+	}
+
 	try {
 		app = ForgottenEngine::create_application(props);
 	} catch (const std::system_error& e) {
@@ -107,6 +117,16 @@ int main(int argc, char** argv)
 		CORE_INFO("{}", e.what());
 	}
 
+	if (heap_profile_path) {
+		ForgottenEngine::HeapProfiler::stop();
+		ForgottenEngine::HeapProfiler::write_pprof(*heap_profile_path);
+
+		auto collapsed_path = *heap_profile_path;
+		collapsed_path += ".collapsed";
+		ForgottenEngine::HeapProfiler::write_collapsed_stacks(collapsed_path, ForgottenEngine::HeapProfileValue::TotalBytes);
+		CORE_INFO("Wrote heap profile to {}", heap_profile_path->string());
+	}
+
 	Logger::shutdown();
 
 	delete app;
@@ -62,6 +62,7 @@ namespace ForgottenEngine {
 	class Texture2D;
 	class UniformBuffer;
 	class UniformBufferSet;
+	class UniformBufferRing;
 	class VertexBuffer;
 	class Components;
 	class Entity;
@@ -113,6 +114,7 @@ namespace ForgottenEngine {
 	class VulkanUBO;
 	class VulkanUniformBuffer;
 	class VulkanUniformBufferSet;
+	class VulkanUniformBufferRing;
 	class VulkanUploadContext;
 	class VulkanVertexBuffer;
 	class Window;
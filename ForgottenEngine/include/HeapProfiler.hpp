@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace ForgottenEngine {
+
+	struct HeapProfilerSpecification {
+		// Mean number of allocated bytes between two samples. Intervals are drawn from an exponential distribution,
+		// so every byte has the same chance of being sampled regardless of allocation size.
+		size_t sample_interval = 512 * 1024;
+		uint32_t max_stack_depth = 32;
+	};
+
+	struct HeapProfilerStats {
+		uint64_t live_samples = 0;
+		uint64_t total_samples = 0;
+		uint64_t unique_stacks = 0;
+		uint64_t dropped_samples = 0;
+		// Unbiased estimates of the bytes the samples stand for.
+		uint64_t estimated_live_bytes = 0;
+		uint64_t estimated_total_bytes = 0;
+	};
+
+	enum class HeapProfileValue { LiveBytes, TotalBytes };
+
+	/// Sampling heap profiler fed by the global operator new/delete in Memory.cpp. Works with both
+	/// FORGOTTEN_TRACK_MEMORY and the cheaper FORGOTTEN_SAMPLE_MEMORY mode, which skips the full allocation table.
+	class HeapProfiler {
+	public:
+		static void start(const HeapProfilerSpecification& specification = HeapProfilerSpecification());
+		static void stop();
+		[[nodiscard]] static bool is_running();
+
+		/// Clears every recorded stack and sample, keeps sampling if running.
+		static void reset();
+
+		[[nodiscard]] static HeapProfilerStats get_stats();
+
+		/// Writes one "frame;frame;frame bytes" line per stack (root first), suitable for flamegraph.pl / speedscope.
+		static bool write_collapsed_stacks(const std::filesystem::path& path, HeapProfileValue value = HeapProfileValue::LiveBytes);
+
+		/// Writes the gperftools text heap profile (heap_v2) that `pprof` reads, including the mapped libraries on Linux.
+		static bool write_pprof(const std::filesystem::path& path);
+
+	public:
+		// Called from the allocation hooks only.
+		static void on_allocation(void* memory, size_t size);
+		static void on_free(void* memory);
+	};
+
+} // namespace ForgottenEngine
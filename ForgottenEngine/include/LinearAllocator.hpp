@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace ForgottenEngine {
+
+	/// Bump allocator. Allocations are never freed individually; reset() drops everything at once.
+	/// When a frame outgrows the current block, further blocks are chained and the next reset()
+	/// replaces the chain with one block large enough for the high-water mark.
+	/// Not thread safe.
+	class LinearAllocator {
+	public:
+		explicit LinearAllocator(size_t initial_capacity = 64 * 1024);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		template <typename T> T* allocate_array(size_t count) { return static_cast<T*>(allocate(sizeof(T) * count, alignof(T))); }
+
+		template <typename T, typename... Args> T* construct(Args&&... args)
+		{
+			return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		void reset();
+
+		[[nodiscard]] size_t get_used() const { return used; }
+		[[nodiscard]] size_t get_capacity() const { return capacity; }
+		[[nodiscard]] size_t get_peak() const { return peak; }
+
+	private:
+		struct Block {
+			Block* next;
+			size_t size;
+			size_t offset;
+		};
+		static constexpr size_t block_header_size = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+		Block* allocate_block(size_t size);
+		void release_blocks();
+
+		Block* first = nullptr;
+		Block* current = nullptr;
+		size_t used = 0;
+		size_t capacity = 0;
+		size_t peak = 0;
+	};
+
+} // namespace ForgottenEngine
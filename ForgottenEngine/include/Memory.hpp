@@ -4,14 +4,19 @@
 
 #pragma once
 
+#include <cstdlib>
+#include <limits>
 #include <map>
 #include <mutex>
+#include <new>
 
 namespace ForgottenEngine {
 
 	struct AllocationStats {
 		size_t TotalAllocated = 0;
 		size_t TotalFreed = 0;
+		size_t AllocationCount = 0;
+		size_t FreeCount = 0;
 	};
 
 	struct Allocation {
@@ -21,8 +26,11 @@ namespace ForgottenEngine {
 	};
 
 	namespace Memory {
-		const AllocationStats& get_allocation_stats();
-	}
+		/// Merges the per-thread counters into a snapshot owned by the caller, so any thread may ask. Cheap enough for a
+		/// debug overlay, not for a hot loop. Does not allocate, so it can bracket a frame to count the allocations made
+		/// inside it.
+		AllocationStats get_allocation_stats();
+	} // namespace Memory
 
 	template <class T> struct Mallocator {
 		typedef T value_type;
@@ -47,17 +55,19 @@ namespace ForgottenEngine {
 	};
 
 	struct AllocatorData {
-		using MapAlloc = Mallocator<std::pair<const void* const, Allocation>>;
 		using StatsMapAlloc = Mallocator<std::pair<const char* const, AllocationStats>>;
 
 		using AllocationStatsMap = std::map<const char*, AllocationStats, std::less<const char*>, StatsMapAlloc>;
 
-		std::map<const void*, Allocation, std::less<const void*>, MapAlloc> m_AllocationMap;
+		// Only written when the stats are read; the allocation path never touches it.
 		AllocationStatsMap allocation_stats_map;
 
-		std::mutex mutex, stats_mutex;
+		std::mutex stats_mutex;
 	};
 
+	/// Live allocations are kept in address-hashed shards (open addressing, one spin lock per shard),
+	/// and byte counters are kept per thread. Neither is shared between threads on the allocation path,
+	/// so tracking can stay on in profiling builds.
 	class Allocator {
 	public:
 		static void init();
@@ -69,15 +79,21 @@ namespace ForgottenEngine {
 		static void* allocate(size_t size, const char* file, int line);
 		static void free(void* memory);
 
-		static const AllocatorData::AllocationStatsMap& GetAllocationStats() { return allocator_data->allocation_stats_map; }
+		static const AllocatorData::AllocationStatsMap& GetAllocationStats();
 
 	private:
+		friend AllocationStats Memory::get_allocation_stats();
+
+		static AllocationStats merge_thread_stats(bool include_categories);
+
 		inline static AllocatorData* allocator_data = nullptr;
 	};
 
 } // namespace ForgottenEngine
 
-#if 1
+// The tagged overloads only exist when Memory.cpp replaces the global allocator. The mode defines are private to the
+// engine, so code outside it always gets the plain operators.
+#if defined(FORGOTTEN_TRACK_MEMORY) || defined(FORGOTTEN_SAMPLE_MEMORY)
 
 [[nodiscard]] void* operator new(size_t size);
 
@@ -91,10 +107,12 @@ namespace ForgottenEngine {
 
 [[nodiscard]] void* operator new[](size_t size, const char* file, int line);
 
-void operator delete(void* memory);
+void operator delete(void* memory) noexcept;
+void operator delete(void* memory, size_t size) noexcept;
 void operator delete(void* memory, const char* desc);
 void operator delete(void* memory, const char* file, int line);
-void operator delete[](void* memory);
+void operator delete[](void* memory) noexcept;
+void operator delete[](void* memory, size_t size) noexcept;
 void operator delete[](void* memory, const char* desc);
 void operator delete[](void* memory, const char* file, int line);
 
@@ -3,24 +3,39 @@
 #include <atomic>
 #include <concepts>
 #include <stdint.h>
+#include <utility>
 
 namespace ForgottenEngine {
 
 	namespace RefUtils {
-		void add_to_live_references(void* instance);
-		void remove_from_live_references(void* instance);
-		bool is_live(void* instance);
+		/// Outlives the object it belongs to for as long as a WeakReference points at it.
+		struct WeakBlock {
+			std::atomic<uint32_t> weak_count { 1 }; // One for the object itself.
+			std::atomic<bool> alive { true };
+		};
+
+		void retain_weak_block(WeakBlock* block);
+		void release_weak_block(WeakBlock* block);
 	} // namespace RefUtils
 
+	/// The count lives in the object, so copying, moving and weak-checking a Reference never locks.
+	/// A WeakBlock is only allocated once something takes a WeakReference to the object.
 	class ReferenceCounted {
 	public:
-		void inc_ref_count() const { ++ref_count; }
-		void dec_ref_count() const { --ref_count; }
+		ReferenceCounted() = default;
+		~ReferenceCounted();
 
-		uint32_t get_ref_count() const { return ref_count.load(); }
+		void inc_ref_count() const { ref_count.fetch_add(1, std::memory_order_relaxed); }
+		// Returns the new count; whoever brings it to zero deletes the object.
+		uint32_t dec_ref_count() const { return ref_count.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+		uint32_t get_ref_count() const { return ref_count.load(std::memory_order_relaxed); }
+
+		RefUtils::WeakBlock* acquire_weak_block() const;
 
 	private:
 		mutable std::atomic<uint32_t> ref_count = 0;
+		mutable std::atomic<RefUtils::WeakBlock*> weak_block = nullptr;
 	};
 
 	template <typename T> class Reference {
@@ -68,6 +83,12 @@ namespace ForgottenEngine {
 			inc_ref();
 		}
 
+		Reference(Reference&& other) noexcept
+			: instance(other.instance)
+		{
+			other.instance = nullptr;
+		}
+
 		Reference& operator=(std::nullptr_t)
 		{
 			dec_ref();
@@ -84,6 +105,17 @@ namespace ForgottenEngine {
 			return *this;
 		}
 
+		Reference& operator=(Reference&& other) noexcept
+		{
+			if (this != &other) {
+				dec_ref();
+
+				instance = other.instance;
+				other.instance = nullptr;
+			}
+			return *this;
+		}
+
 		template <typename T2> Reference& operator=(const Reference<T2>& other)
 		{
 			other.inc_ref();
@@ -139,21 +171,15 @@ namespace ForgottenEngine {
 	private:
 		void inc_ref() const
 		{
-			if (instance) {
+			if (instance)
 				instance->inc_ref_count();
-				RefUtils::add_to_live_references((void*)instance);
-			}
 		}
 
 		void dec_ref() const
 		{
-			if (instance) {
-				instance->dec_ref_count();
-				if (instance->get_ref_count() == 0) {
-					delete instance;
-					RefUtils::remove_from_live_references((void*)instance);
-					instance = nullptr;
-				}
+			if (instance && instance->dec_ref_count() == 0) {
+				delete instance;
+				instance = nullptr;
 			}
 		}
 
@@ -167,9 +193,43 @@ namespace ForgottenEngine {
 	public:
 		WeakReference() = default;
 
-		WeakReference(Reference<T> reference) { instance = reference.raw(); }
+		WeakReference(const Reference<T>& reference)
+			: WeakReference(const_cast<T*>(reference.raw()))
+		{
+		}
 
-		WeakReference(T* in_instance) { instance = in_instance; }
+		WeakReference(T* in_instance)
+			: instance(in_instance)
+			, block(in_instance ? in_instance->acquire_weak_block() : nullptr)
+		{
+		}
+
+		WeakReference(const WeakReference& other)
+			: instance(other.instance)
+			, block(other.block)
+		{
+			if (block)
+				RefUtils::retain_weak_block(block);
+		}
+
+		WeakReference(WeakReference&& other) noexcept
+			: instance(std::exchange(other.instance, nullptr))
+			, block(std::exchange(other.block, nullptr))
+		{
+		}
+
+		~WeakReference()
+		{
+			if (block)
+				RefUtils::release_weak_block(block);
+		}
+
+		WeakReference& operator=(WeakReference other) noexcept
+		{
+			std::swap(instance, other.instance);
+			std::swap(block, other.block);
+			return *this;
+		}
 
 		T* operator->() { return instance; }
 		const T* operator->() const { return instance; }
@@ -177,11 +237,14 @@ namespace ForgottenEngine {
 		T& operator*() { return *instance; }
 		const T& operator*() const { return *instance; }
 
-		[[nodiscard]] bool is_valid() const { return instance && RefUtils::is_live(instance); }
+		[[nodiscard]] bool is_valid() const { return block && block->alive.load(std::memory_order_acquire); }
 		operator bool() const { return is_valid(); }
 
+		bool operator==(const WeakReference& other) const { return instance == other.instance; }
+
 	private:
 		T* instance = nullptr;
+		RefUtils::WeakBlock* block = nullptr;
 	};
 
 } // namespace ForgottenEngine
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	/// Worker threads for CPU work that would otherwise hold up the main thread, such as loading assets. Tasks run
+	/// in the order they were submitted, on whichever worker is free; they must not touch the renderer.
+	/// The engine-wide pool lives from init() to shutdown() and has one worker per hardware thread but the main one.
+	class ThreadPool {
+	public:
+		explicit ThreadPool(uint32_t thread_count);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		template <typename FN> auto submit(FN&& function) -> std::future<std::invoke_result_t<FN>>
+		{
+			using Result = std::invoke_result_t<FN>;
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<FN>(function));
+			std::future<Result> future = task->get_future();
+			enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		/// Calls function(i) for every i below count on the workers and returns once all calls have. Which worker gets
+		/// which index is not fixed, so function should only write to state of its own index. Not for use from a worker
+		/// of this pool, which would wait on itself.
+		template <typename FN> void parallel_for(uint32_t count, FN&& function)
+		{
+			std::atomic<uint32_t> next_index = 0;
+			auto run = [&]() {
+				for (uint32_t i = next_index.fetch_add(1); i < count; i = next_index.fetch_add(1))
+					function(i);
+			};
+
+			std::vector<std::future<void>> futures;
+			const uint32_t task_count = std::min(count, get_thread_count());
+			futures.reserve(task_count);
+			for (uint32_t i = 0; i < task_count; i++)
+				futures.push_back(submit(run));
+
+			// Every task finishes before any exception is passed on, they all point at this frame.
+			for (auto& future : futures)
+				future.wait();
+			for (auto& future : futures)
+				future.get();
+		}
+
+		[[nodiscard]] uint32_t get_thread_count() const { return static_cast<uint32_t>(threads.size()); }
+
+		static void init();
+		static void shutdown();
+		static ThreadPool& get();
+
+		/// Threads worth giving a parallel algorithm on this machine, never less than one.
+		static uint32_t get_hardware_thread_count();
+
+	private:
+		void enqueue(std::function<void()> task);
+		void worker_loop();
+
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::function<void()>> tasks;
+		bool stopping = false;
+	};
+
+} // namespace ForgottenEngine
@@ -21,6 +21,8 @@ namespace ForgottenEngine {
 
 		~ImGuiLayer() override = default;
 
+		/// begin() and end() run on the main thread, around the layers' on_ui_render calls. end() hands a copy of the
+		/// frame's draw data to the render thread, which records it into the swapchain's command buffer.
 		static void begin();
 
 		static void end();
@@ -29,6 +31,10 @@ namespace ForgottenEngine {
 		void on_update(const TimeStep& step) override;
 		void on_event(Event& e) override;
 		void on_detach() override;
+
+	private:
+		struct DrawDataSnapshot;
+		static void render_draw_data(ImDrawData* main_draw_data);
 	};
 
 } // namespace ForgottenEngine
\ No newline at end of file
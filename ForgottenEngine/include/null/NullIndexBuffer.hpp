@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include "render/IndexBuffer.hpp"
+
+namespace ForgottenEngine {
+
+	class NullIndexBuffer : public IndexBuffer, public PoolAllocated<NullIndexBuffer> {
+	public:
+		explicit NullIndexBuffer(uint32_t size);
+		NullIndexBuffer(void* data, uint32_t size = 0);
+		~NullIndexBuffer() override;
+
+		void set_data(void* buffer, uint32_t in_size, uint32_t offset = 0) override;
+		void bind() const override { }
+
+		uint32_t get_count() const override { return size / sizeof(uint32_t); }
+
+		uint32_t get_size() const override { return size; }
+		RendererID get_renderer_id() const override { return 0; }
+
+	private:
+		uint32_t size = 0;
+		Buffer local_data;
+	};
+
+} // namespace ForgottenEngine
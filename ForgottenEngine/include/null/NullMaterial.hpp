@@ -0,0 +1,91 @@
+#pragma once
+
+#include "render/Material.hpp"
+
+#include <array>
+#include <unordered_map>
+
+namespace ForgottenEngine {
+
+	/// Uniforms are stored by name instead of through the shader's reflection data, so a material works
+	/// with any shader, including none.
+	class NullMaterial : public Material, public PoolAllocated<NullMaterial> {
+	public:
+		NullMaterial(const Reference<Shader>& shader, std::string name);
+		NullMaterial(const Reference<Material>& material, const std::string& name);
+		~NullMaterial() override = default;
+
+		void invalidate() override { }
+		void on_shader_reloaded() override { }
+
+		void set(const std::string& name, float value) override { set<float>(name, value); }
+		void set(const std::string& name, int value) override { set<int>(name, value); }
+		void set(const std::string& name, uint32_t value) override { set<uint32_t>(name, value); }
+		void set(const std::string& name, bool value) override { set<bool>(name, value); }
+		void set(const std::string& name, const glm::ivec2& value) override { set<glm::ivec2>(name, value); }
+		void set(const std::string& name, const glm::ivec3& value) override { set<glm::ivec3>(name, value); }
+		void set(const std::string& name, const glm::ivec4& value) override { set<glm::ivec4>(name, value); }
+		void set(const std::string& name, const glm::vec2& value) override { set<glm::vec2>(name, value); }
+		void set(const std::string& name, const glm::vec3& value) override { set<glm::vec3>(name, value); }
+		void set(const std::string& name, const glm::vec4& value) override { set<glm::vec4>(name, value); }
+		void set(const std::string& name, const glm::mat3& value) override { set<glm::mat3>(name, value); }
+		void set(const std::string& name, const glm::mat4& value) override { set<glm::mat4>(name, value); }
+
+		void set(const std::string& name, const Reference<Texture2D>& texture) override;
+		void set(const std::string& name, const Reference<Texture2D>& texture, uint32_t array_index) override;
+		void set(const std::string& name, const Reference<TextureCube>& texture) override;
+		void set(const std::string& name, const Reference<Image2D>& image) override;
+
+		float& get_float(const std::string& name) override { return get<float>(name); }
+		int32_t& get_int(const std::string& name) override { return get<int32_t>(name); }
+		uint32_t& get_uint(const std::string& name) override { return get<uint32_t>(name); }
+		bool& get_bool(const std::string& name) override { return get<bool>(name); }
+		glm::vec2& get_vector2(const std::string& name) override { return get<glm::vec2>(name); }
+		glm::vec3& get_vector3(const std::string& name) override { return get<glm::vec3>(name); }
+		glm::vec4& get_vector4(const std::string& name) override { return get<glm::vec4>(name); }
+		glm::mat3& get_matrix3(const std::string& name) override { return get<glm::mat3>(name); }
+		glm::mat4& get_matrix4(const std::string& name) override { return get<glm::mat4>(name); }
+
+		Reference<Texture2D> get_texture_2d(const std::string& name) override;
+		Reference<TextureCube> get_texture_cube(const std::string& name) override;
+
+		Reference<Texture2D> try_get_texture_2d(const std::string& name) override { return get_texture_2d(name); }
+		Reference<TextureCube> try_get_texture_cube(const std::string& name) override { return get_texture_cube(name); }
+
+		uint32_t get_flags() const override { return material_flags; }
+		void set_flags(uint32_t flags) override { material_flags = flags; }
+		bool get_flag(MaterialFlag flag) const override { return (uint32_t)flag & material_flags; }
+		void set_flag(MaterialFlag flag, bool value = true) override
+		{
+			if (value) {
+				material_flags |= (uint32_t)flag;
+			} else {
+				material_flags &= ~(uint32_t)flag;
+			}
+		}
+
+		Reference<Shader> get_shader() override { return material_shader; }
+		const std::string& get_name() const override { return material_name; }
+
+		template <typename T> void set(const std::string& name, const T& value) { get<T>(name) = value; }
+
+		template <typename T> T& get(const std::string& name)
+		{
+			static_assert(sizeof(T) <= sizeof(UniformValue) && alignof(T) <= alignof(UniformValue), "Uniform type is too large");
+			return *reinterpret_cast<T*>(uniforms[name].data());
+		}
+
+	private:
+		using UniformValue = std::array<float, 16>;
+
+		Reference<Shader> material_shader;
+		std::string material_name;
+		uint32_t material_flags = 0;
+
+		std::unordered_map<std::string, UniformValue> uniforms;
+		std::unordered_map<std::string, Reference<Texture2D>> textures;
+		std::unordered_map<std::string, Reference<TextureCube>> cube_textures;
+		std::unordered_map<std::string, Reference<Image2D>> images;
+	};
+
+} // namespace ForgottenEngine
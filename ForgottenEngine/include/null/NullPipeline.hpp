@@ -0,0 +1,24 @@
+#pragma once
+
+#include "render/Pipeline.hpp"
+
+namespace ForgottenEngine {
+
+	class NullPipeline : public Pipeline, public PoolAllocated<NullPipeline> {
+	public:
+		explicit NullPipeline(const PipelineSpecification& spec);
+		~NullPipeline() override = default;
+
+		void bind() override;
+		void invalidate() override;
+
+		PipelineSpecification& get_specification() override { return spec; }
+		const PipelineSpecification& get_specification() const override { return spec; }
+
+		void set_uniform_buffer(const Reference<UniformBuffer>& ub, uint32_t binding, uint32_t set) override { }
+
+	private:
+		PipelineSpecification spec;
+	};
+
+} // namespace ForgottenEngine
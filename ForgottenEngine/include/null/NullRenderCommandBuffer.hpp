@@ -0,0 +1,17 @@
+#pragma once
+
+#include "render/RenderCommandBuffer.hpp"
+
+namespace ForgottenEngine {
+
+	class NullRenderCommandBuffer : public RenderCommandBuffer {
+	public:
+		NullRenderCommandBuffer();
+		~NullRenderCommandBuffer() override = default;
+
+		void begin() override;
+		void end() override;
+		void submit() override;
+	};
+
+} // namespace ForgottenEngine
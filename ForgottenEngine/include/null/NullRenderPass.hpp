@@ -0,0 +1,19 @@
+#pragma once
+
+#include "render/RenderPass.hpp"
+
+namespace ForgottenEngine {
+
+	class NullRenderPass : public RenderPass {
+	public:
+		explicit NullRenderPass(const RenderPassSpecification& spec);
+		~NullRenderPass() override = default;
+
+		RenderPassSpecification& get_specification() override { return spec; }
+		const RenderPassSpecification& get_specification() const override { return spec; }
+
+	private:
+		RenderPassSpecification spec;
+	};
+
+} // namespace ForgottenEngine
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "render/RendererAPI.hpp"
+
+#include <atomic>
+
+namespace ForgottenEngine {
+
+	enum class NullCounter : uint32_t {
+		Frames,
+		RenderPasses,
+		DrawCalls,
+		Indices,
+		BufferUploads,
+		BufferUploadBytes,
+		TextureUploads,
+		TextureUploadBytes,
+		MaterialWrites,
+		PipelineBinds,
+		CommandBufferSubmits,
+		ResourcesCreated,
+		Count
+	};
+
+	struct NullRendererStats {
+		uint64_t frames = 0;
+		uint64_t render_passes = 0;
+		uint64_t draw_calls = 0;
+		uint64_t indices = 0;
+		uint64_t buffer_uploads = 0;
+		uint64_t buffer_upload_bytes = 0;
+		uint64_t texture_uploads = 0;
+		uint64_t texture_upload_bytes = 0;
+		uint64_t material_writes = 0;
+		uint64_t pipeline_binds = 0;
+		uint64_t command_buffer_submits = 0;
+		uint64_t resources_created = 0;
+	};
+
+	/// Backend without a device. Calls go through Renderer::submit like they do for Vulkan, so command
+	/// queue traffic is the same, but executing them only bumps counters. Lets the CPU side of the
+	/// renderer be profiled on machines without a GPU.
+	class NullRenderer : public RendererAPI {
+	public:
+		~NullRenderer() override = default;
+
+		void init() override;
+		void shut_down() override;
+
+		const RendererCapabilities& get_capabilities() const override { return capabilities; }
+
+		void begin_frame() override;
+		void begin_render_pass(Reference<RenderCommandBuffer> command_buffer, Reference<RenderPass> render_pass, bool explicit_clear) override;
+		void end_render_pass(Reference<RenderCommandBuffer> command_buffer) override;
+		void end_frame() override;
+
+		void render_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline, Reference<UniformBufferSet> ubs,
+			Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb, Reference<IndexBuffer> ib,
+			const glm::mat4& transform, uint32_t index_count) override;
+
+		void render_instanced_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline, Reference<UniformBufferSet> ubs,
+			Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb, Reference<IndexBuffer> ib,
+			Reference<VertexBuffer> instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count) override;
+
+		void submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline_in,
+			const Reference<UniformBufferSet>& ub, const Reference<StorageBufferSet>& sb, const Reference<Material>& material) override;
+
+		void submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline,
+			const Reference<UniformBufferSet>& uniform_buffer_set, const Reference<Material>& material) override;
+
+	public:
+		static void count(NullCounter counter, uint64_t amount = 1)
+		{
+			counters[static_cast<uint32_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		static NullRendererStats get_stats();
+		static void reset_stats();
+
+		/// Frame-in-flight slot being executed, in place of the swapchain's. Advances when a frame ends.
+		static uint32_t get_current_frame_index() { return frame_index; }
+
+	private:
+		RendererCapabilities capabilities { "Null", "Null", "0" };
+
+		inline static std::atomic<uint64_t> counters[static_cast<uint32_t>(NullCounter::Count)] {};
+		inline static uint32_t frame_index = 0; // Render thread only.
+	};
+
+} // namespace ForgottenEngine
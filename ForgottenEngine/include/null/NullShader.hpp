@@ -0,0 +1,37 @@
+#pragma once
+
+#include "render/Shader.hpp"
+
+#include <filesystem>
+
+namespace ForgottenEngine {
+
+	/// A shader with a name and nothing else: no stages, no reflection data. Pipelines and materials can refer to it
+	/// and the library can look it up, which is all the Null backend needs.
+	class NullShader : public Shader {
+	public:
+		explicit NullShader(const std::filesystem::path& path);
+		~NullShader() override = default;
+
+		void reload(bool force_compile) override { }
+		void rt_reload(bool force_compile) override { }
+
+		size_t get_hash() const override { return hash; }
+		const std::string& get_name() const override { return name; }
+
+		void set_macro(const std::string& macro_name, const std::string& value) override { }
+
+		const std::unordered_map<std::string, ShaderBuffer>& get_shader_buffers() const override { return shader_buffers; }
+		const std::unordered_map<std::string, ShaderResourceDeclaration>& get_resources() const override { return resources; }
+
+		void add_shader_reloaded_callback(const ShaderReloadedCallback& callback) override { }
+
+	private:
+		std::string name;
+		size_t hash = 0;
+
+		std::unordered_map<std::string, ShaderBuffer> shader_buffers;
+		std::unordered_map<std::string, ShaderResourceDeclaration> resources;
+	};
+
+} // namespace ForgottenEngine
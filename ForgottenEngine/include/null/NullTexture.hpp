@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include "render/Texture.hpp"
+
+namespace ForgottenEngine {
+
+	/// Keeps the pixel data on the CPU. Textures loaded from a path are not decoded: they report the
+	/// file size as uploaded bytes and a 1x1 RGBA image.
+	class NullTexture2D : public Texture2D, public PoolAllocated<NullTexture2D> {
+	public:
+		NullTexture2D(const std::string& path, const TextureProperties& properties);
+		NullTexture2D(ImageFormat format, uint32_t width, uint32_t height, const void* data, const TextureProperties& properties);
+		~NullTexture2D() override;
+
+		void resize(const glm::uvec2& size) override { resize(size.x, size.y); }
+		void resize(uint32_t width, uint32_t height) override;
+
+		void bind(uint32_t slot) const override { }
+		void lock() override { }
+		void unlock() override;
+		Buffer get_writeable_buffer() override { return image_data; }
+		bool is_loaded() const override { return loaded; }
+		const std::string& get_path() const override { return path; }
+
+		ImageFormat get_format() const override { return format; }
+		uint32_t get_width() const override { return width; }
+		uint32_t get_height() const override { return height; }
+		glm::uvec2 get_size() const override { return { width, height }; }
+
+		Reference<Image2D> get_image() const override { return nullptr; }
+		uint32_t get_mip_level_count() const override;
+		std::pair<uint32_t, uint32_t> get_mip_size(uint32_t mip) const override;
+		uint64_t get_hash() const override { return reinterpret_cast<uint64_t>(this); }
+		uint32_t get_bindless_index() const override { return 0; }
+
+	private:
+		std::string path;
+		uint32_t width = 1;
+		uint32_t height = 1;
+		TextureProperties properties;
+		ImageFormat format = ImageFormat::RGBA;
+
+		Buffer image_data;
+		bool loaded = false;
+	};
+
+} // namespace ForgottenEngine
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "render/UniformBuffer.hpp"
+#include "render/UniformBufferSet.hpp"
+
+#include <unordered_map>
+
+namespace ForgottenEngine {
+
+	class NullUniformBuffer : public UniformBuffer {
+	public:
+		NullUniformBuffer(uint32_t size, uint32_t binding);
+		~NullUniformBuffer() override = default;
+
+		void set_data(const void* data, uint32_t size, uint32_t offset) override;
+		void render_thread_set_data(const void* data, uint32_t size, uint32_t offset) override;
+
+		uint32_t get_binding() const override { return binding; }
+
+	private:
+		uint32_t size = 0;
+		uint32_t binding = 0;
+	};
+
+	class NullUniformBufferSet : public UniformBufferSet {
+	public:
+		explicit NullUniformBufferSet(uint32_t frames);
+		~NullUniformBufferSet() override = default;
+
+		void create(uint32_t size, uint32_t binding) override;
+
+		Reference<UniformBuffer> get(uint32_t binding, uint32_t set, uint32_t frame) override;
+		void set(const Reference<UniformBuffer>& buffer, uint32_t set, uint32_t frame) override;
+
+		void set_ring(const Reference<UniformBufferRing>& ring) override;
+		Reference<UniformBufferRing> get_ring(uint32_t binding) override;
+
+	private:
+		uint32_t frames;
+		std::unordered_map<uint32_t, std::unordered_map<uint32_t, std::unordered_map<uint32_t, Reference<UniformBuffer>>>>
+			frame_ubs; // frame->set->binding
+		std::unordered_map<uint32_t, Reference<UniformBufferRing>> rings; // binding, set 0
+	};
+
+} // namespace ForgottenEngine
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "render/UniformBufferRing.hpp"
+
+namespace ForgottenEngine {
+
+	/// Keeps the offsets a real ring would hand out, so running out of blocks asserts here too.
+	class NullUniformBufferRing : public UniformBufferRing {
+	public:
+		NullUniformBufferRing(uint32_t block_size, uint32_t block_count, uint32_t binding);
+		~NullUniformBufferRing() override = default;
+
+		void begin_frame() override;
+		uint32_t push(const void* data, uint32_t size) override;
+
+		uint32_t get_offset() const override { return offset; }
+		uint32_t get_binding() const override { return binding; }
+		uint32_t get_block_size() const override { return block_size; }
+
+	private:
+		uint32_t block_size = 0;
+		uint32_t block_count = 0;
+		uint32_t binding = 0;
+
+		uint32_t frame_start = 0;
+		uint32_t head = 0;
+		uint32_t offset = 0;
+	};
+
+} // namespace ForgottenEngine
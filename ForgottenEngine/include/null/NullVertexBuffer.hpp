@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Buffer.hpp"
+#include "render/VertexBuffer.hpp"
+
+namespace ForgottenEngine {
+
+	class NullVertexBuffer : public VertexBuffer, public PoolAllocated<NullVertexBuffer> {
+	public:
+		NullVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Static);
+		NullVertexBuffer(uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Dynamic);
+
+		~NullVertexBuffer() override;
+
+		void set_data(void* buffer, uint32_t in_size, uint32_t offset = 0) override;
+		void rt_set_data(void* buffer, uint32_t in_size, uint32_t offset = 0) override;
+		void bind() const override { }
+
+		void* get_mapped_region(uint32_t frame_index) override;
+
+		unsigned int get_size() const override { return size; }
+		RendererID get_renderer_id() const override { return 0; }
+
+	private:
+		uint32_t size = 0;
+		Buffer local_data; // Stream buffers keep every frame's region here.
+		bool stream = false;
+	};
+
+} // namespace ForgottenEngine
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Common.hpp"
+
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace msdfgen {
+	class FreetypeHandle;
+	class FontHandle;
+} // namespace msdfgen
+
+namespace ForgottenEngine {
+
+	class Texture2D;
+
+	struct DynamicFontAtlasSpecification {
+		uint32_t page_size = 1024;
+		/// Pages kept at most; VRAM is page_size squared times four bytes per page.
+		uint32_t max_pages = 4;
+		double em_size = 40.0;
+		double px_range = 2.0;
+		std::string debug_name = "FontAtlas";
+	};
+
+	/// Generates MTSDF glyphs of one font the first time they are asked for and packs them onto fixed-size RGBA8
+	/// pages, so memory and load time follow the text that is actually drawn. When every page is full and the
+	/// budget is spent, the least recently used page that has not been drawn from this frame is emptied; that
+	/// bumps get_generation() so layouts holding its coordinates know to rebuild.
+	/// Not thread safe; use it from the thread that draws with Renderer2D.
+	class DynamicFontAtlas : public ReferenceCounted {
+	public:
+		/// Pages are tracked in a 32-bit mask and each needs a texture slot of its own when drawing.
+		static constexpr uint32_t max_page_limit = 16;
+		static constexpr uint32_t invalid_page = ~0u;
+
+		struct Glyph {
+			/// Quad in em units relative to the pen position, empty for blank glyphs.
+			glm::vec2 plane_min { 0.0f };
+			glm::vec2 plane_max { 0.0f };
+			glm::vec2 uv_min { 0.0f };
+			glm::vec2 uv_max { 0.0f };
+			double advance = 0.0;
+			uint32_t page = invalid_page;
+
+			bool is_blank() const { return page == invalid_page; }
+		};
+
+		struct Metrics {
+			double line_height = 0.0;
+			double ascender = 0.0;
+			double descender = 0.0;
+		};
+
+		DynamicFontAtlas(const std::filesystem::path& path, const DynamicFontAtlasSpecification& specification = DynamicFontAtlasSpecification());
+		~DynamicFontAtlas() override;
+
+		/// Generates the glyph if it is new. Null if the font has no such glyph, or if there is no room for it
+		/// because every page is in use this frame.
+		const Glyph* get_glyph(char32_t code_point);
+		double get_kerning(char32_t first, char32_t second);
+		const Metrics& get_metrics() const { return metrics; }
+
+		/// Marks pages as drawn from this frame, which keeps them from being evicted until the next.
+		void touch_pages(uint32_t page_mask);
+		void new_frame() { frame++; }
+		uint64_t get_generation() const { return generation; }
+		/// Times get_glyph has turned a glyph away for lack of room. Layouts built while it moved are missing glyphs.
+		uint64_t get_full_miss_count() const { return full_misses; }
+
+		/// Uploads every page that changed. Call before drawing.
+		void update();
+		/// Null until update() has run for a page with glyphs on it.
+		Reference<Texture2D> get_page_texture(uint32_t page) const;
+
+		uint32_t get_page_count() const { return static_cast<uint32_t>(pages.size()); }
+		size_t get_glyph_count() const { return glyphs.size(); }
+
+	private:
+		struct Page;
+		struct Entry {
+			Glyph glyph;
+			bool available = false; // The font has it.
+		};
+
+		bool try_place(Page& page, int width, int height, int& x, int& y);
+		Page* find_page(int width, int height, int& x, int& y);
+		void evict(Page& page);
+
+	private:
+		DynamicFontAtlasSpecification specification;
+
+		msdfgen::FreetypeHandle* freetype = nullptr;
+		msdfgen::FontHandle* font = nullptr;
+		double geometry_scale = 1.0;
+		Metrics metrics;
+
+		std::unordered_map<char32_t, Entry> glyphs;
+		std::unordered_map<uint64_t, double> kerning;
+		std::vector<std::unique_ptr<Page>> pages;
+
+		uint64_t frame = 0;
+		uint64_t generation = 0;
+		uint64_t full_misses = 0;
+		bool warned_full = false;
+	};
+
+} // namespace ForgottenEngine
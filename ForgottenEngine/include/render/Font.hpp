@@ -1,8 +1,11 @@
 #pragma once
 
+#include "render/DynamicFontAtlas.hpp"
 #include "render/Texture.hpp"
 
 #include <filesystem>
+#include <future>
+#include <memory>
 
 namespace ForgottenEngine {
 
@@ -10,11 +13,25 @@ namespace ForgottenEngine {
 
 	class Font : public Asset {
 	public:
+		/// Generates every glyph of the built-in charset into one atlas up front.
 		Font(const std::filesystem::path& filepath);
+		/// Generates glyphs into a DynamicFontAtlas as they are first drawn; nothing is generated up front.
+		Font(const std::filesystem::path& filepath, const DynamicFontAtlasSpecification& specification);
 		virtual ~Font();
 
+		/// Starts building the atlas on the engine thread pool and returns at once. The font can be drawn with once
+		/// is_ready() says so; until then Renderer2D draws its text with the default font.
+		static Reference<Font> load_async(const std::filesystem::path& filepath);
+		/// Main thread. Finishes an asynchronous load if its worker is done.
+		bool is_ready();
+		/// Main thread. Blocks until an asynchronous load is done, and finishes it.
+		void wait();
+
+		/// Null for dynamic fonts.
 		Reference<Texture2D> get_font_atlas() const { return texture_atlas; }
 		const MSDFData* get_msdf_data() const { return msdf_data; }
+		/// Null unless the font was created with a DynamicFontAtlasSpecification.
+		Reference<DynamicFontAtlas> get_dynamic_atlas() const { return dynamic_atlas; }
 
 		static void init();
 		static void shutdown();
@@ -23,10 +40,24 @@ namespace ForgottenEngine {
 		static AssetType get_static_type() { return AssetType::Font; }
 		AssetType get_asset_type() const override { return get_static_type(); }
 
+	private:
+		struct AsyncLoad { };
+		struct LoadedAtlas;
+
+		Font(const std::filesystem::path& filepath, AsyncLoad);
+
+		/// Everything but creating the texture, so it can run on a worker.
+		void load_glyphs(LoadedAtlas& atlas);
+		void finish_loading();
+
 	private:
 		std::filesystem::path file_path;
 		Reference<Texture2D> texture_atlas;
 		MSDFData* msdf_data = nullptr;
+		Reference<DynamicFontAtlas> dynamic_atlas;
+
+		std::future<void> pending_load;
+		std::unique_ptr<LoadedAtlas> loaded_atlas;
 
 	private:
 		static Reference<Font> default_font;
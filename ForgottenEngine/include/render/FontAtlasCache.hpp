@@ -0,0 +1,62 @@
+#pragma once
+
+#include "utilities/MappedFile.hpp"
+
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	struct FontAtlasHeader {
+		static constexpr uint32_t magic = 0x43414646; // "FFAC"
+		static constexpr uint32_t current_version = 2;
+
+		uint32_t Magic = magic;
+		uint32_t Version = current_version;
+		uint64_t Key = 0;
+		uint32_t Width = 0, Height = 0;
+		uint32_t GlyphCount = 0;
+		float EmSize = 0.0f;
+		float PixelRange = 0.0f;
+		uint32_t Reserved = 0;
+	};
+
+	/// Where the packer put one glyph, enough to restore the packed layout without packing again.
+	struct FontAtlasGlyph {
+		uint32_t CodePoint = 0;
+		int32_t X = -1, Y = -1; // -1 for glyphs without a box, such as spaces.
+		int32_t Width = 0, Height = 0;
+	};
+
+	/// A cache file mapped into memory; the pointers stay valid while the MappedFile it was read from is open.
+	struct FontAtlasView {
+		const FontAtlasHeader* header = nullptr;
+		std::span<const FontAtlasGlyph> glyphs;
+		const uint8_t* pixels = nullptr; // RGBA8, Width * Height texels.
+	};
+
+	/// Generated font atlases are written to disk as a header, the packed glyph placements and the MTSDF quantised
+	/// to RGBA8, so later starts skip both packing and generation and map the file instead of reading it.
+	/// Files are named by a key over the font file's bytes and the generator configuration, so an atlas is never
+	/// reused for a changed font or different settings.
+	namespace FontAtlasCache {
+
+		/// FNV-1a over `size` bytes, continuing from `seed`.
+		uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+		/// Key over the font file's contents and `config_hash`, or 0 if the file cannot be read.
+		uint64_t make_key(const std::filesystem::path& font_file, uint64_t config_hash);
+
+		std::filesystem::path get_path(const std::string& font_name, uint64_t key);
+
+		/// Maps the cache file. Files of another version or key, or too short for their header, are ignored.
+		bool read(const std::string& font_name, uint64_t key, MappedFile& file, FontAtlasView& view);
+		void write(const std::string& font_name, const FontAtlasHeader& header, std::span<const FontAtlasGlyph> glyphs, const uint8_t* pixels);
+
+		/// Clamps the generator's float channels to [0, 1] and rounds them to RGBA8; three-channel MSDF gets an opaque alpha.
+		void quantise(const float* pixels, size_t texel_count, uint32_t channels, std::vector<uint8_t>& out_rgba8);
+
+	} // namespace FontAtlasCache
+
+} // namespace ForgottenEngine
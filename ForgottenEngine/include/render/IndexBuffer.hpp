@@ -1,10 +1,11 @@
 #pragma once
 
 #include "Reference.hpp"
+#include "render/ResourcePool.hpp"
 
 namespace ForgottenEngine {
 
-	class IndexBuffer : public ReferenceCounted {
+	class IndexBuffer : public ReferenceCounted, public PooledResource<IndexBuffer> {
 	public:
 		virtual ~IndexBuffer() { }
 
@@ -3,6 +3,7 @@
 #include "Assets.hpp"
 #include "Common.hpp"
 #include "render/Shader.hpp"
+#include "render/ResourcePool.hpp"
 #include "render/Texture.hpp"
 
 #include <unordered_set>
@@ -11,7 +12,7 @@ namespace ForgottenEngine {
 
 	enum class MaterialFlag { None = BIT(0), DepthTest = BIT(1), Blend = BIT(2), TwoSided = BIT(3), DisableShadowCasting = BIT(4) };
 
-	class Material : public ReferenceCounted {
+	class Material : public ReferenceCounted, public PooledResource<Material> {
 	public:
 		virtual ~Material() = default;
 
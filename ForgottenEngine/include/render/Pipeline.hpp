@@ -2,6 +2,7 @@
 
 #include "Reference.hpp"
 #include "render/RenderPass.hpp"
+#include "render/ResourcePool.hpp"
 #include "render/Shader.hpp"
 #include "render/UniformBuffer.hpp"
 #include "render/VertexBuffer.hpp"
@@ -48,7 +49,7 @@ namespace ForgottenEngine {
 		uint64_t ComputeShaderInvocations = 0;
 	};
 
-	class Pipeline : public ReferenceCounted {
+	class Pipeline : public ReferenceCounted, public PooledResource<Pipeline> {
 	public:
 		virtual ~Pipeline() = default;
 
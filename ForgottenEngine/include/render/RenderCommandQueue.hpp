@@ -1,24 +1,95 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace ForgottenEngine {
 
+	struct RenderCommandQueueStats {
+		// Last executed batch.
+		uint32_t command_count = 0;
+		size_t bytes = 0;
+
+		// Largest batch since the queue was created.
+		uint32_t peak_command_count = 0;
+		size_t peak_bytes = 0;
+
+		// Memory currently held by the chunk chain.
+		size_t committed_bytes = 0;
+		uint32_t chunk_count = 0;
+	};
+
+	/// Commands are written into a chain of chunks that is allocated on first use and grows on demand.
+	/// Chunks are kept between frames, so a steady workload allocates nothing. Memory above the recent
+	/// high-water mark is released after a stretch of lighter frames.
 	class RenderCommandQueue {
 	public:
 		typedef void (*RenderCommandFn)(void*);
 
-		RenderCommandQueue();
+		explicit RenderCommandQueue(uint32_t chunk_size = 256 * 1024);
 		~RenderCommandQueue();
 
-		void* allocate(RenderCommandFn func, uint32_t size);
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		void* allocate(RenderCommandFn func, uint32_t size, uint32_t alignment = alignof(std::max_align_t));
+
+		// Stores the callable itself in the queue; it is destroyed after running unless trivially destructible.
+		template <typename FuncT> void submit(FuncT&& func)
+		{
+			using Function = std::remove_cvref_t<FuncT>;
+			static_assert(sizeof(Function) <= UINT32_MAX, "Render command is too large");
+
+			auto render_command = [](void* ptr) {
+				auto function_pointer = static_cast<Function*>(ptr);
+				(*function_pointer)();
+
+				if constexpr (!std::is_trivially_destructible_v<Function>)
+					function_pointer->~Function();
+			};
+
+			auto storage_buffer = allocate(render_command, sizeof(Function), alignof(Function));
+			new (storage_buffer) Function(std::forward<FuncT>(func));
+		}
 
 		void execute();
 
+		[[nodiscard]] const RenderCommandQueueStats& get_stats() const { return stats; }
+
 	private:
-		uint8_t* command_buffer;
-		uint8_t* command_buffer_ptr;
+		struct CommandHeader {
+			RenderCommandFn function;
+			uint32_t payload_offset;
+			uint32_t packet_size;
+		};
+
+		struct Chunk {
+			Chunk* next;
+			size_t size;
+			size_t used;
+		};
+		static constexpr size_t chunk_header_size = (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+		static uint8_t* chunk_data(Chunk* chunk) { return reinterpret_cast<uint8_t*>(chunk) + chunk_header_size; }
+
+		Chunk* allocate_chunk(size_t size);
+		void advance_chunk(size_t required);
+		void release_unused_chunks();
+
+		size_t chunk_size;
+		Chunk* first_chunk = nullptr;
+		Chunk* current_chunk = nullptr;
+
 		uint32_t command_count = 0;
+		size_t bytes_written = 0;
+
+		size_t window_peak_bytes = 0;
+		uint32_t executes_since_release = 0;
+
+		RenderCommandQueueStats stats;
 	};
 
 } // namespace ForgottenEngine
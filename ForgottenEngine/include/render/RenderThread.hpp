@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ApplicationProperties.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace ForgottenEngine {
+
+	struct RenderThreadTimings {
+		// Milliseconds spent by each thread in the last frame.
+		float main_thread_work_time = 0.0f;
+		float main_thread_wait_time = 0.0f;
+		float render_thread_work_time = 0.0f;
+		float render_thread_wait_time = 0.0f;
+	};
+
+	class RenderThread {
+	public:
+		RenderThread(ThreadingPolicy policy, RenderThreadSyncPolicy sync_policy);
+		~RenderThread();
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		void run();
+		void terminate();
+
+		/// Main thread: waits for the previous frame to finish on the render thread, swaps the
+		/// submission and render queues and starts executing the frame that was just recorded.
+		/// Runs the queue inline when single threaded.
+		void kick();
+
+		/// Main thread: returns once the render thread has nothing left to execute.
+		void block_until_rendering_complete();
+
+		[[nodiscard]] bool is_multi_threaded() const { return policy == ThreadingPolicy::MultiThreaded; }
+		[[nodiscard]] RenderThreadTimings get_timings() const;
+
+		/// True on the thread currently executing render commands.
+		static bool is_render_thread();
+
+	private:
+		enum class State { Idle, Kick, Busy };
+
+		void render_loop();
+		void wait_for_idle(std::unique_lock<std::mutex>& lock);
+
+		ThreadingPolicy policy;
+		RenderThreadSyncPolicy sync_policy;
+
+		std::thread thread;
+		mutable std::mutex mutex;
+		std::condition_variable condition;
+		State state = State::Idle;
+		bool running = false;
+
+		std::chrono::steady_clock::time_point last_kick = std::chrono::steady_clock::now();
+		RenderThreadTimings timings;
+	};
+
+} // namespace ForgottenEngine
@@ -2,8 +2,10 @@
 
 #include "ApplicationProperties.hpp"
 #include "Forward.hpp"
+#include "LinearAllocator.hpp"
 #include "Reference.hpp"
 #include "render/RenderCommandQueue.hpp"
+#include "render/RendererCapabilites.hpp"
 #include "render/Shader.hpp"
 #include "vulkan/VulkanSwapchain.hpp"
 
@@ -11,6 +13,15 @@
 
 namespace ForgottenEngine {
 
+	struct RendererFrameStats {
+		// Heap allocations made between the previous two begin_frame calls. Only counted with FORGOTTEN_TRACK_MEMORY.
+		uint64_t heap_allocations = 0;
+		uint64_t heap_bytes = 0;
+		// Bytes the previous frame took from its frame allocator.
+		size_t frame_allocator_bytes = 0;
+		size_t frame_allocator_capacity = 0;
+	};
+
 	class Renderer {
 	public:
 		Renderer() = delete;
@@ -26,6 +37,8 @@ namespace ForgottenEngine {
 
 		static void shut_down();
 
+		/// Executes everything submitted so far before returning. With a render thread, waits for it
+		/// to go idle first and then runs the pending commands on the calling thread.
 		static void wait_and_render();
 		static inline void compile_shaders() { wait_and_render(); };
 
@@ -40,6 +53,10 @@ namespace ForgottenEngine {
 			const Reference<StorageBufferSet>&, const Reference<Material>&, const Reference<VertexBuffer>&, const Reference<IndexBuffer>&,
 			const glm::mat4& transform, uint32_t index_count);
 
+		static void render_instanced_geometry(const Reference<RenderCommandBuffer>&, const Reference<Pipeline>&, const Reference<UniformBufferSet>&,
+			const Reference<StorageBufferSet>&, const Reference<Material>&, const Reference<VertexBuffer>&, const Reference<IndexBuffer>&,
+			const Reference<VertexBuffer>& instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count);
+
 		static void submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline,
 			const Reference<UniformBufferSet>& uniformBufferSet, const Reference<Material>& material);
 
@@ -50,6 +67,9 @@ namespace ForgottenEngine {
 		static void register_shader_dependency(const Reference<Shader>& shader, Reference<Pipeline> pipeline);
 		static void register_shader_dependency(const Reference<Shader>& shader, Reference<Material> material);
 		static void register_shader_dependency(const Reference<Shader>& shader, Reference<ComputePipeline> compute);
+		/// Rings move on to the next frame's region in begin_frame. UniformBufferRing registers itself.
+		static void register_uniform_buffer_ring(UniformBufferRing* ring);
+		static void unregister_uniform_buffer_ring(UniformBufferRing* ring);
 		// end Registrations
 
 		// shaders and macros
@@ -74,6 +94,8 @@ namespace ForgottenEngine {
 
 		static RendererConfig& get_config();
 
+		static const RendererCapabilities& get_capabilities();
+
 		static Reference<ShaderLibrary>& get_shader_library();
 
 		static void RT_BeginGPUPerfMarker(
@@ -83,48 +105,38 @@ namespace ForgottenEngine {
 		static void RT_EndGPUPerfMarker(Reference<RenderCommandBuffer> renderCommandBuffer);
 
 	public:
-		using SubmittedFunction = std::function<void(void)>;
-		static void submit(SubmittedFunction&& func)
-		{
-			auto render_command = [](void* ptr) {
-				auto function_pointer = (SubmittedFunction*)ptr;
-				(*function_pointer)();
-
-				// NOTE: Instead of destroying we could try and enforce all items to be trivally destructible
-				// however some items like uniforms which contain std::strings still exist for now
-				// static_assert(std::is_trivially_destructible_v<SubmittedFunction>, "SubmittedFunction must be
-				// trivially destructible");
-				function_pointer->~SubmittedFunction();
-			};
-			auto storage_buffer = command_queue().allocate(render_command, sizeof(func));
-			new (storage_buffer) SubmittedFunction(std::forward<SubmittedFunction>(func));
-		}
+		// The callable is stored in the command queue as-is, with its own alignment, so no capture is heap-allocated.
+		template <typename FuncT> static void submit(FuncT&& func) { command_queue().submit(std::forward<FuncT>(func)); }
 
-		template <typename SubmittedFunction> static void submit_resource_free(SubmittedFunction&& func)
+		template <typename FuncT> static void submit_resource_free(FuncT&& func)
 		{
-			auto render_command = [](void* ptr) {
-				auto function_pointer = (SubmittedFunction*)ptr;
-				(*function_pointer)();
-
-				// NOTE: Instead of destroying we could try and enforce all items to be trivally destructible
-				// however some items like uniforms which contain std::strings still exist for now
-				// static_assert(std::is_trivially_destructible_v<SubmittedFunction>, "SubmittedFunction must be
-				// trivially destructible");
-				function_pointer->~SubmittedFunction();
-			};
-
-			Renderer::submit([render_command, func]() {
-				const uint32_t index = Renderer::get_current_frame_index();
-				auto storage_buffer = get_render_resource_free_queue(index).allocate(render_command, sizeof(func));
-				new (storage_buffer) SubmittedFunction(std::forward<SubmittedFunction>((SubmittedFunction &&) func));
+			Renderer::submit([func = std::forward<FuncT>(func)]() mutable {
+				const uint32_t index = Renderer::rt_get_current_frame_index();
+				get_render_resource_free_queue(index).submit(std::move(func));
 			});
 		}
 
 		static RenderCommandQueue& get_render_resource_free_queue(uint32_t index);
+		/// Frame-in-flight slot being recorded by the main thread.
 		static uint32_t get_current_frame_index();
+		/// Frame-in-flight slot being executed; use inside submitted commands.
+		static uint32_t rt_get_current_frame_index();
+
+		// Main-thread scratch memory that stays valid until the same frame-in-flight slot comes round again.
+		// Commands themselves live in the command queue; use this for payloads whose size is only known at run
+		// time (uploaded bytes, arrays, strings) instead of heap copies or storage shared with the render thread.
+		static LinearAllocator& get_frame_allocator();
+		static const RendererFrameStats& get_frame_stats();
+		static const RenderCommandQueueStats& get_command_queue_stats();
+
+		// Used by RenderThread.
+		static void swap_queues();
+		static void rt_execute_render_queue();
 
 	private:
 		static RenderCommandQueue& command_queue();
+		static RenderCommandQueue& submission_queue();
+		static RenderCommandQueue& render_queue();
 	};
 
 } // namespace ForgottenEngine
@@ -1,8 +1,13 @@
 #pragma once
 
 #include "Common.hpp"
+#include "render/ResourcePool.hpp"
+#include "render/TextLayout.hpp"
 
 #include <glm/glm.hpp>
+#include <memory>
+#include <mutex>
+#include <span>
 
 namespace ForgottenEngine {
 
@@ -12,12 +17,24 @@ namespace ForgottenEngine {
 	class Material;
 	class RenderPass;
 	class UniformBufferSet;
+	class UniformBufferRing;
 	class AABB;
 	class Mesh;
 	class Font;
 	class IndexBuffer;
 	class RenderCommandBuffer;
 	class VertexBuffer;
+	class Renderer2DContext;
+	class DynamicFontAtlas;
+	struct AtlasRegion;
+
+	/// Input to Renderer2D::draw_quads; the same quad draw_rotated_quad(Position, Size, Rotation, Color) draws.
+	struct SpriteInstance {
+		glm::vec3 Position;
+		float Rotation = 0.0f; // Radians around z.
+		glm::vec2 Size { 1.0f };
+		glm::vec4 Color { 1.0f };
+	};
 
 	struct Renderer2DSpecification {
 		bool swap_chain_target = true;
@@ -39,6 +56,12 @@ namespace ForgottenEngine {
 
 		void on_recreate_swapchain();
 
+		/// A context for drawing quads and sprites from another thread during this scene (see Renderer2DContext).
+		/// Safe to call from any thread between begin_scene and end_scene. end_scene draws the contexts after
+		/// everything drawn on the renderer itself, in increasing `order_key`; give each context its own key,
+		/// such as its worker's index, so the result does not depend on which thread opened first.
+		Renderer2DContext& open_context(uint64_t order_key);
+
 		// Primitives
 		void draw_quad(const glm::mat4& transform, const glm::vec4& color);
 		void draw_quad(const glm::mat4& transform, const Reference<Texture2D>& texture, float tiling_factor = 1.0f,
@@ -62,6 +85,23 @@ namespace ForgottenEngine {
 		void draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
 			float tiling_factor = 1.0f, const glm::vec4& tint_color = glm::vec4(1.0f));
 
+		/// Instanced sprites: one 36-byte QuadInstance per quad, expanded on the GPU. These are drawn after the draw_quad
+		/// family, so keep a translucent layer on one path or the other.
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+			const glm::vec4& uv_rect = { 0.0f, 0.0f, 1.0f, 1.0f }, const glm::vec4& tint_color = glm::vec4(1.0f));
+
+		/// Sprites packed by a SpriteAtlas: the region's part of the atlas page is mapped onto the quad.
+		void draw_quad(const glm::vec3& position, const glm::vec2& size, const AtlasRegion& region, const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+
+		/// Bulk version of draw_rotated_quad, transforming several sprites at a time (see SpriteTransform).
+		void draw_quads(std::span<const SpriteInstance> sprites);
+		void draw_quads(std::span<const SpriteInstance> sprites, const Reference<Texture2D>& texture, float tiling_factor = 1.0f);
+
 		void draw_rotated_rect(const glm::vec2& position, const glm::vec2& size, float rot_radians, const glm::vec4& color);
 		void draw_rotated_rect(const glm::vec3& position, const glm::vec2& size, float rot_radians, const glm::vec4& color);
 
@@ -84,11 +124,43 @@ namespace ForgottenEngine {
 
 		void set_line_width(float line_width);
 
+		struct QuadVertex {
+			glm::vec3 Position;
+			glm::vec4 Color;
+			glm::vec2 TextureCoords;
+			float TextureIndex;
+			float TilingFactor;
+		};
+
+		/// Writes the four vertices of a unit quad placed by `transform` and returns the next free vertex.
+		static QuadVertex* write_quad_vertices(
+			QuadVertex* destination, const glm::mat4& transform, const glm::vec4& color, float texture_index, float tiling_factor);
+		/// The same with texture coordinates spanning `uv_rect` (min u, min v, max u, max v) instead of the whole texture.
+		static QuadVertex* write_quad_vertices(
+			QuadVertex* destination, const glm::mat4& transform, const glm::vec4& color, float texture_index, const glm::vec4& uv_rect);
+
+		/// Per-instance record of the sprite pipeline (Renderer2D_Sprite.glsl). The basis is the quad's scaled x and y axis,
+		/// so position + basis * corner gives each corner. Half floats keep about three significant digits for sizes; depth
+		/// stays a full float, since sprites a small z apart must not collapse onto the same layer.
+		struct QuadInstance {
+			glm::vec3 Position;
+			uint32_t Basis[2]; // Two half floats per axis.
+			uint32_t UVRect[2]; // Min and max UV, two unorm16 each.
+			uint32_t Color; // RGBA8
+			uint32_t TextureIndex;
+		};
+		static_assert(sizeof(QuadInstance) == 36);
+
+		static QuadInstance make_quad_instance(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color,
+			uint32_t texture_index, const glm::vec4& uv_rect);
+
 		// Stats
 		struct Statistics {
 			uint32_t draw_calls = 0;
 			uint32_t quad_count = 0;
 			uint32_t line_count = 0;
+			/// Quad, sprite, text, line and circle batches drawn. Above one per kind, a scene overflowed a single batch.
+			uint32_t batch_count = 0;
 
 			[[nodiscard]] uint32_t get_total_vertex_count() const { return quad_count * 4 + line_count * 2; }
 			[[nodiscard]] uint32_t get_total_index_count() const { return quad_count * 6 + line_count * 2; }
@@ -105,16 +177,31 @@ namespace ForgottenEngine {
 
 		void flush_and_reset();
 		void flush_and_reset_lines();
+		void flush_and_reset_circles();
+		void flush_and_reset_sprites();
+		void flush_and_reset_text();
+
+		/// Appends the open contexts' quads and sprites to the batches, called by end_scene.
+		void merge_contexts();
+		void merge_quads(const Renderer2DContext& context);
+		void merge_sprites(const Renderer2DContext& context);
+
+		/// Writes as many of `sprites` as fit in the current quad batch and returns the rest.
+		std::span<const SpriteInstance> write_quads(std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor);
+
+		/// The texture's bindless index, or else its slot in the current batch, which may first close the batch when
+		/// all slots are taken.
+		float get_quad_texture_index(const Reference<Texture2D>& texture);
+		uint32_t get_sprite_texture_index(const Reference<Texture2D>& texture);
+		/// Places the unit quad at `position`, scaled by `size` along the camera's right and up vectors.
+		glm::mat4 get_billboard_transform(const glm::vec3& position, const glm::vec2& size) const;
+		/// Slot of a font atlas texture, or with `atlas` set, of that atlas page, in the current text batch. False when
+		/// every slot of the batch is taken by something else.
+		bool try_get_font_texture_index(const Reference<Texture2D>& texture, const Reference<DynamicFontAtlas>& atlas, uint32_t page, float& index);
+		/// The slots a font's layout needs, closing the text batch first if they do not all fit in it.
+		void get_font_texture_indices(const Reference<Font>& font, uint32_t page_mask, std::array<float, max_texture_slots>& indices);
 
 	private:
-		struct QuadVertex {
-			glm::vec3 Position;
-			glm::vec4 Color;
-			glm::vec2 TextureCoords;
-			float TextureIndex;
-			float TilingFactor;
-		};
-
 		struct TextVertex {
 			glm::vec3 Position;
 			glm::vec4 Color;
@@ -137,59 +224,127 @@ namespace ForgottenEngine {
 		static constexpr uint32_t max_quads = 10000;
 		static constexpr uint32_t max_vertices = max_quads * 4;
 		static constexpr uint32_t max_indices = max_quads * 6;
-		static constexpr uint32_t max_texture_slots = 16; // TODO: RenderCaps
+		/// Per batch, for devices without RendererCapabilities::bindless_textures. With them the quad and sprite
+		/// shaders index every texture directly and the slots are unused.
+		static constexpr uint32_t max_texture_slots = 16;
 
 		static constexpr uint32_t max_lines = 2000;
 		static constexpr uint32_t max_line_vertices = max_lines * 2;
 		static constexpr uint32_t max_line_indices = max_lines * 6;
 
+		/// Cameras pushed by begin_scene, per frame and per Renderer2D.
+		static constexpr uint32_t max_scenes_per_frame = 32;
+
 		Renderer2DSpecification specification;
 		Reference<RenderCommandBuffer> render_command_buffer;
 
 		Reference<Texture2D> white_texture;
+		bool bindless_textures = false;
+
+		/// Vertices for one draw call. When a batch is full it is closed and drawing continues in the next,
+		/// so a scene is not limited to one batch. Batches are created on first use and kept for later frames.
+		template <typename Vertex> struct Batch {
+			using VertexType = Vertex;
+
+			Reference<VertexBuffer> vertex_buffer; // VertexBufferUsage::Stream, vertices are written straight into it.
+			Vertex* vertex_base = nullptr; // The current frame's region of vertex_buffer.
+			uint32_t vertex_count = 0;
+			uint32_t index_count = 0;
+		};
+
+		/// Each textured batch binds its own textures, so it needs its own material.
+		template <typename Vertex> struct TexturedBatch : Batch<Vertex> {
+			Reference<Material> material;
+			std::array<Reference<Texture2D>, max_texture_slots> texture_slots;
+		};
+
+		using QuadBatch = TexturedBatch<QuadVertex>;
+		/// Vertices are instances here: vertex_count is the instance count and index_count is unused.
+		using SpriteBatch = TexturedBatch<QuadInstance>;
+		/// Slots holding a dynamic atlas page also name the atlas and page. They are resolved to the page's texture in
+		/// end_scene, once the page has all of this frame's glyphs.
+		struct TextBatch : TexturedBatch<TextVertex> {
+			std::array<std::pair<Reference<DynamicFontAtlas>, uint32_t>, max_texture_slots> texture_pages;
+		};
+
+		template <typename BatchType>
+		static BatchType& ensure_batch(std::vector<BatchType>& batches, uint32_t batch_index, uint32_t max_vertex_count);
+		QuadBatch& ensure_quad_batch(uint32_t batch_index);
+		SpriteBatch& ensure_sprite_batch(uint32_t batch_index);
+		TextBatch& ensure_text_batch(uint32_t batch_index);
+
+		void set_texture_slots(const Reference<Material>& material, const std::array<Reference<Texture2D>, max_texture_slots>& slots);
 
 		Reference<Pipeline> quad_pipeline;
-		std::vector<Reference<VertexBuffer>> quad_vertex_buffer;
 		Reference<IndexBuffer> quad_index_buffer;
-		Reference<Material> quad_material;
 
+		std::vector<QuadBatch> quad_batches;
+		uint32_t quad_batch_index = 0;
 		uint32_t quad_index_count = 0;
-		std::vector<QuadVertex*> quad_vertex_buffer_base;
 		QuadVertex* quad_vertex_buffer_ptr;
 
 		Reference<Pipeline> circle_pipeline;
 		Reference<Material> circle_material;
-		std::vector<Reference<VertexBuffer>> circle_vertex_buffer;
+		std::vector<Batch<CircleVertex>> circle_batches;
+		uint32_t circle_batch_index = 0;
 		uint32_t circle_index_count = 0;
-		std::vector<CircleVertex*> circle_vertex_buffer_base;
 		CircleVertex* circle_vertex_buffer_ptr;
 
 		std::array<Reference<Texture2D>, max_texture_slots> texture_slots;
+		// Looked up instead of texture_slots: a handle compare needs no call into the texture.
+		std::array<ResourceHandle<Texture2D>, max_texture_slots> texture_slot_handles;
 		uint32_t texture_slot_index = 1; // 0 = white texture
 
-		glm::vec4 quad_vertex_positions[4];
+		// Sprites
+		Reference<Pipeline> sprite_pipeline;
+		Reference<VertexBuffer> sprite_corner_buffer;
+		Reference<IndexBuffer> sprite_index_buffer;
+
+		std::vector<SpriteBatch> sprite_batches;
+		uint32_t sprite_batch_index = 0;
+		QuadInstance* sprite_instance_buffer_ptr;
+
+		std::array<Reference<Texture2D>, max_texture_slots> sprite_texture_slots;
+		std::array<ResourceHandle<Texture2D>, max_texture_slots> sprite_texture_slot_handles;
+		uint32_t sprite_texture_slot_index = 1; // 0 = white texture
+
+		// Contexts are kept across scenes, so their storage is reused. The first open_context_count are open.
+		std::vector<std::unique_ptr<Renderer2DContext>> contexts;
+		uint32_t open_context_count = 0;
+		std::mutex context_mutex;
+
+		static constexpr glm::vec4 quad_vertex_positions[4] = {
+			{ -0.5f, -0.5f, 0.0f, 1.0f },
+			{ -0.5f, 0.5f, 0.0f, 1.0f },
+			{ 0.5f, 0.5f, 0.0f, 1.0f },
+			{ 0.5f, -0.5f, 0.0f, 1.0f },
+		};
 
 		// Lines
 		Reference<Pipeline> line_pipeline;
 		Reference<Pipeline> line_on_top_pipeline;
-		std::vector<Reference<VertexBuffer>> line_vertex_buffer;
 		Reference<IndexBuffer> line_index_buffer;
 		Reference<Material> line_material;
 
+		std::vector<Batch<LineVertex>> line_batches;
+		uint32_t line_batch_index = 0;
 		uint32_t line_index_count = 0;
-		std::vector<LineVertex*> line_vertex_buffer_base;
 		LineVertex* line_vertex_buffer_ptr;
 
 		// Text
 		Reference<Pipeline> text_pipeline;
-		std::vector<Reference<VertexBuffer>> text_vertex_buffer;
 		Reference<IndexBuffer> text_index_buffer;
-		Reference<Material> text_material;
+		// The open text batch's slots, copied into it when it is closed.
 		std::array<Reference<Texture2D>, max_texture_slots> font_texture_slots;
+		std::array<std::pair<Reference<DynamicFontAtlas>, uint32_t>, max_texture_slots> font_texture_pages;
 		uint32_t font_texture_slot_index = 0;
+		std::vector<DynamicFontAtlas*> scene_atlases; // Scratch for end_scene.
+
+		TextLayoutCache text_layout_cache;
 
+		std::vector<TextBatch> text_batches;
+		uint32_t text_batch_index = 0;
 		uint32_t text_index_count = 0;
-		std::vector<TextVertex*> text_vertex_buffer_base;
 		TextVertex* text_vertex_buffer_ptr;
 
 		glm::mat4 camera_view_proj;
@@ -201,6 +356,8 @@ namespace ForgottenEngine {
 		Statistics stats;
 
 		Reference<UniformBufferSet> uniform_buffer_set;
+		// Every scene of a frame gets its own camera block, read by the draws end_scene submits.
+		Reference<UniformBufferRing> camera_ring;
 
 		struct UBCamera {
 			glm::mat4 ViewProjection;
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "render/Renderer2D.hpp"
+
+#include <span>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	/// Records quads and sprites for one Renderer2D scene on a thread of its own. Open one per worker with
+	/// Renderer2D::open_context between begin_scene and end_scene; end_scene appends every context's quads and
+	/// sprites after the renderer's own, in order of their keys. A context is not thread safe itself, only one
+	/// thread may draw into it, and all drawing must be finished before end_scene.
+	class Renderer2DContext {
+	public:
+		explicit Renderer2DContext(bool bindless_textures);
+
+		/// Clears the recorded quads, keeping their memory for the next scene.
+		void reset(uint64_t order_key);
+		[[nodiscard]] uint64_t get_order_key() const { return order_key; }
+
+		// Same quads as the Renderer2D functions of the same name.
+		void draw_quad(const glm::mat4& transform, const glm::vec4& color);
+		void draw_quad(const glm::mat4& transform, const Reference<Texture2D>& texture, float tiling_factor = 1.0f,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_quad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+		void draw_quad(const glm::vec3& position, const glm::vec2& size, const Reference<Texture2D>& texture, float tiling_factor = 1.0f,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_quad(const glm::vec3& position, const glm::vec2& size, const AtlasRegion& region, const glm::vec4& tint_color = glm::vec4(1.0f));
+
+		void draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
+		void draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+			float tiling_factor = 1.0f, const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+
+		void draw_quads(std::span<const SpriteInstance> sprites);
+		void draw_quads(std::span<const SpriteInstance> sprites, const Reference<Texture2D>& texture, float tiling_factor = 1.0f);
+
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+			const glm::vec4& uv_rect = { 0.0f, 0.0f, 1.0f, 1.0f }, const glm::vec4& tint_color = glm::vec4(1.0f));
+		void draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region,
+			const glm::vec4& tint_color = glm::vec4(1.0f));
+
+		[[nodiscard]] std::span<const Renderer2D::QuadVertex> get_quad_vertices() const { return quad_vertices; }
+		[[nodiscard]] std::span<const Renderer2D::QuadInstance> get_sprite_instances() const { return sprite_instances; }
+
+		/// Without bindless textures the recorded texture indices are local to the context: 0 is the white texture
+		/// and i is get_texture(i). end_scene turns them into slots of the batch the quad lands in.
+		[[nodiscard]] bool uses_bindless_textures() const { return bindless_textures; }
+		[[nodiscard]] const Reference<Texture2D>& get_texture(uint32_t local_index) const { return textures[local_index - 1]; }
+
+	private:
+		Renderer2D::QuadVertex* append_quads(size_t count);
+		uint32_t get_texture_index(const Reference<Texture2D>& texture);
+
+	private:
+		bool bindless_textures = false;
+		uint64_t order_key = 0;
+
+		std::vector<Renderer2D::QuadVertex> quad_vertices;
+		std::vector<Renderer2D::QuadInstance> sprite_instances;
+		std::vector<Reference<Texture2D>> textures;
+		std::vector<ResourceHandle<Texture2D>> texture_handles;
+	};
+
+} // namespace ForgottenEngine
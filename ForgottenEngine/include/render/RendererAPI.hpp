@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common.hpp"
+#include "render/RendererCapabilites.hpp"
 
 #include <ostream>
 
@@ -15,7 +16,7 @@ namespace ForgottenEngine {
 	class VertexBuffer;
 	class IndexBuffer;
 
-	enum class RendererAPIType { None, Vulkan };
+	enum class RendererAPIType { None, Vulkan, Null };
 
 	enum class PrimitiveType { None = 0, Triangles, Lines };
 
@@ -26,6 +27,9 @@ namespace ForgottenEngine {
 		virtual void init() = 0;
 		virtual void shut_down() = 0;
 
+		/// Filled in by init.
+		virtual const RendererCapabilities& get_capabilities() const = 0;
+
 		virtual void begin_frame() = 0;
 		virtual void begin_render_pass(Reference<RenderCommandBuffer> command_buffer, Reference<RenderPass> render_pass, bool explicit_clear) = 0;
 		virtual void end_render_pass(Reference<RenderCommandBuffer> command_buffer) = 0;
@@ -37,6 +41,12 @@ namespace ForgottenEngine {
 			const glm::mat4& transform, uint32_t index_count)
 			= 0;
 
+		/// Draws index_count indices of vb/ib once per record in instance_vb, which is bound at binding 1 (the pipeline's instance_layout).
+		virtual void render_instanced_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline,
+			Reference<UniformBufferSet> ubs, Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb,
+			Reference<IndexBuffer> ib, Reference<VertexBuffer> instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count)
+			= 0;
+
 		virtual void submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline_in,
 			const Reference<UniformBufferSet>& ub, const Reference<StorageBufferSet>& sb, const Reference<Material>& material)
 			= 0;
@@ -50,7 +60,7 @@ namespace ForgottenEngine {
 		static RendererAPIType current() { return current_api; }
 		static void set_api(RendererAPIType api)
 		{
-			core_assert(api == RendererAPIType::Vulkan, "Must be Vulkan for now.");
+			core_assert(api == RendererAPIType::Vulkan || api == RendererAPIType::Null, "Only Vulkan and Null are implemented.");
 			current_api = api;
 		}
 		friend std::ostream& operator<<(std::ostream& os, const RendererAPI& api);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace ForgottenEngine {
@@ -12,6 +13,10 @@ namespace ForgottenEngine {
 		int max_samples = 0;
 		float max_anisotropy = 0.0f;
 		int max_texture_units = 0;
+
+		/// Textures can be indexed through one device-wide table, see Texture2D::get_bindless_index.
+		bool bindless_textures = false;
+		uint32_t max_bindless_textures = 0;
 	};
 
 } // namespace ForgottenEngine
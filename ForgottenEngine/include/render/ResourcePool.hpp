@@ -0,0 +1,258 @@
+#pragma once
+
+#include "utilities/SpinLock.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	/// Index into a ResourcePool plus the generation of the slot when the handle was made.
+	/// Destroying the resource bumps the generation, so stale handles fail validation instead of
+	/// resolving to whatever reused the slot.
+	template <typename T> struct ResourceHandle {
+		static constexpr uint32_t invalid_index = std::numeric_limits<uint32_t>::max();
+
+		uint32_t index = invalid_index;
+		uint32_t generation = 0;
+
+		[[nodiscard]] bool is_null() const { return index == invalid_index; }
+
+		bool operator==(const ResourceHandle&) const = default;
+	};
+
+	template <typename T> class PooledResource;
+
+	/// Slot map for one resource interface. Slots live in fixed pages that never move and are only freed with the pool.
+	/// Adding and removing take the pool's spin lock, since the last reference to a resource is often dropped by a
+	/// command on the render thread while the main thread creates others. Lookups take no lock and do no
+	/// read-modify-write: a slot's generation is bumped before its resource pointer is replaced, and the pointer is
+	/// published with a release store, so a reader that loads the pointer and then sees the handle's generation
+	/// knows the pointer belongs to that handle. Live resources are also kept in a dense array for iteration.
+	template <typename T> class ResourcePool {
+	public:
+		static constexpr uint32_t slots_per_page = 256;
+		static constexpr uint32_t max_pages = 256;
+
+		ResourcePool() = default;
+		~ResourcePool()
+		{
+			for (auto* page : pages)
+				delete[] page;
+		}
+
+		ResourcePool(const ResourcePool&) = delete;
+		ResourcePool& operator=(const ResourcePool&) = delete;
+
+		ResourceHandle<T> add(PooledResource<T>* resource)
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+
+			uint32_t index;
+			if (free_head != ResourceHandle<T>::invalid_index) {
+				index = free_head;
+				free_head = slot(index).next_free;
+			} else {
+				index = slot_count.load(std::memory_order_relaxed);
+				core_assert(index < slots_per_page * max_pages, "ResourcePool is full ({} slots)", slots_per_page * max_pages);
+				if (index % slots_per_page == 0)
+					pages[index / slots_per_page] = new Slot[slots_per_page];
+				slot_count.store(index + 1, std::memory_order_release);
+			}
+
+			Slot& entry = slot(index);
+			entry.resource.store(resource, std::memory_order_release);
+			entry.dense_index = static_cast<uint32_t>(dense.size());
+			dense.push_back(index);
+			return { index, entry.generation.load(std::memory_order_relaxed) };
+		}
+
+		void remove(ResourceHandle<T> handle)
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+			if (!is_valid(handle))
+				return;
+
+			Slot& entry = slot(handle.index);
+			const uint32_t moved = dense.back();
+			dense[entry.dense_index] = moved;
+			slot(moved).dense_index = entry.dense_index;
+			dense.pop_back();
+
+			entry.generation.store(handle.generation + 1, std::memory_order_relaxed);
+			entry.resource.store(nullptr, std::memory_order_release);
+			entry.next_free = free_head;
+			free_head = handle.index;
+		}
+
+		[[nodiscard]] bool is_valid(ResourceHandle<T> handle) const { return resolve_base(handle) != nullptr; }
+
+		/// The pointer is only as good as the caller's own reference to the resource; the pool does not keep it alive.
+		[[nodiscard]] T* resolve(ResourceHandle<T> handle) const { return static_cast<T*>(resolve_base(handle)); }
+
+		/// Visits every live resource. The callback must not create or destroy resources of this type;
+		/// collect them and act after the loop instead.
+		template <typename Func> void for_each(Func&& func)
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+			for (uint32_t index : dense)
+				func(static_cast<T*>(slot(index).resource));
+		}
+
+		[[nodiscard]] uint32_t size() const
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+			return static_cast<uint32_t>(dense.size());
+		}
+
+	private:
+		struct Slot {
+			// Stored as the base: the derived object is still being constructed when it registers.
+			std::atomic<PooledResource<T>*> resource = nullptr;
+			std::atomic<uint32_t> generation = 0;
+			// Only touched under the lock.
+			union {
+				uint32_t dense_index;
+				uint32_t next_free;
+			};
+		};
+
+		/// Loads only, which x86 compiles to plain moves: the acquire on slot_count makes the slot's page visible and the
+		/// acquire on the resource makes the generation bump that came before its last store visible.
+		PooledResource<T>* resolve_base(ResourceHandle<T> handle) const
+		{
+			if (handle.index >= slot_count.load(std::memory_order_acquire))
+				return nullptr;
+
+			const Slot& entry = slot(handle.index);
+			PooledResource<T>* resource = entry.resource.load(std::memory_order_acquire);
+			return entry.generation.load(std::memory_order_relaxed) == handle.generation ? resource : nullptr;
+		}
+
+		Slot& slot(uint32_t index) { return pages[index / slots_per_page][index % slots_per_page]; }
+		const Slot& slot(uint32_t index) const { return pages[index / slots_per_page][index % slots_per_page]; }
+
+		std::array<Slot*, max_pages> pages {};
+		std::atomic<uint32_t> slot_count = 0;
+		uint32_t free_head = ResourceHandle<T>::invalid_index;
+		std::vector<uint32_t> dense;
+		mutable SpinLock lock;
+	};
+
+	/// Base for resource interfaces that should be addressable by handle. Registers the object on
+	/// construction and invalidates its handle on destruction.
+	template <typename T> class PooledResource {
+	public:
+		[[nodiscard]] ResourceHandle<T> get_handle() const { return handle; }
+
+		static ResourcePool<T>& get_pool()
+		{
+			// Never destroyed: resources held by other statics are released after this would be.
+			static auto* pool = new ResourcePool<T>();
+			return *pool;
+		}
+
+		static T* resolve(ResourceHandle<T> handle) { return get_pool().resolve(handle); }
+
+	protected:
+		PooledResource()
+			: handle(get_pool().add(this))
+		{
+		}
+
+		PooledResource(const PooledResource&)
+			: PooledResource()
+		{
+		}
+
+		PooledResource& operator=(const PooledResource&) { return *this; }
+
+		~PooledResource() { get_pool().remove(handle); }
+
+	private:
+		ResourceHandle<T> handle;
+	};
+
+	/// Fixed-size blocks for one concrete type, carved out of pages so objects of the type sit next to
+	/// each other rather than wherever the general heap put them. Pages are kept for reuse.
+	template <typename T, uint32_t ObjectsPerPage = 64> class ObjectStorage {
+	public:
+		ObjectStorage() = default;
+		~ObjectStorage()
+		{
+			for (auto* page : pages)
+				::operator delete[](page, std::align_val_t { alignof(Block) });
+		}
+
+		ObjectStorage(const ObjectStorage&) = delete;
+		ObjectStorage& operator=(const ObjectStorage&) = delete;
+
+		void* allocate()
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+			if (!free_list)
+				grow();
+
+			Block* block = free_list;
+			free_list = block->next;
+			return block->storage;
+		}
+
+		void deallocate(void* memory)
+		{
+			std::scoped_lock<SpinLock> guard(lock);
+			auto* block = reinterpret_cast<Block*>(memory);
+			block->next = free_list;
+			free_list = block;
+		}
+
+	private:
+		union Block {
+			Block* next;
+			alignas(T) std::byte storage[sizeof(T)];
+		};
+
+		void grow()
+		{
+			auto* page = static_cast<Block*>(::operator new[](sizeof(Block) * ObjectsPerPage, std::align_val_t { alignof(Block) }));
+			pages.push_back(page);
+			for (uint32_t i = ObjectsPerPage; i > 0; i--) {
+				page[i - 1].next = free_list;
+				free_list = &page[i - 1];
+			}
+		}
+
+		std::vector<Block*> pages;
+		Block* free_list = nullptr;
+		SpinLock lock;
+	};
+
+	/// Gives a concrete class an operator new/delete backed by ObjectStorage<T>. Types derived further
+	/// than T fall back to the global heap.
+	template <typename T> class PoolAllocated {
+	public:
+		static void* operator new(size_t size) { return size == sizeof(T) ? storage().allocate() : ::operator new(size); }
+
+		static void operator delete(void* memory, size_t size)
+		{
+			if (size == sizeof(T))
+				storage().deallocate(memory);
+			else
+				::operator delete(memory);
+		}
+
+	private:
+		static ObjectStorage<T>& storage()
+		{
+			static auto* instance = new ObjectStorage<T>();
+			return *instance;
+		}
+	};
+
+} // namespace ForgottenEngine
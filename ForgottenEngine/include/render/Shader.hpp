@@ -10,6 +10,7 @@
 #include <filesystem>
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
 namespace ForgottenEngine {
 
@@ -124,6 +125,8 @@ namespace ForgottenEngine {
 
 		void add(const std::string& name, const Reference<Shader>& shader);
 		void load(std::string_view path, bool force_compile = false, bool disable_optimisations = false);
+		/// As load() for each path, with everything that has to be compiled compiled in parallel.
+		void load_all(const std::vector<std::string_view>& paths, bool force_compile = false, bool disable_optimisations = false);
 		void load(std::string_view name, const std::string& path);
 
 		void load_shader_pack(const std::filesystem::path& path);
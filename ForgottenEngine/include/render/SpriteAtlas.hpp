@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Common.hpp"
+
+#include <filesystem>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	class Texture2D;
+
+	/// Where a sprite lives: draw `texture` with `uv_rect` (min u, min v, max u, max v). Renderer2D's AtlasRegion
+	/// overloads take it directly.
+	struct AtlasRegion {
+		Reference<Texture2D> texture;
+		glm::vec4 uv_rect { 0.0f, 0.0f, 1.0f, 1.0f };
+	};
+
+	struct SpriteAtlasSpecification {
+		uint32_t page_size = 1024;
+		/// Larger sprites are refused, they are better off as textures of their own.
+		uint32_t max_sprite_size = 256;
+		/// Edge pixels repeated around each sprite so linear filtering does not pick up its neighbours.
+		uint32_t padding = 1;
+		std::string debug_name = "SpriteAtlas";
+	};
+
+	/// Packs many small RGBA8 images into a few shared pages, so a scene of small sprites needs a handful of
+	/// textures instead of one each. Pixels are kept on the CPU: adding a sprite packs it into the free space of an
+	/// existing page, removing one repacks only its page, and update() uploads just the pages that changed.
+	/// Not thread safe; use it from the thread that draws with Renderer2D.
+	class SpriteAtlas : public ReferenceCounted {
+	public:
+		using Handle = uint32_t;
+		static constexpr Handle invalid_handle = ~0u;
+
+		explicit SpriteAtlas(const SpriteAtlasSpecification& specification = SpriteAtlasSpecification());
+		~SpriteAtlas() override;
+
+		/// Returns invalid_handle if the image is larger than max_sprite_size.
+		Handle add(uint32_t width, uint32_t height, const void* rgba_pixels);
+		Handle add(const std::filesystem::path& path);
+		void remove(Handle handle);
+
+		/// Repacks pages that had sprites removed and uploads every page that changed. Call before drawing.
+		void update();
+
+		/// Repacking moves sprites, so look this up when drawing rather than keeping it.
+		AtlasRegion get_region(Handle handle) const;
+
+		uint32_t get_page_count() const { return static_cast<uint32_t>(pages.size()); }
+		uint32_t get_sprite_count() const { return sprite_count; }
+
+	private:
+		struct Page;
+		struct Sprite {
+			uint32_t page = 0;
+			uint32_t x = 0;
+			uint32_t y = 0;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			std::vector<uint8_t> pixels;
+			bool alive = false;
+		};
+
+		bool try_pack(Page& page, Handle handle);
+		void pack_into_any_page(Handle handle);
+		void repack(uint32_t page_index);
+		void blit(Page& page, const Sprite& sprite);
+
+	private:
+		SpriteAtlasSpecification specification;
+
+		std::vector<Sprite> sprites;
+		std::vector<Handle> free_handles;
+		uint32_t sprite_count = 0;
+
+		std::vector<std::unique_ptr<Page>> pages;
+	};
+
+} // namespace ForgottenEngine
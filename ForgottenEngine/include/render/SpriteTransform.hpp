@@ -0,0 +1,26 @@
+#pragma once
+
+#include "render/Renderer2D.hpp"
+
+#include <span>
+
+namespace ForgottenEngine {
+
+	/// Bulk quad transforms for Renderer2D::draw_quads. Sprites are transformed several at a time in SoA form,
+	/// using AVX2, SSE2 or NEON depending on the build (see FORGOTTEN_ENABLE_AVX2), with a scalar fallback.
+	namespace SpriteTransform {
+
+		/// "avx2", "sse2", "neon" or "scalar".
+		const char* kernel_name();
+
+		/// Writes four vertices per sprite, matching draw_rotated_quad, and returns the next free vertex.
+		Renderer2D::QuadVertex* write_quad_vertices(
+			Renderer2D::QuadVertex* destination, std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor);
+
+		/// The one-lane version of the same kernel, for comparison.
+		Renderer2D::QuadVertex* write_quad_vertices_scalar(
+			Renderer2D::QuadVertex* destination, std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor);
+
+	} // namespace SpriteTransform
+
+} // namespace ForgottenEngine
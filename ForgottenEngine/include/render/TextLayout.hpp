@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Common.hpp"
+
+#include <glm/glm.hpp>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ForgottenEngine {
+
+	class Font;
+
+	namespace Utf8 {
+		/// Decodes the code point starting at `offset` and moves `offset` past it. Malformed sequences decode to
+		/// U+FFFD one byte at a time. Returns false at the end of the string.
+		bool decode_next(std::string_view string, size_t& offset, char32_t& out_code_point);
+	} // namespace Utf8
+
+	/// A string laid out in a font: one quad per visible glyph, in text space (first line's baseline at y = 0,
+	/// one em per line) with atlas texture coordinates. Replaying it is a transform and a colour per vertex.
+	struct TextLayout {
+		struct Glyph {
+			glm::vec2 plane_min;
+			glm::vec2 plane_max;
+			glm::vec2 uv_min;
+			glm::vec2 uv_max;
+			uint32_t page = 0; // Dynamic atlas page; always 0 for fonts with a single atlas.
+		};
+
+		std::vector<Glyph> glyphs;
+		/// For dynamic atlases: the pages the glyphs are on, and the atlas generation the coordinates belong to.
+		uint32_t page_mask = 0;
+		uint64_t atlas_generation = 0;
+		/// Some glyphs were left out because the dynamic atlas had no room; the cache builds it again next time.
+		bool incomplete = false;
+	};
+
+	/// Layouts of recently drawn strings, keyed by the text and every parameter that moves a glyph. Text that is
+	/// drawn unchanged frame after frame is laid out once; entries not used for `max_unused_frames` are dropped.
+	/// With a dynamic atlas, layouts are rebuilt after the atlas has evicted a page or when they were incomplete.
+	/// Not thread safe; owned by the Renderer2D that draws with it.
+	class TextLayoutCache {
+	public:
+		static constexpr uint32_t max_unused_frames = 120;
+
+		const TextLayout& get(std::string_view text, const Reference<Font>& font, float max_width, float line_height_offset, float kerning_offset);
+
+		/// Advances the frame counter and now and then evicts stale layouts. Renderer2D calls it from begin_scene.
+		void new_frame();
+		void clear() { entries.clear(); }
+
+		[[nodiscard]] size_t size() const { return entries.size(); }
+
+		/// Lays out without caching.
+		static void build(TextLayout& layout, std::string_view text, const Font& font, float max_width, float line_height_offset,
+			float kerning_offset, std::vector<char32_t>& scratch);
+
+	private:
+		struct Key {
+			size_t text_hash;
+			const Font* font;
+			float max_width;
+			float line_height_offset;
+			float kerning_offset;
+
+			bool operator==(const Key& other) const = default;
+		};
+
+		struct KeyHasher {
+			size_t operator()(const Key& key) const;
+		};
+
+		struct Entry {
+			std::string text; // Guards against hash collisions.
+			Reference<Font> font; // Keeps the Font (and so the key's pointer) alive while cached.
+			TextLayout layout;
+			uint64_t last_used_frame = 0;
+		};
+
+	private:
+		std::unordered_map<Key, Entry, KeyHasher> entries;
+		std::vector<char32_t> scratch;
+		uint64_t frame = 0;
+	};
+
+} // namespace ForgottenEngine
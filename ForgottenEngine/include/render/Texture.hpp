@@ -4,6 +4,7 @@
 #include "Buffer.hpp"
 #include "Common.hpp"
 #include "render/Image.hpp"
+#include "render/ResourcePool.hpp"
 
 namespace ForgottenEngine {
 
@@ -26,7 +27,7 @@ namespace ForgottenEngine {
 		virtual TextureType get_type() const = 0;
 	};
 
-	class Texture2D : public Texture {
+	class Texture2D : public Texture, public PooledResource<Texture2D> {
 	public:
 		virtual void resize(const glm::uvec2& size) = 0;
 		virtual void resize(uint32_t width, uint32_t height) = 0;
@@ -42,6 +43,10 @@ namespace ForgottenEngine {
 
 		virtual const std::string& get_path() const = 0;
 
+		/// Stable slot in the bindless texture table for the texture's lifetime. 0 (the white texture)
+		/// when the backend has no such table or it is full, see RendererCapabilities::bindless_textures.
+		virtual uint32_t get_bindless_index() const = 0;
+
 		TextureType get_type() const override { return TextureType::Texture2D; }
 
 		static AssetType get_static_type() { return AssetType::Texture; }
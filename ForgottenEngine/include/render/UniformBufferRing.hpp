@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Reference.hpp"
+
+namespace ForgottenEngine {
+
+	/// Per-frame arena of small uniform blocks, bound as a dynamic uniform buffer. Each push() writes a block into
+	/// persistently mapped memory and the following draws read it through a dynamic offset, so there is no copy on the
+	/// render thread and no descriptor write per block. A shader opts a block in by naming it with a "Dynamic" prefix,
+	/// e.g. `layout(std140, binding = 2) uniform DynamicDraw { ... };`, and the ring is attached to the
+	/// UniformBufferSet the draws use (UniformBufferSet::set_ring).
+	class UniformBufferRing : public ReferenceCounted {
+	public:
+		UniformBufferRing();
+		virtual ~UniformBufferRing();
+
+		/// Starts filling the current frame's region. Renderer::begin_frame calls it for every ring.
+		virtual void begin_frame() = 0;
+
+		/// Copies a block of at most get_block_size() bytes into the ring; draws submitted after this read it.
+		/// Returns its dynamic offset.
+		virtual uint32_t push(const void* data, uint32_t size) = 0;
+
+		/// The dynamic offset of the last block pushed.
+		virtual uint32_t get_offset() const = 0;
+
+		virtual uint32_t get_binding() const = 0;
+		virtual uint32_t get_block_size() const = 0;
+
+		/// Room for `block_count` blocks of `block_size` bytes per frame in flight.
+		static Reference<UniformBufferRing> create(uint32_t block_size, uint32_t block_count, uint32_t binding);
+	};
+
+} // namespace ForgottenEngine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "UniformBuffer.hpp"
+#include "UniformBufferRing.hpp"
 
 namespace ForgottenEngine {
 
@@ -13,6 +14,10 @@ namespace ForgottenEngine {
 		virtual Reference<UniformBuffer> get(uint32_t binding, uint32_t set, uint32_t frame) = 0;
 		virtual void set(const Reference<UniformBuffer>& buffer, uint32_t set, uint32_t frame) = 0;
 
+		/// Binds a ring to its binding in set 0, for shaders that declare the block there as dynamic.
+		virtual void set_ring(const Reference<UniformBufferRing>& ring) = 0;
+		virtual Reference<UniformBufferRing> get_ring(uint32_t binding) = 0;
+
 		static Reference<UniformBufferSet> create(uint32_t frames);
 	};
 
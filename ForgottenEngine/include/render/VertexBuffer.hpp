@@ -1,10 +1,11 @@
 #pragma once
 
 #include "Common.hpp"
+#include "render/ResourcePool.hpp"
 
 namespace ForgottenEngine {
 
-	enum class ShaderDataType { None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, Bool };
+	enum class ShaderDataType { None = 0, Float, Float2, Float3, Float4, Mat3, Mat4, Int, Int2, Int3, Int4, UInt, UInt2, Bool };
 
 	static uint32_t shader_data_type_size(ShaderDataType type)
 	{
@@ -29,6 +30,10 @@ namespace ForgottenEngine {
 			return 4 * 3;
 		case ShaderDataType::Int4:
 			return 4 * 4;
+		case ShaderDataType::UInt:
+			return 4;
+		case ShaderDataType::UInt2:
+			return 4 * 2;
 		case ShaderDataType::Bool:
 			return 1;
 		default:
@@ -79,6 +84,10 @@ namespace ForgottenEngine {
 				return 3;
 			case ShaderDataType::Int4:
 				return 4;
+			case ShaderDataType::UInt:
+				return 1;
+			case ShaderDataType::UInt2:
+				return 2;
 			case ShaderDataType::Bool:
 				return 1;
 			default:
@@ -125,9 +134,11 @@ namespace ForgottenEngine {
 		uint32_t stride = 0;
 	};
 
-	enum class VertexBufferUsage { None = 0, Static = 1, Dynamic = 2 };
+	/// Stream buffers are persistently mapped, with one region of get_size() bytes per frame in flight. They are
+	/// written in place through get_mapped_region instead of being copied in by set_data.
+	enum class VertexBufferUsage { None = 0, Static = 1, Dynamic = 2, Stream = 3 };
 
-	class VertexBuffer : public ReferenceCounted {
+	class VertexBuffer : public ReferenceCounted, public PooledResource<VertexBuffer> {
 	public:
 		virtual ~VertexBuffer() { }
 
@@ -135,6 +146,10 @@ namespace ForgottenEngine {
 		virtual void rt_set_data(void* buffer, uint32_t size, uint32_t offset = 0) = 0;
 		virtual void bind() const = 0;
 
+		/// Stream buffers only, nullptr otherwise: the memory the GPU reads for frame `frame_index`. Write the region
+		/// of the frame being recorded (Renderer::get_current_frame_index); the GPU is done with it by then.
+		virtual void* get_mapped_region(uint32_t frame_index) = 0;
+
 		virtual unsigned int get_size() const = 0;
 		virtual RendererID get_renderer_id() const = 0;
 
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace ForgottenEngine {
+
+	/// A file mapped read-only into memory. Pages are read on first touch and shared with the OS file cache,
+	/// so nothing is copied up front.
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// Closes any previous mapping. False if the file is missing, empty or cannot be mapped.
+		bool open(const std::filesystem::path& path);
+		void close();
+
+		[[nodiscard]] const uint8_t* get_data() const { return data; }
+		[[nodiscard]] size_t get_size() const { return size; }
+		explicit operator bool() const { return data; }
+
+	private:
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		// Windows HANDLEs, unused elsewhere. Declared everywhere: the platform define is private to the engine, so
+		// the layout must not depend on it.
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+	};
+
+} // namespace ForgottenEngine
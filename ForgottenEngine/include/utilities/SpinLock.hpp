@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define FORGOTTEN_SPIN_PAUSE() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define FORGOTTEN_SPIN_PAUSE() asm volatile("yield")
+#else
+#define FORGOTTEN_SPIN_PAUSE()
+#endif
+
+namespace ForgottenEngine {
+
+	/// Test-and-test-and-set lock for very short critical sections. Constant-initialised and allocation free,
+	/// so it can be used from inside operator new.
+	class SpinLock {
+	public:
+		void lock()
+		{
+			while (flag.test_and_set(std::memory_order_acquire)) {
+				while (flag.test(std::memory_order_relaxed))
+					FORGOTTEN_SPIN_PAUSE();
+			}
+		}
+
+		bool try_lock() { return !flag.test_and_set(std::memory_order_acquire); }
+
+		void unlock() { flag.clear(std::memory_order_release); }
+
+	private:
+		std::atomic_flag flag;
+	};
+
+} // namespace ForgottenEngine
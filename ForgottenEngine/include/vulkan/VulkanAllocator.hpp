@@ -19,6 +19,8 @@ namespace ForgottenEngine {
 		~VulkanAllocator();
 
 		VmaAllocation allocate_buffer(VkBufferCreateInfo bci, VmaMemoryUsage usage, VkBuffer& out_buffer);
+		/// Host-visible, coherent memory that stays mapped until the buffer is destroyed, so writes need no flush.
+		VmaAllocation allocate_mapped_buffer(VkBufferCreateInfo bci, VkBuffer& out_buffer, void*& out_mapped_data);
 		VmaAllocation allocate_image(VkImageCreateInfo ici, VmaMemoryUsage usage, VkImage& out_image);
 		void free(VmaAllocation allocation);
 		void destroy_image(VkImage image, VmaAllocation allocation);
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+namespace ForgottenEngine {
+
+	/// One descriptor set holding every Texture2D, indexed by Texture2D::get_bindless_index(). A shader opts in by
+	/// declaring an unsized sampler2D array alone in its own set; VulkanShader gives that set this layout and
+	/// VulkanRenderer binds it. Needs descriptor indexing, see VulkanPhysicalDevice::supports_bindless_textures.
+	class VulkanBindlessTextures {
+	public:
+		/// Holds the white texture. Also what textures get when the table is unsupported or full.
+		static constexpr uint32_t white_texture_index = 0;
+
+		static bool is_supported();
+		/// From the device's update-after-bind limits, at most 65536 so indices fit the sprite instance record.
+		static uint32_t get_capacity();
+
+		static uint32_t allocate();
+		/// The index is handed out again only after the frames in flight that may still sample it have finished.
+		static void release(uint32_t index);
+		static void rt_write(uint32_t index, const VkDescriptorImageInfo& image_info);
+
+		static VkDescriptorSetLayout get_descriptor_set_layout();
+		static VkDescriptorSet get_descriptor_set();
+
+		static void shut_down();
+	};
+
+} // namespace ForgottenEngine
@@ -2,6 +2,7 @@
 
 #include "Reference.hpp"
 #include "vk_mem_alloc.h"
+#include "vulkan/VulkanUploadManager.hpp"
 
 #include <unordered_set>
 #include <vector>
@@ -31,6 +32,12 @@ namespace ForgottenEngine {
 		const VkPhysicalDeviceLimits& get_limits() const { return properties.limits; }
 		const VkPhysicalDeviceMemoryProperties& get_memory_properties() const { return memory_properties; }
 		const VkPhysicalDeviceFeatures& get_features() const { return features; }
+		const VkPhysicalDeviceDescriptorIndexingProperties& get_descriptor_indexing_properties() const { return descriptor_indexing_properties; }
+
+		/// Descriptor indexing with everything VulkanBindlessTextures needs: unsized, partially bound, update-after-bind
+		/// sampler arrays indexed non-uniformly.
+		bool supports_bindless_textures() const;
+		bool supports_timeline_semaphores() const { return timeline_semaphore_features.timelineSemaphore; }
 
 		VkFormat get_depth_format() const { return depth_format; }
 
@@ -47,6 +54,9 @@ namespace ForgottenEngine {
 		VkPhysicalDeviceProperties properties {};
 		VkPhysicalDeviceFeatures features {};
 		VkPhysicalDeviceMemoryProperties memory_properties {};
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing_features {};
+		VkPhysicalDeviceDescriptorIndexingProperties descriptor_indexing_properties {};
+		VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore_features {};
 
 		VkFormat depth_format = VK_FORMAT_UNDEFINED;
 
@@ -67,6 +77,11 @@ namespace ForgottenEngine {
 
 		VkQueue get_graphics_queue() { return graphics_queue; }
 		VkQueue get_compute_queue() { return compute_queue; }
+		/// The dedicated transfer queue, or nullptr when the transfer family is the graphics family.
+		VkQueue get_transfer_queue() { return transfer_queue; }
+
+		/// Batched staging uploads; see VulkanUploadManager. Created on first use, once the allocator can reach the device.
+		const Reference<VulkanUploadManager>& get_upload_manager();
 
 		VkCommandBuffer get_command_buffer(bool begin, bool compute = false);
 		void flush_command_buffer(VkCommandBuffer command_buffer);
@@ -85,6 +100,9 @@ namespace ForgottenEngine {
 
 		VkQueue graphics_queue { nullptr };
 		VkQueue compute_queue { nullptr };
+		VkQueue transfer_queue { nullptr };
+
+		Reference<VulkanUploadManager> upload_manager;
 
 		bool enable_debug_markers = false;
 	};
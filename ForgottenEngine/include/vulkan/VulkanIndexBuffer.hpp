@@ -7,7 +7,7 @@
 
 namespace ForgottenEngine {
 
-	class VulkanIndexBuffer : public IndexBuffer {
+	class VulkanIndexBuffer : public IndexBuffer, public PoolAllocated<VulkanIndexBuffer> {
 	public:
 		VulkanIndexBuffer(uint32_t size);
 		VulkanIndexBuffer(void* data, uint32_t size = 0);
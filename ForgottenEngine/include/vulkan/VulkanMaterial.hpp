@@ -5,7 +5,7 @@
 
 namespace ForgottenEngine {
 
-	class VulkanMaterial : public Material {
+	class VulkanMaterial : public Material, public PoolAllocated<VulkanMaterial> {
 	public:
 		VulkanMaterial(const Reference<Shader>& shader, std::string name);
 		VulkanMaterial(Reference<Material> material, const std::string& name);
@@ -7,7 +7,7 @@
 
 namespace ForgottenEngine {
 
-	class VulkanPipeline : public Pipeline {
+	class VulkanPipeline : public Pipeline, public PoolAllocated<VulkanPipeline> {
 	public:
 		explicit VulkanPipeline(const PipelineSpecification& spec);
 
@@ -35,6 +35,8 @@ namespace ForgottenEngine {
 		void init() override;
 		void shut_down() override;
 
+		const RendererCapabilities& get_capabilities() const override;
+
 	public:
 		void begin_frame() override;
 
@@ -54,6 +56,10 @@ namespace ForgottenEngine {
 			Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb, Reference<IndexBuffer> ib,
 			const glm::mat4& transform, uint32_t index_count) override;
 
+		void render_instanced_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline, Reference<UniformBufferSet> ubs,
+			Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb, Reference<IndexBuffer> ib,
+			Reference<VertexBuffer> instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count) override;
+
 		void submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline,
 			const Reference<UniformBufferSet>& uniform_buffer_set, const Reference<Material>& material) override;
 
@@ -5,6 +5,7 @@
 #include "VulkanShaderResource.hpp"
 
 #include <filesystem>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -81,6 +82,14 @@ namespace ForgottenEngine {
 
 		bool has_descriptor_set(uint32_t set) const { return is_in_map(type_counts, set); }
 
+		/// The set declared as an unsized sampler2D array, which uses VulkanBindlessTextures' layout and set.
+		std::optional<uint32_t> get_bindless_texture_set() const { return bindless_texture_set; }
+
+		/// Uniform blocks named Dynamic* are dynamic uniform buffers, fed by a UniformBufferRing.
+		static bool is_dynamic_uniform_buffer(const ShaderResource::UniformBuffer& uniform_buffer);
+		/// Set 0's dynamic uniform buffers in binding order, the order their offsets are bound in.
+		const std::vector<uint32_t>& get_dynamic_uniform_buffer_bindings() const { return dynamic_uniform_buffer_bindings; }
+
 		const std::vector<ShaderResource::PushConstantRange>& get_push_constant_ranges() const { return reflection_data.push_constant_ranges; }
 
 		struct ShaderMaterialDescriptorSet {
@@ -116,6 +125,8 @@ namespace ForgottenEngine {
 		// VkDescriptorPool m_DescriptorPool = nullptr;
 
 		std::unordered_map<uint32_t, std::vector<VkDescriptorPoolSize>> type_counts;
+		std::optional<uint32_t> bindless_texture_set;
+		std::vector<uint32_t> dynamic_uniform_buffer_bindings;
 		ShaderType shader_type;
 
 	private:
@@ -7,7 +7,7 @@
 
 namespace ForgottenEngine {
 
-	class VulkanTexture2D : public Texture2D {
+	class VulkanTexture2D : public Texture2D, public PoolAllocated<VulkanTexture2D> {
 	public:
 		VulkanTexture2D(const std::string& path, const TextureProperties& properties);
 		VulkanTexture2D(ImageFormat format, uint32_t width, uint32_t height, const void* data, const TextureProperties& properties);
@@ -25,6 +25,7 @@ namespace ForgottenEngine {
 		const std::string& get_path() const override;
 
 		const VkDescriptorImageInfo& get_vulkan_descriptor_info() const { return image.as<VulkanImage2D>()->get_descriptor_info(); }
+		uint32_t get_bindless_index() const override { return bindless_index; }
 
 		ImageFormat get_format() const override { return format; }
 		uint32_t get_width() const override { return width; }
@@ -37,9 +38,11 @@ namespace ForgottenEngine {
 		std::pair<uint32_t, uint32_t> get_mip_size(uint32_t mip) const override;
 		uint64_t get_hash() const override { return (uint64_t)image.as<VulkanImage2D>()->get_image_info().image_view; }
 
+		/// Builds the mip chain from mip 0, which must be in TRANSFER_DST_OPTIMAL after being written.
 		void generate_mips();
 
 	private:
+		void record_mips(VkCommandBuffer command_buffer);
 		bool load_image(const std::string& in_path);
 		bool load_image(const void* data, uint32_t size);
 
@@ -55,6 +58,7 @@ namespace ForgottenEngine {
 		Reference<Image2D> image;
 
 		ImageFormat format = ImageFormat::None;
+		uint32_t bindless_index = 0;
 	};
 
 	class VulkanTextureCube : public TextureCube {
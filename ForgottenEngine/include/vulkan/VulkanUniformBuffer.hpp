@@ -30,8 +30,6 @@ namespace ForgottenEngine {
 		uint32_t binding = 0;
 		std::string name;
 		VkShaderStageFlagBits shader_stage = VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
-
-		uint8_t* local_storage = nullptr;
 	};
 
 } // namespace ForgottenEngine
\ No newline at end of file
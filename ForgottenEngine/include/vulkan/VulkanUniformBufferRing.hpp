@@ -0,0 +1,41 @@
+#pragma once
+
+#include "render/UniformBufferRing.hpp"
+#include "vk_mem_alloc.h"
+
+#include <vulkan/vulkan.h>
+
+namespace ForgottenEngine {
+
+	class VulkanUniformBufferRing : public UniformBufferRing {
+	public:
+		VulkanUniformBufferRing(uint32_t block_size, uint32_t block_count, uint32_t binding);
+		~VulkanUniformBufferRing() override;
+
+		void begin_frame() override;
+		uint32_t push(const void* data, uint32_t size) override;
+
+		uint32_t get_offset() const override { return offset; }
+		uint32_t get_binding() const override { return binding; }
+		uint32_t get_block_size() const override { return block_size; }
+
+		/// One block wide; the dynamic offset picks the block.
+		const VkDescriptorBufferInfo& get_descriptor_buffer_info() const { return descriptor_buffer_info; }
+
+	private:
+		uint32_t block_size = 0;
+		uint32_t binding = 0;
+		uint32_t alignment = 0; // minUniformBufferOffsetAlignment
+		uint32_t frame_size = 0; // Bytes per frame in flight.
+
+		uint32_t frame_start = 0;
+		uint32_t head = 0; // Next free byte, relative to frame_start.
+		uint32_t offset = 0;
+
+		VkBuffer vk_buffer = nullptr;
+		VmaAllocation memory_alloc = nullptr;
+		uint8_t* mapped_data = nullptr;
+		VkDescriptorBufferInfo descriptor_buffer_info {};
+	};
+
+} // namespace ForgottenEngine
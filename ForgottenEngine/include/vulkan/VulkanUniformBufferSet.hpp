@@ -17,10 +17,14 @@ namespace ForgottenEngine {
 		Reference<UniformBuffer> get(uint32_t binding, uint32_t set, uint32_t frame) override;
 		void set(const Reference<UniformBuffer>& buffer, uint32_t set, uint32_t frame) override;
 
+		void set_ring(const Reference<UniformBufferRing>& ring) override;
+		Reference<UniformBufferRing> get_ring(uint32_t binding) override;
+
 	private:
 		uint32_t frames;
 		std::unordered_map<uint32_t, std::unordered_map<uint32_t, std::unordered_map<uint32_t, Reference<UniformBuffer>>>>
 			frame_ubs; // frame->set->binding
+		std::unordered_map<uint32_t, Reference<UniformBufferRing>> rings; // binding, set 0
 	};
 
 } // namespace ForgottenEngine
\ No newline at end of file
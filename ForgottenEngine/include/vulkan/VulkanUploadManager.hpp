@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Reference.hpp"
+#include "vk_mem_alloc.h"
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace ForgottenEngine {
+
+	class VulkanDevice;
+
+	/// Value the upload timeline reaches once a batch has finished on the GPU.
+	using UploadTicket = uint64_t;
+
+	/// Copies buffer and image data to the GPU through a persistently mapped staging ring. Uploads are recorded into
+	/// one open batch, which is submitted by flush(), at the latest before the next graphics submission, so a frame's
+	/// worth of loads costs one submission and no waiting. With a dedicated transfer queue family the copies run there
+	/// and ownership moves to the graphics family in a second submission that waits on the timeline semaphore.
+	/// Without timeline semaphores everything goes to the graphics queue and flush() waits on a fence instead.
+	///
+	/// Render thread only.
+	class VulkanUploadManager : public ReferenceCounted {
+	public:
+		static constexpr VkDeviceSize default_staging_size = 32 * 1024 * 1024;
+
+		VulkanUploadManager(VulkanDevice& device, VkDeviceSize staging_size = default_staging_size);
+		~VulkanUploadManager() override;
+
+		void destroy();
+
+		/// Copies size bytes of data to destination at offset. The buffer needs TRANSFER_DST usage.
+		UploadTicket upload_buffer(VkBuffer destination, const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
+		/// Copies data into mip 0 of a single-layer colour image and transitions it to final_layout for sampling.
+		UploadTicket upload_image(VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height, VkImageLayout final_layout);
+		/// As above, but mip 0 is left in TRANSFER_DST_OPTIMAL and record_on_graphics is called with the graphics queue
+		/// command buffer of the batch, after the image is owned by the graphics family, to finish it (e.g. build mips).
+		UploadTicket upload_image(VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height,
+			const std::function<void(VkCommandBuffer)>& record_on_graphics);
+
+		/// Submits the open batch, if it has any uploads, and returns the ticket of the last submitted batch.
+		UploadTicket flush();
+		/// Ticket of the open batch; valid once it has been flushed.
+		UploadTicket get_pending_ticket() const { return next_value; }
+
+		bool is_complete(UploadTicket ticket);
+		/// Flushes first if the ticket belongs to the open batch.
+		void wait(UploadTicket ticket);
+
+		bool uses_transfer_queue() const { return dedicated_transfer; }
+
+	private:
+		struct StagingAllocation {
+			VkBuffer buffer = nullptr;
+			VkDeviceSize offset = 0;
+			uint8_t* data = nullptr;
+		};
+
+		struct DedicatedStaging {
+			VkBuffer buffer = nullptr;
+			VmaAllocation allocation = nullptr;
+		};
+
+		struct Batch {
+			UploadTicket value = 0;
+			VkCommandBuffer transfer_command_buffer = nullptr;
+			VkCommandBuffer graphics_command_buffer = nullptr; // Same as transfer_command_buffer without a transfer queue.
+			VkDeviceSize ring_bytes = 0; // Including the padding skipped when wrapping.
+			std::vector<DedicatedStaging> dedicated_staging;
+		};
+
+		StagingAllocation allocate_staging(VkDeviceSize size);
+		bool try_allocate_ring(VkDeviceSize size, StagingAllocation& out);
+		Batch& open_batch();
+		void begin_image_upload(VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height);
+		void retire_completed();
+		UploadTicket get_completed_value();
+
+	private:
+		VkDevice device = nullptr;
+		VkQueue transfer_queue = nullptr;
+		VkQueue graphics_queue = nullptr;
+		uint32_t transfer_family = 0;
+		uint32_t graphics_family = 0;
+		bool dedicated_transfer = false;
+		bool timeline_semaphores = false;
+
+		VkCommandPool transfer_command_pool = nullptr;
+		VkCommandPool graphics_command_pool = nullptr;
+		VkSemaphore timeline = nullptr;
+		VkFence fence = nullptr; // Only without timeline semaphores.
+
+		VkBuffer ring_buffer = nullptr;
+		VmaAllocation ring_allocation = nullptr;
+		uint8_t* ring_data = nullptr;
+		VkDeviceSize ring_size = 0;
+		VkDeviceSize ring_head = 0;
+		VkDeviceSize ring_used = 0;
+
+		bool has_open_batch = false;
+		Batch current;
+		std::deque<Batch> in_flight;
+
+		UploadTicket next_value = 1;
+		UploadTicket last_submitted = 0;
+		UploadTicket completed_value = 0;
+	};
+
+} // namespace ForgottenEngine
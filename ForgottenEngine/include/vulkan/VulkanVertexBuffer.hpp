@@ -6,7 +6,7 @@
 
 namespace ForgottenEngine {
 
-	class VulkanVertexBuffer : public VertexBuffer {
+	class VulkanVertexBuffer : public VertexBuffer, public PoolAllocated<VulkanVertexBuffer> {
 	public:
 		VulkanVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Static);
 		VulkanVertexBuffer(uint32_t size, VertexBufferUsage usage = VertexBufferUsage::Dynamic);
@@ -17,14 +17,19 @@ namespace ForgottenEngine {
 		virtual void rt_set_data(void* buffer, uint32_t size, uint32_t offset = 0) override;
 		virtual void bind() const override { }
 
+		virtual void* get_mapped_region(uint32_t frame_index) override;
+
 		virtual unsigned int get_size() const override { return size; }
 		virtual RendererID get_renderer_id() const override { return 0; }
 
 		VkBuffer get_vulkan_buffer() const { return vulkan_buffer; }
+		/// Where the region of the frame being rendered starts; 0 unless this is a Stream buffer.
+		VkDeviceSize rt_get_offset() const;
 
 	private:
 		uint32_t size = 0;
 		Buffer local_data;
+		uint8_t* mapped_data = nullptr; // Stream buffers: frames_in_flight regions of `size` bytes.
 
 		VkBuffer vulkan_buffer = nullptr;
 		VmaAllocation memory_allocation;
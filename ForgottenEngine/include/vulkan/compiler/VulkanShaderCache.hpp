@@ -7,13 +7,21 @@
 
 namespace ForgottenEngine {
 
+	/// Which stages of which shaders were last compiled from what source. The registry is read from disk once, on
+	/// first use, and kept in memory; changes are written back by flush().
 	class VulkanShaderCache {
 	public:
 		static VkShaderStageFlagBits has_changed(Reference<VulkanShaderCompiler> shader);
 
+		/// Writes the registry if it changed since it was read or last written. The file is replaced in one rename,
+		/// so it is never seen half written. Call once after a batch of shader loads.
+		static void flush();
+
 	private:
-		static void serialize(const std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>>& shader_cache);
-		static void deserialize(std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>>& shader_cache);
+		using Registry = std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>>;
+
+		static void serialize(const Registry& shader_cache);
+		static bool deserialize(Registry& shader_cache);
 	};
 
 } // namespace ForgottenEngine
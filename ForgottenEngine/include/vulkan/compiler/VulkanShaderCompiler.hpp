@@ -6,7 +6,9 @@
 #include "vulkan/VulkanShaderResource.hpp"
 #include "vulkan/VulkanShaderUtils.hpp"
 
+#include <array>
 #include <filesystem>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -32,11 +34,23 @@ namespace ForgottenEngine {
 
 		static Reference<VulkanShader> compile(
 			const std::filesystem::path& shader_source_path, bool forceCompile = false, bool disableOptimization = false);
+		/// Compiles every shader with its stages pre-processed and compiled in parallel on the engine thread pool.
+		/// Reflection and shader creation stay on the calling thread in the given order, so the result is the same as
+		/// compiling one by one. Not for use from a worker of the pool.
+		static std::vector<Reference<VulkanShader>> compile(
+			std::span<const std::filesystem::path> shader_source_paths, bool forceCompile = false, bool disableOptimization = false);
 		static bool try_recompile(Reference<VulkanShader> shader);
 
 	private:
-		std::unordered_map<VkShaderStageFlagBits, std::string> pre_process(const std::string& source);
-		std::unordered_map<VkShaderStageFlagBits, std::string> pre_process_glsl(const std::string& source);
+		// reload() in steps. Between begin_reload and end_pre_process, and between end_pre_process and end_reload,
+		// different stages may be worked on from different threads at once.
+		void begin_reload(bool force_compile);
+		void pre_process_stage(VkShaderStageFlagBits stage);
+		void end_pre_process();
+		bool compile_stage(VkShaderStageFlagBits stage, bool debug);
+		bool end_reload(bool compile_success);
+
+		static Reference<VulkanShader> create_shader(const Reference<VulkanShaderCompiler>& compiler);
 
 		struct CompilationOptions {
 			bool GenerateDebugInfo = false;
@@ -45,10 +59,6 @@ namespace ForgottenEngine {
 
 		std::string compile(std::vector<uint32_t>& output_binary, const VkShaderStageFlagBits stage, CompilationOptions options) const;
 
-		bool compile_or_get_vulkan_binaries(std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputDebugBinary,
-			std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, const VkShaderStageFlagBits changedStages,
-			const bool force_compile);
-
 		bool compile_or_get_vulkan_binary(
 			VkShaderStageFlagBits stage, std::vector<uint32_t>& outputBinary, bool debug, VkShaderStageFlagBits changedStages, bool forceCompile);
 
@@ -79,6 +89,18 @@ namespace ForgottenEngine {
 
 		std::unordered_set<std::string> acknowledged_macros;
 
+		struct StageTimings {
+			float pre_process_ms = 0.0f;
+			std::array<float, 2> binary_ms {}; // Release, debug.
+			std::array<bool, 2> from_cache {};
+		};
+
+		// Per stage so that stages can be worked on in parallel; the entries exist before that starts.
+		std::unordered_map<VkShaderStageFlagBits, std::unordered_set<std::string>> stage_macros;
+		std::unordered_map<VkShaderStageFlagBits, StageTimings> stage_timings;
+		VkShaderStageFlagBits changed_stages = {};
+		bool force_compile = false;
+
 		ShaderUtils::SourceLang language;
 
 		friend class VulkanShader;
@@ -5,6 +5,7 @@
 #include "Assets.hpp"
 #include "Clock.hpp"
 #include "Input.hpp"
+#include "ThreadPool.hpp"
 #include "render/Font.hpp"
 #include "render/Renderer.hpp"
 
@@ -15,12 +16,16 @@ namespace ForgottenEngine {
 	Application* Application::instance = nullptr;
 
 	Application::Application(const ApplicationProperties& props)
+		: render_thread(props.renderer_config.threading_policy, props.renderer_config.sync_policy)
 	{
 		if (instance) {
 			CORE_ERROR("Application already exists.");
 		}
 		instance = this;
 
+		// The swapchain reads frames_in_flight while the window is created.
+		Renderer::get_config() = props.renderer_config;
+
 		window = std::unique_ptr<Window>(Window::create(props));
 		window->init();
 		CORE_INFO("Initialized window.");
@@ -29,11 +34,17 @@ namespace ForgottenEngine {
 		Assets::init();
 		CORE_INFO("Initialized assets.");
 
+		ThreadPool::init();
+
+		render_thread.run();
+
 		Renderer::init();
 		CORE_INFO("Initialized renderer.");
 		Renderer::wait_and_render();
 
 		add_overlay(std::make_unique<ImGuiLayer>());
+		// The first frame starts an ImGui frame on the main thread, so the backends must be up by then.
+		Renderer::wait_and_render();
 
 		Font::init();
 		CORE_INFO("Initialized fonts.");
@@ -49,7 +60,10 @@ namespace ForgottenEngine {
 		Font::shutdown();
 
 		Renderer::wait_and_render();
+		render_thread.terminate();
 		Renderer::shut_down();
+
+		ThreadPool::shutdown();
 	};
 
 	void Application::run()
@@ -61,26 +75,33 @@ namespace ForgottenEngine {
 
 			process_events();
 
+			if (render_thread.is_multi_threaded()) {
+				// Acquiring the image waits on the frame's fence; keep that off the main thread.
+				Renderer::submit([app = this]() { app->window->get_swapchain().begin_frame(); });
+			}
+
 			Renderer::begin_frame();
 			{
 				for (const auto& layer : stack)
 					layer->on_update(time_step);
-			} // Render ImGui on render thread
+			}
 
 			auto time = Clock::get_time<float>();
-			Application* app = this;
 			{
-				Renderer::submit([app, ts = time_step]() {
-					ImGuiLayer::begin();
-					app->render_imgui(ts);
-				});
-
-				Renderer::submit([] { ImGuiLayer::end(); });
+				// Built here, alongside on_update; only the finished draw data goes to the render thread.
+				ImGuiLayer::begin();
+				render_imgui(time_step);
+				ImGuiLayer::end();
 			}
 			Renderer::end_frame();
-			window->get_swapchain().begin_frame();
-			Renderer::wait_and_render();
-			window->swap_buffers();
+			if (render_thread.is_multi_threaded()) {
+				Renderer::submit([app = this]() { app->window->swap_buffers(); });
+				render_thread.kick();
+			} else {
+				window->get_swapchain().begin_frame();
+				render_thread.kick();
+				window->swap_buffers();
+			}
 			frame_time = TimeStep(time - last_frame_time);
 			time_step = TimeStep(glm::min<float>(frame_time, 0.0333f));
 			last_frame_time = time;
@@ -106,7 +127,12 @@ namespace ForgottenEngine {
 
 			const auto&& [w, h] = e.get_size();
 
-			window->get_swapchain().on_resize(w, h);
+			if (render_thread.is_multi_threaded()) {
+				// The render thread owns the swapchain while it executes a frame.
+				Renderer::submit([app = this, w = w, h = h]() { app->window->get_swapchain().on_resize(w, h); });
+			} else {
+				window->get_swapchain().on_resize(w, h);
+			}
 			return false;
 		});
 
@@ -0,0 +1,514 @@
+#include "fg_pch.hpp"
+
+#include "HeapProfiler.hpp"
+#include "utilities/SpinLock.hpp"
+
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef FORGOTTEN_WINDOWS
+#include <windows.h>
+#else
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+namespace ForgottenEngine {
+
+	namespace {
+
+		// The hooks run inside operator new/delete: everything reachable from them uses malloc/free only
+		// and never allocates while the lock is held.
+
+		constexpr uint32_t max_frames = 64;
+		constexpr size_t stack_capacity = 4096;
+		constexpr size_t sample_capacity = 1 << 16;
+		constexpr size_t sample_tombstone_limit = sample_capacity / 8;
+		constexpr size_t filter_bucket_count = 1 << 12;
+
+		void* const tombstone = reinterpret_cast<void*>(uintptr_t { 1 });
+
+		struct StackRecord {
+			uint64_t hash = 0;
+			uint32_t depth = 0;
+			void* frames[max_frames];
+
+			uint64_t live_samples = 0;
+			uint64_t live_sampled_bytes = 0;
+			uint64_t total_samples = 0;
+			uint64_t total_sampled_bytes = 0;
+			double live_estimate = 0.0;
+			double total_estimate = 0.0;
+		};
+
+		struct SampledAllocation {
+			void* memory = nullptr;
+			uint32_t stack = 0;
+			uint64_t size = 0;
+			double estimate = 0.0;
+		};
+
+		struct ProfilerState {
+			SpinLock lock;
+
+			StackRecord* stacks = nullptr;
+			size_t stack_count = 0;
+
+			SampledAllocation* samples = nullptr;
+			size_t samples_live = 0;
+			size_t samples_tombstones = 0;
+
+			uint32_t max_stack_depth = 32;
+			size_t interval = 0;
+
+			HeapProfilerStats stats;
+			double estimated_live = 0.0;
+			double estimated_total = 0.0;
+		};
+
+		ProfilerState state;
+
+		// Zero means sampling is off; the allocation hook returns after this single load.
+		std::atomic<size_t> sample_interval { 0 };
+		// Lets frees skip the lock unless some sampled block could hash to the same bucket.
+		std::atomic<uint64_t> live_sample_count { 0 };
+		std::atomic<uint16_t> sample_filter[filter_bucket_count];
+
+		thread_local int64_t bytes_until_sample = 0;
+		thread_local bool countdown_initialised = false;
+		thread_local uint64_t random_state = 0;
+		thread_local bool inside_profiler = false;
+
+		inline uint64_t hash_pointer(const void* memory)
+		{
+			auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(memory));
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53ULL;
+			key ^= key >> 33;
+			return key;
+		}
+
+		uint64_t hash_frames(void* const* frames, uint32_t depth)
+		{
+			uint64_t hash = 14695981039346656037ULL;
+			for (uint32_t i = 0; i < depth; i++) {
+				hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]));
+				hash *= 1099511628211ULL;
+			}
+			return hash ? hash : 1;
+		}
+
+		int64_t next_sample_interval(size_t mean)
+		{
+			if (random_state == 0)
+				random_state = hash_pointer(&random_state) | 1;
+
+			// xorshift64*, then an exponentially distributed interval with the requested mean.
+			random_state ^= random_state >> 12;
+			random_state ^= random_state << 25;
+			random_state ^= random_state >> 27;
+			const uint64_t bits = random_state * 2685821657736338717ULL;
+
+			const double uniform = static_cast<double>((bits >> 11) + 1) * (1.0 / 9007199254740992.0);
+			const double interval = -std::log(uniform) * static_cast<double>(mean);
+			return std::max<int64_t>(1, static_cast<int64_t>(interval));
+		}
+
+		uint32_t capture_stack(void** frames, uint32_t depth)
+		{
+#ifdef FORGOTTEN_WINDOWS
+			return CaptureStackBackTrace(1, depth, frames, nullptr);
+#else
+			void* captured[max_frames + 1];
+			const int count = backtrace(captured, static_cast<int>(depth + 1));
+			// Drop our own frame; the allocation hook and operator new stay as the leaf of every stack.
+			const uint32_t skipped = count > 0 ? 1 : 0;
+			const uint32_t kept = static_cast<uint32_t>(count) - skipped;
+			std::memcpy(frames, captured + skipped, kept * sizeof(void*));
+			return kept;
+#endif
+		}
+
+		/// Finds or inserts the stack, returns stack_capacity when the table is full. Lock must be held.
+		size_t find_or_add_stack(void* const* frames, uint32_t depth, uint64_t hash)
+		{
+			size_t index = hash & (stack_capacity - 1);
+			for (size_t probe = 0; probe < stack_capacity; probe++) {
+				StackRecord& record = state.stacks[index];
+				if (record.hash == 0) {
+					if ((state.stack_count + 1) * 4 > stack_capacity * 3)
+						return stack_capacity;
+
+					record.hash = hash;
+					record.depth = depth;
+					std::memcpy(record.frames, frames, depth * sizeof(void*));
+					state.stack_count++;
+					return index;
+				}
+				if (record.hash == hash && record.depth == depth && std::memcmp(record.frames, frames, depth * sizeof(void*)) == 0)
+					return index;
+				index = (index + 1) & (stack_capacity - 1);
+			}
+			return stack_capacity;
+		}
+
+		/// Lock must be held. Drops the tombstones in place, without allocating: each live entry is taken out and probed for
+		/// again from its home slot. Walking from a slot that was empty before, every entry lands at or before where it was,
+		/// so it never displaces one that has not been moved yet.
+		void rehash_samples()
+		{
+			size_t start = 0;
+			while (state.samples[start].memory != nullptr)
+				start++;
+
+			for (size_t i = 0; i < sample_capacity; i++) {
+				if (state.samples[i].memory == tombstone)
+					state.samples[i] = {};
+			}
+			state.samples_tombstones = 0;
+
+			for (size_t offset = 1; offset < sample_capacity; offset++) {
+				const size_t position = (start + offset) & (sample_capacity - 1);
+				if (state.samples[position].memory == nullptr)
+					continue;
+
+				const SampledAllocation sample = state.samples[position];
+				state.samples[position] = {};
+
+				size_t index = hash_pointer(sample.memory) & (sample_capacity - 1);
+				while (state.samples[index].memory != nullptr)
+					index = (index + 1) & (sample_capacity - 1);
+				state.samples[index] = sample;
+			}
+		}
+
+		/// Lock must be held.
+		bool add_sample(const SampledAllocation& sample)
+		{
+			if ((state.samples_live + 1) * 4 > sample_capacity * 3)
+				return false;
+			if (state.samples_tombstones > sample_tombstone_limit
+				|| (state.samples_live + state.samples_tombstones + 1) * 4 > sample_capacity * 3)
+				rehash_samples();
+
+			SampledAllocation* reusable = nullptr;
+			size_t index = hash_pointer(sample.memory) & (sample_capacity - 1);
+			for (;;) {
+				SampledAllocation& slot = state.samples[index];
+				if (slot.memory == nullptr)
+					break;
+				if (slot.memory == tombstone && !reusable)
+					reusable = &slot;
+				index = (index + 1) & (sample_capacity - 1);
+			}
+
+			if (reusable) {
+				*reusable = sample;
+				state.samples_tombstones--;
+			} else {
+				state.samples[index] = sample;
+			}
+			state.samples_live++;
+			return true;
+		}
+
+		/// Lock must be held.
+		bool remove_sample(const void* memory, SampledAllocation& out)
+		{
+			size_t index = hash_pointer(memory) & (sample_capacity - 1);
+			for (;;) {
+				SampledAllocation& slot = state.samples[index];
+				if (slot.memory == nullptr)
+					return false;
+				if (slot.memory == memory) {
+					out = slot;
+					slot.memory = tombstone;
+					state.samples_live--;
+					state.samples_tombstones++;
+					return true;
+				}
+				index = (index + 1) & (sample_capacity - 1);
+			}
+		}
+
+		void clear_locked()
+		{
+			std::memset(static_cast<void*>(state.stacks), 0, stack_capacity * sizeof(StackRecord));
+			std::memset(static_cast<void*>(state.samples), 0, sample_capacity * sizeof(SampledAllocation));
+			state.stack_count = 0;
+			state.samples_live = 0;
+			state.samples_tombstones = 0;
+			state.stats = {};
+			state.estimated_live = 0.0;
+			state.estimated_total = 0.0;
+
+			for (auto& bucket : sample_filter)
+				bucket.store(0, std::memory_order_relaxed);
+			live_sample_count.store(0, std::memory_order_relaxed);
+		}
+
+		std::vector<StackRecord> snapshot_stacks()
+		{
+			// Allocated before taking the lock: a free under the lock would re-enter on_free.
+			std::vector<StackRecord> snapshot(stack_capacity);
+
+			state.lock.lock();
+			size_t count = 0;
+			if (state.stacks) {
+				for (size_t i = 0; i < stack_capacity; i++) {
+					if (state.stacks[i].hash != 0)
+						std::memcpy(static_cast<void*>(&snapshot[count++]), &state.stacks[i], sizeof(StackRecord));
+				}
+			}
+			state.lock.unlock();
+
+			snapshot.resize(count);
+			return snapshot;
+		}
+
+		std::string symbolise(void* address)
+		{
+#ifndef FORGOTTEN_WINDOWS
+			Dl_info info;
+			if (dladdr(address, &info) && info.dli_sname) {
+				int status = 0;
+				char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+				std::string name = (status == 0 && demangled) ? demangled : info.dli_sname;
+				std::free(demangled);
+
+				// ';' separates frames in the collapsed format.
+				std::replace(name.begin(), name.end(), ';', ':');
+				return name;
+			}
+#endif
+			char buffer[2 + 16 + 1];
+			std::snprintf(buffer, sizeof(buffer), "0x%" PRIxPTR, reinterpret_cast<uintptr_t>(address));
+			return buffer;
+		}
+
+	} // namespace
+
+	void HeapProfiler::start(const HeapProfilerSpecification& specification)
+	{
+		auto* stacks = static_cast<StackRecord*>(std::calloc(stack_capacity, sizeof(StackRecord)));
+		auto* samples = static_cast<SampledAllocation*>(std::calloc(sample_capacity, sizeof(SampledAllocation)));
+
+		state.lock.lock();
+		if (!state.stacks) {
+			state.stacks = std::exchange(stacks, nullptr);
+			state.samples = std::exchange(samples, nullptr);
+		}
+		state.max_stack_depth = std::clamp<uint32_t>(specification.max_stack_depth, 1, max_frames);
+		state.interval = std::max<size_t>(1, specification.sample_interval);
+		state.lock.unlock();
+
+		std::free(stacks);
+		std::free(samples);
+
+		if (!state.stacks || !state.samples) {
+			CORE_ERROR("HeapProfiler: could not allocate sample tables.");
+			return;
+		}
+
+		sample_interval.store(state.interval, std::memory_order_release);
+		CORE_INFO("HeapProfiler: sampling every {} bytes on average.", state.interval);
+	}
+
+	void HeapProfiler::stop() { sample_interval.store(0, std::memory_order_release); }
+
+	bool HeapProfiler::is_running() { return sample_interval.load(std::memory_order_relaxed) != 0; }
+
+	void HeapProfiler::reset()
+	{
+		state.lock.lock();
+		if (state.stacks)
+			clear_locked();
+		state.lock.unlock();
+	}
+
+	HeapProfilerStats HeapProfiler::get_stats()
+	{
+		state.lock.lock();
+		HeapProfilerStats stats = state.stats;
+		stats.unique_stacks = state.stack_count;
+		stats.estimated_live_bytes = static_cast<uint64_t>(std::max(0.0, state.estimated_live));
+		stats.estimated_total_bytes = static_cast<uint64_t>(state.estimated_total);
+		state.lock.unlock();
+		return stats;
+	}
+
+	void HeapProfiler::on_allocation(void* memory, size_t size)
+	{
+		const size_t interval = sample_interval.load(std::memory_order_relaxed);
+		if (interval == 0 || memory == nullptr || inside_profiler)
+			return;
+
+		bytes_until_sample -= static_cast<int64_t>(size);
+		if (bytes_until_sample > 0)
+			return;
+
+		inside_profiler = true;
+
+		const bool first_allocation = !countdown_initialised;
+		countdown_initialised = true;
+		bytes_until_sample = next_sample_interval(interval);
+		if (first_allocation) {
+			inside_profiler = false;
+			return;
+		}
+
+		void* frames[max_frames];
+		const uint32_t depth = capture_stack(frames, state.max_stack_depth);
+		const uint64_t hash = hash_frames(frames, depth);
+
+		// Every sample stands for size / P(sampled) bytes, with P = 1 - e^(-size / interval).
+		const double sampled_size = static_cast<double>(size ? size : 1);
+		const double estimate = sampled_size / (1.0 - std::exp(-sampled_size / static_cast<double>(interval)));
+
+		state.lock.lock();
+		const size_t stack = find_or_add_stack(frames, depth, hash);
+		if (stack == stack_capacity) {
+			state.stats.dropped_samples++;
+		} else {
+			StackRecord& record = state.stacks[stack];
+			record.total_samples++;
+			record.total_sampled_bytes += size;
+			record.total_estimate += estimate;
+			state.stats.total_samples++;
+			state.estimated_total += estimate;
+
+			if (add_sample({ memory, static_cast<uint32_t>(stack), size, estimate })) {
+				record.live_samples++;
+				record.live_sampled_bytes += size;
+				record.live_estimate += estimate;
+				state.stats.live_samples++;
+				state.estimated_live += estimate;
+
+				sample_filter[hash_pointer(memory) & (filter_bucket_count - 1)].fetch_add(1, std::memory_order_relaxed);
+				live_sample_count.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				state.stats.dropped_samples++;
+			}
+		}
+		state.lock.unlock();
+
+		inside_profiler = false;
+	}
+
+	void HeapProfiler::on_free(void* memory)
+	{
+		if (live_sample_count.load(std::memory_order_relaxed) == 0 || memory == nullptr)
+			return;
+
+		auto& bucket = sample_filter[hash_pointer(memory) & (filter_bucket_count - 1)];
+		if (bucket.load(std::memory_order_relaxed) == 0)
+			return;
+
+		state.lock.lock();
+		SampledAllocation sample;
+		if (state.samples && remove_sample(memory, sample)) {
+			StackRecord& record = state.stacks[sample.stack];
+			record.live_samples--;
+			record.live_sampled_bytes -= sample.size;
+			record.live_estimate -= sample.estimate;
+			state.stats.live_samples--;
+			state.estimated_live -= sample.estimate;
+
+			bucket.fetch_sub(1, std::memory_order_relaxed);
+			live_sample_count.fetch_sub(1, std::memory_order_relaxed);
+		}
+		state.lock.unlock();
+	}
+
+	bool HeapProfiler::write_collapsed_stacks(const std::filesystem::path& path, HeapProfileValue value)
+	{
+		const auto stacks = snapshot_stacks();
+
+		std::ofstream stream(path, std::ios::out | std::ios::trunc);
+		if (!stream) {
+			CORE_ERROR("HeapProfiler: could not open {} for writing.", path.string());
+			return false;
+		}
+
+		std::unordered_map<void*, std::string> symbols;
+		for (const auto& record : stacks) {
+			const double bytes = value == HeapProfileValue::LiveBytes ? record.live_estimate : record.total_estimate;
+			if (bytes < 0.5)
+				continue;
+
+			for (uint32_t i = record.depth; i > 0; i--) {
+				void* frame = record.frames[i - 1];
+				auto it = symbols.find(frame);
+				if (it == symbols.end())
+					it = symbols.emplace(frame, symbolise(frame)).first;
+
+				stream << it->second;
+				if (i > 1)
+					stream << ';';
+			}
+			stream << ' ' << static_cast<uint64_t>(bytes + 0.5) << '\n';
+		}
+
+		return static_cast<bool>(stream);
+	}
+
+	bool HeapProfiler::write_pprof(const std::filesystem::path& path)
+	{
+		const auto stacks = snapshot_stacks();
+
+		std::ofstream stream(path, std::ios::out | std::ios::trunc);
+		if (!stream) {
+			CORE_ERROR("HeapProfiler: could not open {} for writing.", path.string());
+			return false;
+		}
+
+		uint64_t live_samples = 0, live_bytes = 0, total_samples = 0, total_bytes = 0;
+		for (const auto& record : stacks) {
+			live_samples += record.live_samples;
+			live_bytes += record.live_sampled_bytes;
+			total_samples += record.total_samples;
+			total_bytes += record.total_sampled_bytes;
+		}
+
+		// heap_v2 carries raw sample counts; pprof applies the same unsampling as get_stats() does.
+		char line[128];
+		std::snprintf(line, sizeof(line), "heap profile: %6" PRIu64 ": %8" PRIu64 " [%6" PRIu64 ": %8" PRIu64 "] @ heap_v2/%zu\n", live_samples,
+			live_bytes, total_samples, total_bytes, state.interval);
+		stream << line;
+
+		for (const auto& record : stacks) {
+			std::snprintf(line, sizeof(line), "%6" PRIu64 ": %8" PRIu64 " [%6" PRIu64 ": %8" PRIu64 "] @", record.live_samples,
+				record.live_sampled_bytes, record.total_samples, record.total_sampled_bytes);
+			stream << line;
+
+			for (uint32_t i = 0; i < record.depth; i++) {
+				std::snprintf(line, sizeof(line), " 0x%" PRIxPTR, reinterpret_cast<uintptr_t>(record.frames[i]));
+				stream << line;
+			}
+			stream << '\n';
+		}
+
+#if defined(FORGOTTEN_LINUX) || defined(__linux__)
+		// pprof needs the load addresses to symbolise.
+		std::ifstream maps("/proc/self/maps");
+		if (maps) {
+			stream << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+		}
+#endif
+
+		return static_cast<bool>(stream);
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,77 @@
+#include "fg_pch.hpp"
+
+#include "LinearAllocator.hpp"
+
+namespace ForgottenEngine {
+
+	LinearAllocator::LinearAllocator(size_t initial_capacity)
+	{
+		first = current = allocate_block(initial_capacity);
+		capacity = initial_capacity;
+	}
+
+	LinearAllocator::~LinearAllocator() { release_blocks(); }
+
+	void* LinearAllocator::allocate(size_t size, size_t alignment)
+	{
+		core_assert((alignment & (alignment - 1)) == 0, "Alignment must be a power of two, got {}", alignment);
+
+		for (;;) {
+			auto* data = reinterpret_cast<uint8_t*>(current) + block_header_size;
+			const auto address = reinterpret_cast<uintptr_t>(data + current->offset);
+			const size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+
+			if (current->offset + padding + size <= current->size) {
+				current->offset += padding + size;
+				used += padding + size;
+				peak = std::max(peak, used);
+				return data + current->offset - size;
+			}
+
+			if (current->next) {
+				current = current->next;
+				continue;
+			}
+
+			// Overflow: chain a block big enough for this request and at least as big as everything so far.
+			const size_t block_size = std::max(current->size * 2, size + alignment);
+			current->next = allocate_block(block_size);
+			current = current->next;
+			capacity += block_size;
+		}
+	}
+
+	void LinearAllocator::reset()
+	{
+		if (first->next) {
+			const size_t high_water = std::max(peak, capacity);
+			release_blocks();
+			first = allocate_block(high_water);
+			capacity = high_water;
+		}
+
+		first->offset = 0;
+		current = first;
+		used = 0;
+	}
+
+	LinearAllocator::Block* LinearAllocator::allocate_block(size_t size)
+	{
+		auto* block = reinterpret_cast<Block*>(hnew uint8_t[block_header_size + size]);
+		block->next = nullptr;
+		block->size = size;
+		block->offset = 0;
+		return block;
+	}
+
+	void LinearAllocator::release_blocks()
+	{
+		for (Block* block = first; block;) {
+			Block* next = block->next;
+			delete[] reinterpret_cast<uint8_t*>(block);
+			block = next;
+		}
+		first = current = nullptr;
+	}
+
+} // namespace ForgottenEngine
@@ -1,122 +1,356 @@
 #include "fg_pch.hpp"
 
-#include "Memory.h"
+#include "HeapProfiler.hpp"
+#include "Memory.hpp"
+#include "utilities/SpinLock.hpp"
 
-#include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
 #include <map>
-#include <memory>
 #include <mutex>
-#include <unordered_map>
 
 namespace ForgottenEngine {
 
-	static ForgottenEngine::AllocationStats global_stats;
+	namespace {
 
-	static bool global_is_in_init = false;
+		// Everything in here is reachable from operator new, so it may only use malloc/free and must be
+		// constant-initialised (allocations happen before any dynamic initialiser has run).
 
-	void Allocator::init()
-	{
-		if (allocator_data)
-			return;
+		constexpr size_t shard_count = 64;
+		constexpr size_t initial_shard_capacity = 256;
+		constexpr size_t thread_category_capacity = 256;
 
-		global_is_in_init = true;
-		AllocatorData* data = (AllocatorData*)Allocator::allocate_raw(sizeof(AllocatorData));
-		new (data) AllocatorData();
-		allocator_data = data;
-		global_is_in_init = false;
-	}
+		void* const tombstone = reinterpret_cast<void*>(uintptr_t { 1 });
 
-	void* Allocator::allocate_raw(size_t size) { return malloc(size); }
+		inline size_t hash_address(const void* memory)
+		{
+			auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(memory));
+			key ^= key >> 33;
+			key *= 0xff51afd7ed558ccdULL;
+			key ^= key >> 33;
+			key *= 0xc4ceb9fe1a85ec53ULL;
+			key ^= key >> 33;
+			return static_cast<size_t>(key);
+		}
 
-	void* Allocator::allocate(size_t size)
-	{
-		if (global_is_in_init)
-			return allocate_raw(size);
+		/// One slice of the live-allocation table. Linear probing, power-of-two capacity, tombstones on erase.
+		struct alignas(64) AllocationShard {
+			SpinLock lock;
+			Allocation* slots = nullptr;
+			size_t capacity = 0;
+			size_t used = 0; // live entries + tombstones
+			size_t live = 0;
+
+			void rehash(size_t new_capacity)
+			{
+				auto* new_slots = static_cast<Allocation*>(std::calloc(new_capacity, sizeof(Allocation)));
+				if (!new_slots)
+					return;
+
+				for (size_t i = 0; i < capacity; i++) {
+					const Allocation& slot = slots[i];
+					if (slot.Memory == nullptr || slot.Memory == tombstone)
+						continue;
+
+					size_t index = hash_address(slot.Memory) & (new_capacity - 1);
+					while (new_slots[index].Memory != nullptr)
+						index = (index + 1) & (new_capacity - 1);
+					new_slots[index] = slot;
+				}
+
+				std::free(slots);
+				slots = new_slots;
+				capacity = new_capacity;
+				used = live;
+			}
 
-		if (!allocator_data)
-			init();
+			void insert(const Allocation& allocation, size_t hash)
+			{
+				if ((used + 1) * 4 > capacity * 3) {
+					// When the table is mostly tombstones, rehash in place instead of growing.
+					const bool grow = (live + 1) * 2 > capacity;
+					rehash(capacity == 0 ? initial_shard_capacity : (grow ? capacity * 2 : capacity));
+				}
+				if (used + 1 > capacity)
+					return;
+
+				Allocation* reusable = nullptr;
+				size_t index = hash & (capacity - 1);
+				for (;;) {
+					Allocation& slot = slots[index];
+					if (slot.Memory == allocation.Memory) {
+						// A stale entry for a block that was released behind our back.
+						slot = allocation;
+						return;
+					}
+					if (slot.Memory == tombstone && !reusable)
+						reusable = &slot;
+					if (slot.Memory == nullptr)
+						break;
+					index = (index + 1) & (capacity - 1);
+				}
+
+				if (reusable) {
+					*reusable = allocation;
+				} else {
+					slots[index] = allocation;
+					used++;
+				}
+				live++;
+			}
 
-		void* memory = malloc(size);
+			bool erase(const void* memory, size_t hash, Allocation& out)
+			{
+				if (capacity == 0)
+					return false;
+
+				size_t index = hash & (capacity - 1);
+				for (;;) {
+					Allocation& slot = slots[index];
+					if (slot.Memory == nullptr)
+						return false;
+					if (slot.Memory == memory) {
+						out = slot;
+						slot.Memory = tombstone;
+						live--;
+						return true;
+					}
+					index = (index + 1) & (capacity - 1);
+				}
+			}
+		};
+
+		AllocationShard allocation_shards[shard_count];
+
+		inline AllocationShard& shard_for(size_t hash) { return allocation_shards[(hash >> 58) & (shard_count - 1)]; }
+
+		struct CategoryCounter {
+			std::atomic<const char*> category { nullptr };
+			std::atomic<size_t> allocated { 0 };
+			std::atomic<size_t> freed { 0 };
+		};
+
+		/// Counters owned by one thread. Only the owner writes them (relaxed load + store, no RMW), readers merge.
+		/// Blocks are never freed; a block whose thread has exited is handed to the next new thread.
+		struct ThreadAllocationStats {
+			std::atomic<size_t> total_allocated { 0 };
+			std::atomic<size_t> total_freed { 0 };
+			std::atomic<size_t> allocation_count { 0 };
+			std::atomic<size_t> free_count { 0 };
+			CategoryCounter categories[thread_category_capacity];
+
+			std::atomic<bool> in_use { true };
+			ThreadAllocationStats* next = nullptr;
+		};
+
+		std::atomic<ThreadAllocationStats*> thread_stats_head { nullptr };
+
+		// Shared fallback for allocations made while a thread is tearing down.
+		std::atomic<size_t> overflow_allocated { 0 };
+		std::atomic<size_t> overflow_freed { 0 };
+		std::atomic<size_t> overflow_allocation_count { 0 };
+		std::atomic<size_t> overflow_free_count { 0 };
+
+		thread_local ThreadAllocationStats* current_thread_stats = nullptr;
+		thread_local bool thread_stats_retired = false;
+
+		struct ThreadStatsOwner {
+			~ThreadStatsOwner()
+			{
+				if (current_thread_stats)
+					current_thread_stats->in_use.store(false, std::memory_order_release);
+				current_thread_stats = nullptr;
+				thread_stats_retired = true;
+			}
+		};
 
+		ThreadAllocationStats* acquire_thread_stats()
 		{
-			std::scoped_lock<std::mutex> lock(allocator_data->mutex);
-			Allocation& alloc = allocator_data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
+			for (auto* it = thread_stats_head.load(std::memory_order_acquire); it; it = it->next) {
+				bool expected = false;
+				if (!it->in_use.load(std::memory_order_relaxed) && it->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+					return it;
+			}
 
-			global_stats.TotalAllocated += size;
-		}
+			void* storage = std::malloc(sizeof(ThreadAllocationStats));
+			if (!storage)
+				return nullptr;
 
-		return memory;
-	}
+			auto* stats = new (storage) ThreadAllocationStats();
+			stats->next = thread_stats_head.load(std::memory_order_relaxed);
+			while (!thread_stats_head.compare_exchange_weak(stats->next, stats, std::memory_order_release, std::memory_order_relaxed)) { }
+			return stats;
+		}
 
-	void* Allocator::allocate(size_t size, const char* desc)
-	{
-		if (!allocator_data)
-			init();
+		inline ThreadAllocationStats* thread_stats()
+		{
+			if (current_thread_stats || thread_stats_retired)
+				return current_thread_stats;
+
+			current_thread_stats = acquire_thread_stats();
+			// Registers the exit hook; glibc and libc++abi use malloc for this, so it does not recurse.
+			thread_local ThreadStatsOwner owner;
+			(void)owner;
+			return current_thread_stats;
+		}
 
-		void* memory = malloc(size);
+		inline void bump(std::atomic<size_t>& counter, size_t amount)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+		}
 
+		CategoryCounter* find_category(ThreadAllocationStats& stats, const char* category)
 		{
-			std::scoped_lock<std::mutex> lock(allocator_data->mutex);
-			Allocation& alloc = allocator_data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
-			alloc.Category = desc;
-
-			global_stats.TotalAllocated += size;
-			if (desc)
-				allocator_data->allocation_stats_map[desc].TotalAllocated += size;
+			size_t index = (reinterpret_cast<uintptr_t>(category) >> 3) & (thread_category_capacity - 1);
+			for (size_t probe = 0; probe < thread_category_capacity; probe++) {
+				CategoryCounter& counter = stats.categories[index];
+				const char* current = counter.category.load(std::memory_order_relaxed);
+				if (current == category)
+					return &counter;
+				if (current == nullptr) {
+					counter.category.store(category, std::memory_order_release);
+					return &counter;
+				}
+				index = (index + 1) & (thread_category_capacity - 1);
+			}
+			return nullptr;
 		}
 
-		return memory;
-	}
+		void record_allocation(size_t size, const char* category)
+		{
+			ThreadAllocationStats* stats = thread_stats();
+			if (!stats) {
+				overflow_allocated.fetch_add(size, std::memory_order_relaxed);
+				overflow_allocation_count.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
 
-	void* Allocator::allocate(size_t size, const char* file, int line)
-	{
-		if (!allocator_data)
-			init();
+			bump(stats->total_allocated, size);
+			bump(stats->allocation_count, 1);
+			if (category) {
+				if (CategoryCounter* counter = find_category(*stats, category))
+					bump(counter->allocated, size);
+			}
+		}
+
+		void record_free(size_t size, const char* category)
+		{
+			ThreadAllocationStats* stats = thread_stats();
+			if (!stats) {
+				overflow_freed.fetch_add(size, std::memory_order_relaxed);
+				overflow_free_count.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
 
-		void* memory = malloc(size);
+			bump(stats->total_freed, size);
+			bump(stats->free_count, 1);
+			if (category) {
+				if (CategoryCounter* counter = find_category(*stats, category))
+					bump(counter->freed, size);
+			}
+		}
 
+		void* track(void* memory, size_t size, const char* category)
 		{
-			std::scoped_lock<std::mutex> lock(allocator_data->mutex);
-			Allocation& alloc = allocator_data->m_AllocationMap[memory];
-			alloc.Memory = memory;
-			alloc.Size = size;
-			alloc.Category = file;
-
-			global_stats.TotalAllocated += size;
-			allocator_data->allocation_stats_map[file].TotalAllocated += size;
+			if (!memory)
+				return nullptr;
+
+			const size_t hash = hash_address(memory);
+			AllocationShard& shard = shard_for(hash);
+			shard.lock.lock();
+			shard.insert(Allocation { memory, size, category }, hash);
+			shard.lock.unlock();
+
+			record_allocation(size, category);
+			HeapProfiler::on_allocation(memory, size);
+			return memory;
 		}
 
-		return memory;
+	} // namespace
+
+	void Allocator::init()
+	{
+		// AllocatorData does not allocate on construction, so a function-local static is safe to create from operator new.
+		static AllocatorData data;
+		allocator_data = &data;
 	}
 
+	void* Allocator::allocate_raw(size_t size) { return std::malloc(size); }
+
+	void* Allocator::allocate(size_t size) { return track(std::malloc(size), size, nullptr); }
+
+	void* Allocator::allocate(size_t size, const char* desc) { return track(std::malloc(size), size, desc); }
+
+	void* Allocator::allocate(size_t size, const char* file, int line) { return track(std::malloc(size), size, file); }
+
 	void Allocator::free(void* memory)
 	{
 		if (memory == nullptr)
 			return;
 
-		{
-			std::scoped_lock<std::mutex> lock(allocator_data->mutex);
-			if (allocator_data->m_AllocationMap.find(memory) != allocator_data->m_AllocationMap.end()) {
-				const Allocation& alloc = allocator_data->m_AllocationMap.at(memory);
-				global_stats.TotalFreed += alloc.Size;
-				if (alloc.Category)
-					allocator_data->allocation_stats_map[alloc.Category].TotalFreed += alloc.Size;
-
-				allocator_data->m_AllocationMap.erase(memory);
-			} else {
-				CORE_WARN("Memory block {0} not present in alloc map", memory);
+		const size_t hash = hash_address(memory);
+		AllocationShard& shard = shard_for(hash);
+
+		Allocation alloc;
+		shard.lock.lock();
+		const bool tracked = shard.erase(memory, hash, alloc);
+		shard.lock.unlock();
+
+		// Untracked blocks come from allocate_raw or from before the tracker could see them; they are simply released.
+		if (tracked)
+			record_free(alloc.Size, alloc.Category);
+
+		HeapProfiler::on_free(memory);
+		std::free(memory);
+	}
+
+	AllocationStats Allocator::merge_thread_stats(bool include_categories)
+	{
+		init();
+
+		std::scoped_lock<std::mutex> lock(allocator_data->stats_mutex);
+
+		AllocationStats totals;
+		totals.TotalAllocated = overflow_allocated.load(std::memory_order_relaxed);
+		totals.TotalFreed = overflow_freed.load(std::memory_order_relaxed);
+		totals.AllocationCount = overflow_allocation_count.load(std::memory_order_relaxed);
+		totals.FreeCount = overflow_free_count.load(std::memory_order_relaxed);
+
+		if (include_categories)
+			allocator_data->allocation_stats_map.clear();
+
+		for (auto* it = thread_stats_head.load(std::memory_order_acquire); it; it = it->next) {
+			totals.TotalAllocated += it->total_allocated.load(std::memory_order_relaxed);
+			totals.TotalFreed += it->total_freed.load(std::memory_order_relaxed);
+			totals.AllocationCount += it->allocation_count.load(std::memory_order_relaxed);
+			totals.FreeCount += it->free_count.load(std::memory_order_relaxed);
+
+			if (!include_categories)
+				continue;
+
+			for (const CategoryCounter& counter : it->categories) {
+				const char* category = counter.category.load(std::memory_order_acquire);
+				if (!category)
+					continue;
+
+				AllocationStats& stats = allocator_data->allocation_stats_map[category];
+				stats.TotalAllocated += counter.allocated.load(std::memory_order_relaxed);
+				stats.TotalFreed += counter.freed.load(std::memory_order_relaxed);
 			}
 		}
 
-		free(memory);
+		return totals;
+	}
+
+	const AllocatorData::AllocationStatsMap& Allocator::GetAllocationStats()
+	{
+		merge_thread_stats(true);
+		return allocator_data->allocation_stats_map;
 	}
 
 	namespace Memory {
-		const AllocationStats& get_allocation_stats() { return global_stats; }
+		AllocationStats get_allocation_stats() { return Allocator::merge_thread_stats(false); }
 	} // namespace Memory
 
 } // namespace ForgottenEngine
@@ -135,4 +369,75 @@ void* operator new(size_t size, const char* file, int line) { return ForgottenEn
 
 void* operator new[](size_t size, const char* file, int line) { return ForgottenEngine::Allocator::allocate(size, file, line); }
 
+void operator delete(void* memory) noexcept { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete(void* memory, const char*) { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete(void* memory, const char*, int) { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete[](void* memory) noexcept { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete[](void* memory, size_t) noexcept { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete[](void* memory, const char*) { ForgottenEngine::Allocator::free(memory); }
+
+void operator delete[](void* memory, const char*, int) { ForgottenEngine::Allocator::free(memory); }
+
+#elif FORGOTTEN_SAMPLE_MEMORY
+
+// Sampling only: no allocation table and no counters, just the heap profiler hook.
+
+namespace {
+
+	inline void* sampled_allocate(size_t size)
+	{
+		void* memory = std::malloc(size ? size : 1);
+		if (!memory)
+			throw std::bad_alloc();
+
+		ForgottenEngine::HeapProfiler::on_allocation(memory, size);
+		return memory;
+	}
+
+	inline void sampled_free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		ForgottenEngine::HeapProfiler::on_free(memory);
+		std::free(memory);
+	}
+
+} // namespace
+
+void* operator new(size_t size) { return sampled_allocate(size); }
+
+void* operator new[](size_t size) { return sampled_allocate(size); }
+
+void* operator new(size_t size, const char*) { return sampled_allocate(size); }
+
+void* operator new[](size_t size, const char*) { return sampled_allocate(size); }
+
+void* operator new(size_t size, const char*, int) { return sampled_allocate(size); }
+
+void* operator new[](size_t size, const char*, int) { return sampled_allocate(size); }
+
+void operator delete(void* memory) noexcept { sampled_free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { sampled_free(memory); }
+
+void operator delete(void* memory, const char*) { sampled_free(memory); }
+
+void operator delete(void* memory, const char*, int) { sampled_free(memory); }
+
+void operator delete[](void* memory) noexcept { sampled_free(memory); }
+
+void operator delete[](void* memory, size_t) noexcept { sampled_free(memory); }
+
+void operator delete[](void* memory, const char*) { sampled_free(memory); }
+
+void operator delete[](void* memory, const char*, int) { sampled_free(memory); }
+
 #endif
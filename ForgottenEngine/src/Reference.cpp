@@ -2,36 +2,43 @@
 
 #include "Reference.hpp"
 
-#include <mutex>
-#include <unordered_set>
-
 namespace ForgottenEngine {
 
-	static std::unordered_set<void*> live_references;
-	static std::mutex live_reference_mutex;
-
 	namespace RefUtils {
 
-		void add_to_live_references(void* instance)
-		{
-			std::scoped_lock<std::mutex> lock(live_reference_mutex);
-			core_assert(instance != nullptr, "No instance");
-			live_references.insert(instance);
-		}
+		void retain_weak_block(WeakBlock* block) { block->weak_count.fetch_add(1, std::memory_order_relaxed); }
 
-		void remove_from_live_references(void* instance)
+		void release_weak_block(WeakBlock* block)
 		{
-			std::scoped_lock<std::mutex> lock(live_reference_mutex);
-			core_assert(instance != nullptr, "No instance");
-			core_assert(is_in_map(live_references, instance), "Could not find instance");
-			live_references.erase(instance);
+			if (block->weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				delete block;
 		}
 
-		bool is_live(void* instance)
-		{
-			core_assert(instance != nullptr, "No instance");
-			return live_references.find(instance) != live_references.end();
-		}
 	} // namespace RefUtils
 
+	ReferenceCounted::~ReferenceCounted()
+	{
+		if (auto* block = weak_block.load(std::memory_order_acquire)) {
+			block->alive.store(false, std::memory_order_release);
+			RefUtils::release_weak_block(block);
+		}
+	}
+
+	RefUtils::WeakBlock* ReferenceCounted::acquire_weak_block() const
+	{
+		auto* block = weak_block.load(std::memory_order_acquire);
+		if (!block) {
+			auto* created = new RefUtils::WeakBlock();
+			// Two threads may race to create it; the loser adopts the winner's block.
+			if (weak_block.compare_exchange_strong(block, created, std::memory_order_acq_rel))
+				block = created;
+			else
+				delete created;
+		}
+
+		// The reference being created.
+		RefUtils::retain_weak_block(block);
+		return block;
+	}
+
 } // namespace ForgottenEngine
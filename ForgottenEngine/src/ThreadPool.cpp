@@ -0,0 +1,75 @@
+#include "fg_pch.hpp"
+
+#include "ThreadPool.hpp"
+
+namespace ForgottenEngine {
+
+	static std::unique_ptr<ThreadPool> engine_pool;
+
+	ThreadPool::ThreadPool(uint32_t thread_count)
+	{
+		thread_count = std::max(thread_count, 1u);
+		threads.reserve(thread_count);
+		for (uint32_t i = 0; i < thread_count; i++)
+			threads.emplace_back([this]() { worker_loop(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(mutex);
+			stopping = true;
+		}
+		condition.notify_all();
+
+		// Whatever is still queued runs first, nobody is left waiting on a broken promise.
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	void ThreadPool::enqueue(std::function<void()> task)
+	{
+		{
+			std::lock_guard lock(mutex);
+			core_assert(!stopping, "Submitting work to a thread pool that is shutting down.");
+			tasks.push_back(std::move(task));
+		}
+		condition.notify_one();
+	}
+
+	void ThreadPool::worker_loop()
+	{
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock lock(mutex);
+				condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+				if (tasks.empty())
+					return;
+
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+	void ThreadPool::init()
+	{
+		core_assert(!engine_pool, "ThreadPool::init called twice.");
+		engine_pool = std::make_unique<ThreadPool>(std::max(get_hardware_thread_count() - 1, 1u));
+		CORE_INFO("Thread pool running {} workers.", engine_pool->get_thread_count());
+	}
+
+	void ThreadPool::shutdown() { engine_pool.reset(); }
+
+	ThreadPool& ThreadPool::get()
+	{
+		core_assert(engine_pool, "ThreadPool::init has not been called.");
+		return *engine_pool;
+	}
+
+	uint32_t ThreadPool::get_hardware_thread_count() { return std::max(std::thread::hardware_concurrency(), 1u); }
+
+} // namespace ForgottenEngine
@@ -16,6 +16,29 @@ namespace ForgottenEngine {
 
 	static std::vector<VkCommandBuffer> imgui_command_buffers;
 
+	struct ImGuiLayer::DrawDataSnapshot {
+		ImDrawData draw_data;
+		ImVector<ImDrawList*> draw_lists;
+
+		explicit DrawDataSnapshot(const ImDrawData& source)
+			: draw_data(source)
+		{
+			draw_lists.resize(source.CmdListsCount);
+			for (int i = 0; i < source.CmdListsCount; i++)
+				draw_lists[i] = source.CmdLists[i]->CloneOutput();
+			draw_data.CmdLists = draw_lists.Data;
+		}
+
+		~DrawDataSnapshot()
+		{
+			for (auto* draw_list : draw_lists)
+				IM_DELETE(draw_list);
+		}
+
+		DrawDataSnapshot(const DrawDataSnapshot&) = delete;
+		DrawDataSnapshot& operator=(const DrawDataSnapshot&) = delete;
+	};
+
 	void ImGuiLayer::on_attach()
 	{
 		ImGui::CreateContext();
@@ -23,12 +46,15 @@ namespace ForgottenEngine {
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Enable Keyboard Controls
 		// io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable; // Enable Docking
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport / Platform Windows
+		// Platform windows are created with GLFW and drawn with Vulkan in the same call, which would need both threads at once.
+		if (!Application::the().get_render_thread().is_multi_threaded())
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable; // Enable Multi-Viewport / Platform Windows
 
-		Renderer::submit([]() {
-			Application& app = Application::the();
-			auto* window = static_cast<GLFWwindow*>(app.get_window().get_natively());
+		// GLFW may only be called from the main thread.
+		auto* window = static_cast<GLFWwindow*>(Application::the().get_window().get_natively());
+		ImGui_ImplGlfw_InitForVulkan(window, true);
 
+		Renderer::submit([]() {
 			auto vulkan_context = VulkanContext::get();
 			auto device = vulkan_context->get_device();
 
@@ -49,8 +75,7 @@ namespace ForgottenEngine {
 			pool_info.pPoolSizes = pool_sizes;
 			vk_check(vkCreateDescriptorPool(device->get_vulkan_device(), &pool_info, nullptr, &imgui_descriptor_pool));
 
-			// Setup Platform/Renderer bindings
-			ImGui_ImplGlfw_InitForVulkan(window, true);
+			// Setup Renderer bindings
 			ImGui_ImplVulkan_InitInfo init_info = {};
 			init_info.Instance = VulkanContext::get_instance();
 			init_info.PhysicalDevice = device->get_physical_device()->get_vulkan_physical_device();
@@ -96,9 +121,11 @@ namespace ForgottenEngine {
 
 			vk_check(vkDeviceWaitIdle(device->get_vulkan_device()));
 			ImGui_ImplVulkan_Shutdown();
-			ImGui_ImplGlfw_Shutdown();
-			ImGui::DestroyContext();
 		});
+		Renderer::wait_and_render();
+
+		ImGui_ImplGlfw_Shutdown();
+		ImGui::DestroyContext();
 	}
 
 	void ImGuiLayer::on_update(const TimeStep& step)
@@ -126,6 +153,27 @@ namespace ForgottenEngine {
 	{
 		ImGui::Render();
 
+		// The draw data belongs to the context and is rebuilt by the next NewFrame, which the main thread can reach
+		// before the render thread has drawn this frame; the command gets its own copy.
+		auto snapshot = std::make_unique<DrawDataSnapshot>(*ImGui::GetDrawData());
+
+		ImGuiIO& io = ImGui::GetIO();
+		const bool render_platform_windows = io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable;
+		// Update additional Platform Windows
+		if (render_platform_windows)
+			ImGui::UpdatePlatformWindows();
+
+		Renderer::submit([snapshot = std::move(snapshot), render_platform_windows]() {
+			render_draw_data(&snapshot->draw_data);
+
+			// Only enabled single threaded, where this still runs before the next NewFrame.
+			if (render_platform_windows)
+				ImGui::RenderPlatformWindowsDefault();
+		});
+	}
+
+	void ImGuiLayer::render_draw_data(ImDrawData* main_draw_data)
+	{
 		static constexpr VkClearColorValue clear_colour = { 0.1f, 0.1f, 0.1f, 1.0f };
 
 		auto& swapchain = Application::the().get_window().get_swapchain();
@@ -189,7 +237,6 @@ namespace ForgottenEngine {
 		scissor.offset.y = 0;
 		vkCmdSetScissor(imgui_command_buffers[command_buffer_index], 0, 1, &scissor);
 
-		ImDrawData* main_draw_data = ImGui::GetDrawData();
 		ImGui_ImplVulkan_RenderDrawData(main_draw_data, imgui_command_buffers[command_buffer_index]);
 
 		vk_check(vkEndCommandBuffer(imgui_command_buffers[command_buffer_index]));
@@ -202,13 +249,6 @@ namespace ForgottenEngine {
 		vkCmdEndRenderPass(draw_command_buffer);
 
 		vk_check(vkEndCommandBuffer(draw_command_buffer));
-
-		ImGuiIO& io = ImGui::GetIO();
-		// Update and Render additional Platform Windows
-		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
-		}
 	}
 
 } // namespace ForgottenEngine
@@ -0,0 +1,43 @@
+#include "fg_pch.hpp"
+
+#include "null/NullIndexBuffer.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullIndexBuffer::NullIndexBuffer(uint32_t size)
+		: size(size)
+	{
+		local_data.allocate(size);
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	NullIndexBuffer::NullIndexBuffer(void* data, uint32_t size)
+		: size(size)
+	{
+		local_data = Buffer::copy(data, size);
+		NullRenderer::count(NullCounter::ResourcesCreated);
+
+		Reference<NullIndexBuffer> instance = this;
+		Renderer::submit([instance]() mutable {
+			NullRenderer::count(NullCounter::BufferUploads);
+			NullRenderer::count(NullCounter::BufferUploadBytes, instance->size);
+		});
+	}
+
+	NullIndexBuffer::~NullIndexBuffer() { local_data.release(); }
+
+	void NullIndexBuffer::set_data(void* buffer, uint32_t in_size, uint32_t offset)
+	{
+		core_assert(offset + in_size <= local_data.size, "Index data does not fit the buffer.");
+		memcpy((uint8_t*)local_data.data + offset, buffer, in_size);
+
+		Renderer::submit([in_size]() {
+			NullRenderer::count(NullCounter::BufferUploads);
+			NullRenderer::count(NullCounter::BufferUploadBytes, in_size);
+		});
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,67 @@
+#include "fg_pch.hpp"
+
+#include "null/NullMaterial.hpp"
+
+#include "null/NullRenderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullMaterial::NullMaterial(const Reference<Shader>& shader, std::string name)
+		: material_shader(shader)
+		, material_name(std::move(name))
+		, material_flags((uint32_t)MaterialFlag::DepthTest | (uint32_t)MaterialFlag::Blend)
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	NullMaterial::NullMaterial(const Reference<Material>& material, const std::string& name)
+		: material_shader(material->get_shader())
+		, material_name(name.empty() ? material->get_name() : name)
+		, material_flags(material->get_flags())
+	{
+		if (const auto* other = dynamic_cast<const NullMaterial*>(material.raw())) {
+			uniforms = other->uniforms;
+			textures = other->textures;
+			cube_textures = other->cube_textures;
+			images = other->images;
+		}
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	void NullMaterial::set(const std::string& name, const Reference<Texture2D>& texture)
+	{
+		textures[name] = texture;
+		NullRenderer::count(NullCounter::MaterialWrites);
+	}
+
+	void NullMaterial::set(const std::string& name, const Reference<Texture2D>& texture, uint32_t array_index)
+	{
+		textures[name + "[" + std::to_string(array_index) + "]"] = texture;
+		NullRenderer::count(NullCounter::MaterialWrites);
+	}
+
+	void NullMaterial::set(const std::string& name, const Reference<TextureCube>& texture)
+	{
+		cube_textures[name] = texture;
+		NullRenderer::count(NullCounter::MaterialWrites);
+	}
+
+	void NullMaterial::set(const std::string& name, const Reference<Image2D>& image)
+	{
+		images[name] = image;
+		NullRenderer::count(NullCounter::MaterialWrites);
+	}
+
+	Reference<Texture2D> NullMaterial::get_texture_2d(const std::string& name)
+	{
+		auto it = textures.find(name);
+		return it != textures.end() ? it->second : nullptr;
+	}
+
+	Reference<TextureCube> NullMaterial::get_texture_cube(const std::string& name)
+	{
+		auto it = cube_textures.find(name);
+		return it != cube_textures.end() ? it->second : nullptr;
+	}
+
+} // namespace ForgottenEngine
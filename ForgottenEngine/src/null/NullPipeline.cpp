@@ -0,0 +1,27 @@
+#include "fg_pch.hpp"
+
+#include "null/NullPipeline.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullPipeline::NullPipeline(const PipelineSpecification& spec)
+		: spec(spec)
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	void NullPipeline::bind()
+	{
+		Renderer::submit([]() { NullRenderer::count(NullCounter::PipelineBinds); });
+	}
+
+	void NullPipeline::invalidate()
+	{
+		Reference<NullPipeline> instance = this;
+		Renderer::submit([instance]() { });
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,30 @@
+#include "fg_pch.hpp"
+
+#include "null/NullRenderCommandBuffer.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullRenderCommandBuffer::NullRenderCommandBuffer() { NullRenderer::count(NullCounter::ResourcesCreated); }
+
+	void NullRenderCommandBuffer::begin()
+	{
+		Reference<NullRenderCommandBuffer> instance = this;
+		Renderer::submit([instance]() { });
+	}
+
+	void NullRenderCommandBuffer::end()
+	{
+		Reference<NullRenderCommandBuffer> instance = this;
+		Renderer::submit([instance]() { });
+	}
+
+	void NullRenderCommandBuffer::submit()
+	{
+		Reference<NullRenderCommandBuffer> instance = this;
+		Renderer::submit([instance]() { NullRenderer::count(NullCounter::CommandBufferSubmits); });
+	}
+
+} // namespace ForgottenEngine
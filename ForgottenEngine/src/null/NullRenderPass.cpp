@@ -0,0 +1,15 @@
+#include "fg_pch.hpp"
+
+#include "null/NullRenderPass.hpp"
+
+#include "null/NullRenderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullRenderPass::NullRenderPass(const RenderPassSpecification& spec)
+		: spec(spec)
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,95 @@
+#include "fg_pch.hpp"
+
+#include "null/NullRenderer.hpp"
+
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	static uint64_t read(std::atomic<uint64_t>& counter) { return counter.load(std::memory_order_relaxed); }
+
+	void NullRenderer::init() { CORE_INFO("Null renderer: commands are counted, not executed."); }
+
+	void NullRenderer::shut_down() { }
+
+	void NullRenderer::begin_frame()
+	{
+		Renderer::submit([]() { count(NullCounter::Frames); });
+	}
+
+	void NullRenderer::begin_render_pass(Reference<RenderCommandBuffer> command_buffer, Reference<RenderPass> render_pass, bool explicit_clear)
+	{
+		Renderer::submit([command_buffer, render_pass]() { count(NullCounter::RenderPasses); });
+	}
+
+	void NullRenderer::end_render_pass(Reference<RenderCommandBuffer> command_buffer)
+	{
+		Renderer::submit([command_buffer]() { });
+	}
+
+	void NullRenderer::end_frame()
+	{
+		Renderer::submit([]() { frame_index = (frame_index + 1) % Renderer::get_config().frames_in_flight; });
+	}
+
+	void NullRenderer::render_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline, Reference<UniformBufferSet> ubs,
+		Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb, Reference<IndexBuffer> ib,
+		const glm::mat4& transform, uint32_t index_count)
+	{
+		// Same captures as the Vulkan path, so the submission cost is comparable.
+		Renderer::submit([command_buffer, pipeline, ubs, sbs, material, vb, ib, transform, index_count]() {
+			count(NullCounter::DrawCalls);
+			count(NullCounter::Indices, index_count);
+		});
+	}
+
+	void NullRenderer::render_instanced_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline,
+		Reference<UniformBufferSet> ubs, Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb,
+		Reference<IndexBuffer> ib, Reference<VertexBuffer> instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count)
+	{
+		Renderer::submit([command_buffer, pipeline, ubs, sbs, material, vb, ib, instance_vb, transform, index_count, instance_count]() {
+			count(NullCounter::DrawCalls);
+			count(NullCounter::Indices, uint64_t(index_count) * instance_count);
+		});
+	}
+
+	void NullRenderer::submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline_in,
+		const Reference<UniformBufferSet>& ub, const Reference<StorageBufferSet>& sb, const Reference<Material>& material)
+	{
+		Renderer::submit([command_buffer, pipeline_in, ub, sb, material]() {
+			count(NullCounter::DrawCalls);
+			count(NullCounter::Indices, 6);
+		});
+	}
+
+	void NullRenderer::submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline,
+		const Reference<UniformBufferSet>& uniform_buffer_set, const Reference<Material>& material)
+	{
+		submit_fullscreen_quad(command_buffer, pipeline, uniform_buffer_set, nullptr, material);
+	}
+
+	NullRendererStats NullRenderer::get_stats()
+	{
+		NullRendererStats stats;
+		stats.frames = read(counters[static_cast<uint32_t>(NullCounter::Frames)]);
+		stats.render_passes = read(counters[static_cast<uint32_t>(NullCounter::RenderPasses)]);
+		stats.draw_calls = read(counters[static_cast<uint32_t>(NullCounter::DrawCalls)]);
+		stats.indices = read(counters[static_cast<uint32_t>(NullCounter::Indices)]);
+		stats.buffer_uploads = read(counters[static_cast<uint32_t>(NullCounter::BufferUploads)]);
+		stats.buffer_upload_bytes = read(counters[static_cast<uint32_t>(NullCounter::BufferUploadBytes)]);
+		stats.texture_uploads = read(counters[static_cast<uint32_t>(NullCounter::TextureUploads)]);
+		stats.texture_upload_bytes = read(counters[static_cast<uint32_t>(NullCounter::TextureUploadBytes)]);
+		stats.material_writes = read(counters[static_cast<uint32_t>(NullCounter::MaterialWrites)]);
+		stats.pipeline_binds = read(counters[static_cast<uint32_t>(NullCounter::PipelineBinds)]);
+		stats.command_buffer_submits = read(counters[static_cast<uint32_t>(NullCounter::CommandBufferSubmits)]);
+		stats.resources_created = read(counters[static_cast<uint32_t>(NullCounter::ResourcesCreated)]);
+		return stats;
+	}
+
+	void NullRenderer::reset_stats()
+	{
+		for (auto& counter : counters)
+			counter.store(0, std::memory_order_relaxed);
+	}
+
+} // namespace ForgottenEngine
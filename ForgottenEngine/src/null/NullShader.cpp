@@ -0,0 +1,16 @@
+#include "fg_pch.hpp"
+
+#include "null/NullShader.hpp"
+
+#include "null/NullRenderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullShader::NullShader(const std::filesystem::path& path)
+		: name(path.stem().string())
+		, hash(std::hash<std::string> {}(path.string()))
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+} // namespace ForgottenEngine
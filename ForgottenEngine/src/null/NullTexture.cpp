@@ -0,0 +1,80 @@
+#include "fg_pch.hpp"
+
+#include "null/NullTexture.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullTexture2D::NullTexture2D(const std::string& path, const TextureProperties& properties)
+		: path(path)
+		, properties(properties)
+	{
+		std::error_code error;
+		const auto file_size = std::filesystem::file_size(path, error);
+		loaded = !error;
+
+		image_data.allocate(Utils::get_image_memory_size(format, width, height));
+		image_data.zero_initialise();
+		NullRenderer::count(NullCounter::ResourcesCreated);
+
+		Renderer::submit([file_size = loaded ? file_size : 0]() {
+			NullRenderer::count(NullCounter::TextureUploads);
+			NullRenderer::count(NullCounter::TextureUploadBytes, file_size);
+		});
+	}
+
+	NullTexture2D::NullTexture2D(ImageFormat format, uint32_t width, uint32_t height, const void* data, const TextureProperties& properties)
+		: width(width)
+		, height(height)
+		, properties(properties)
+		, format(format)
+		, loaded(true)
+	{
+		const uint32_t size = Utils::get_image_memory_size(format, width, height);
+		if (data)
+			image_data = Buffer::copy(data, size);
+		else
+			image_data.allocate(size);
+		NullRenderer::count(NullCounter::ResourcesCreated);
+
+		Renderer::submit([size]() {
+			NullRenderer::count(NullCounter::TextureUploads);
+			NullRenderer::count(NullCounter::TextureUploadBytes, size);
+		});
+	}
+
+	NullTexture2D::~NullTexture2D() { image_data.release(); }
+
+	void NullTexture2D::resize(uint32_t in_width, uint32_t in_height)
+	{
+		width = in_width;
+		height = in_height;
+		image_data.allocate(Utils::get_image_memory_size(format, width, height));
+	}
+
+	void NullTexture2D::unlock()
+	{
+		Renderer::submit([size = image_data.size]() {
+			NullRenderer::count(NullCounter::TextureUploads);
+			NullRenderer::count(NullCounter::TextureUploadBytes, size);
+		});
+	}
+
+	uint32_t NullTexture2D::get_mip_level_count() const { return properties.GenerateMips ? Utils::calculate_mip_count(width, height) : 1; }
+
+	std::pair<uint32_t, uint32_t> NullTexture2D::get_mip_size(uint32_t mip) const
+	{
+		uint32_t w = width;
+		uint32_t h = height;
+		while (mip != 0) {
+			w /= 2;
+			h /= 2;
+			mip--;
+		}
+
+		return { w, h };
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,63 @@
+#include "fg_pch.hpp"
+
+#include "null/NullUniformBuffer.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullUniformBuffer::NullUniformBuffer(uint32_t size, uint32_t binding)
+		: size(size)
+		, binding(binding)
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	void NullUniformBuffer::set_data(const void* data, uint32_t in_size, uint32_t offset)
+	{
+		core_assert(offset + in_size <= size, "Uniform buffer write of {} bytes at {} is past its {} bytes.", in_size, offset, size);
+
+		// Copied into the frame allocator as the Vulkan backend does, so headless runs pay for it too.
+		auto* copy = Renderer::get_frame_allocator().allocate_array<uint8_t>(in_size);
+		memcpy(copy, data, in_size);
+		Reference<NullUniformBuffer> instance = this;
+		Renderer::submit([instance, copy, in_size, offset]() mutable { instance->render_thread_set_data(copy, in_size, offset); });
+	}
+
+	void NullUniformBuffer::render_thread_set_data(const void* data, uint32_t in_size, uint32_t offset)
+	{
+		NullRenderer::count(NullCounter::BufferUploads);
+		NullRenderer::count(NullCounter::BufferUploadBytes, in_size);
+	}
+
+	NullUniformBufferSet::NullUniformBufferSet(uint32_t frames)
+		: frames(frames)
+	{
+	}
+
+	void NullUniformBufferSet::create(uint32_t size, uint32_t binding)
+	{
+		for (uint32_t frame = 0; frame < frames; frame++)
+			set(UniformBuffer::create(size, binding), 0, frame);
+	}
+
+	Reference<UniformBuffer> NullUniformBufferSet::get(uint32_t binding, uint32_t set, uint32_t frame)
+	{
+		return frame_ubs.at(frame).at(set).at(binding);
+	}
+
+	void NullUniformBufferSet::set(const Reference<UniformBuffer>& buffer, uint32_t set, uint32_t frame)
+	{
+		frame_ubs[frame][set][buffer->get_binding()] = buffer;
+	}
+
+	void NullUniformBufferSet::set_ring(const Reference<UniformBufferRing>& ring) { rings[ring->get_binding()] = ring; }
+
+	Reference<UniformBufferRing> NullUniformBufferSet::get_ring(uint32_t binding)
+	{
+		auto it = rings.find(binding);
+		return it != rings.end() ? it->second : nullptr;
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,39 @@
+#include "fg_pch.hpp"
+
+#include "null/NullUniformBufferRing.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullUniformBufferRing::NullUniformBufferRing(uint32_t block_size, uint32_t block_count, uint32_t binding)
+		: block_size(block_size)
+		, block_count(block_count)
+		, binding(binding)
+	{
+		NullRenderer::count(NullCounter::ResourcesCreated);
+		begin_frame();
+	}
+
+	void NullUniformBufferRing::begin_frame()
+	{
+		frame_start = Renderer::get_current_frame_index() * block_size * block_count;
+		head = 0;
+		offset = frame_start;
+	}
+
+	uint32_t NullUniformBufferRing::push(const void* data, uint32_t size)
+	{
+		core_assert(size <= block_size, "Uniform block is larger than the ring's block size.");
+		core_assert(head + block_size <= block_size * block_count, "UniformBufferRing is full for this frame.");
+
+		offset = frame_start + head;
+		head += block_size;
+
+		NullRenderer::count(NullCounter::BufferUploads);
+		NullRenderer::count(NullCounter::BufferUploadBytes, size);
+		return offset;
+	}
+
+} // namespace ForgottenEngine
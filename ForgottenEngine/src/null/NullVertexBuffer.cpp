@@ -0,0 +1,51 @@
+#include "fg_pch.hpp"
+
+#include "null/NullVertexBuffer.hpp"
+
+#include "null/NullRenderer.hpp"
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	NullVertexBuffer::NullVertexBuffer(uint32_t size, VertexBufferUsage usage)
+		: size(size)
+		, stream(usage == VertexBufferUsage::Stream)
+	{
+		local_data.allocate(stream ? size * Renderer::get_config().frames_in_flight : size);
+		NullRenderer::count(NullCounter::ResourcesCreated);
+	}
+
+	NullVertexBuffer::NullVertexBuffer(void* data, uint32_t size, VertexBufferUsage usage)
+		: size(size)
+	{
+		local_data = Buffer::copy(data, size);
+		NullRenderer::count(NullCounter::ResourcesCreated);
+		NullRenderer::count(NullCounter::BufferUploads);
+		NullRenderer::count(NullCounter::BufferUploadBytes, size);
+	}
+
+	NullVertexBuffer::~NullVertexBuffer() { local_data.release(); }
+
+	void* NullVertexBuffer::get_mapped_region(uint32_t frame_index) { return stream ? (uint8_t*)local_data.data + (size_t)frame_index * size : nullptr; }
+
+	void NullVertexBuffer::set_data(void* buffer, uint32_t in_size, uint32_t offset)
+	{
+		if (stream) {
+			memcpy(get_mapped_region(Renderer::get_current_frame_index()), (uint8_t*)buffer + offset, in_size);
+			return;
+		}
+
+		core_assert(in_size <= local_data.size, "Size is less than local in_size.");
+		memcpy(local_data.data, (uint8_t*)buffer + offset, in_size);
+
+		Reference<NullVertexBuffer> instance = this;
+		Renderer::submit([instance, in_size, offset]() mutable { instance->rt_set_data(instance->local_data.data, in_size, offset); });
+	}
+
+	void NullVertexBuffer::rt_set_data(void* buffer, uint32_t in_size, uint32_t offset)
+	{
+		NullRenderer::count(NullCounter::BufferUploads);
+		NullRenderer::count(NullCounter::BufferUploadBytes, in_size);
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,242 @@
+#include "fg_pch.hpp"
+
+#include "render/DynamicFontAtlas.hpp"
+
+#include "render/FontAtlasCache.hpp"
+#include "render/Texture.hpp"
+
+#undef INFINITE
+#include "msdf-atlas-gen.h"
+
+namespace ForgottenEngine {
+
+	// Same generation settings as the eagerly built atlases in Font.cpp.
+	constexpr auto DYNAMIC_ANGLE_THRESHOLD = 3.0;
+	constexpr auto DYNAMIC_MITER_LIMIT = 1.0;
+
+	struct DynamicFontAtlas::Page {
+		uint32_t index = 0;
+		msdf_atlas::RectanglePacker packer;
+		std::vector<uint8_t> pixels; // RGBA8, page_size squared
+		Reference<Texture2D> texture;
+		uint32_t glyph_count = 0;
+		uint64_t last_used_frame = 0;
+
+		bool dirty = false; // Pixels differ from the texture.
+	};
+
+	DynamicFontAtlas::DynamicFontAtlas(const std::filesystem::path& path, const DynamicFontAtlasSpecification& specification)
+		: specification(specification)
+	{
+		core_assert(specification.max_pages > 0 && specification.max_pages <= max_page_limit, "A dynamic font atlas can have 1 to {} pages.",
+			max_page_limit);
+
+		freetype = msdfgen::initializeFreetype();
+		core_assert(freetype, "Could not initialise FreeType.");
+		font = msdfgen::loadFont(freetype, path.string().c_str());
+		core_assert(font, "Could not load font {}", path.string());
+
+		// As FontGeometry::loadMetrics does with a font scale of 1: everything in ems.
+		msdfgen::FontMetrics font_metrics = {};
+		msdfgen::getFontMetrics(font_metrics, font);
+		if (font_metrics.emSize <= 0)
+			font_metrics.emSize = 2048;
+		geometry_scale = 1.0 / font_metrics.emSize;
+		metrics.line_height = font_metrics.lineHeight * geometry_scale;
+		metrics.ascender = font_metrics.ascenderY * geometry_scale;
+		metrics.descender = font_metrics.descenderY * geometry_scale;
+	}
+
+	DynamicFontAtlas::~DynamicFontAtlas()
+	{
+		if (font)
+			msdfgen::destroyFont(font);
+		if (freetype)
+			msdfgen::deinitializeFreetype(freetype);
+	}
+
+	const DynamicFontAtlas::Glyph* DynamicFontAtlas::get_glyph(char32_t code_point)
+	{
+		if (auto it = glyphs.find(code_point); it != glyphs.end()) {
+			Entry& entry = it->second;
+			if (!entry.available)
+				return nullptr;
+			if (!entry.glyph.is_blank())
+				pages[entry.glyph.page]->last_used_frame = frame;
+			return &entry.glyph;
+		}
+
+		msdf_atlas::GlyphGeometry geometry;
+		if (!geometry.load(font, geometry_scale, code_point)) {
+			glyphs[code_point] = Entry {};
+			return nullptr;
+		}
+
+		Glyph glyph;
+		glyph.advance = geometry.getAdvance();
+
+		if (!geometry.isWhitespace()) {
+			geometry.edgeColoring(msdfgen::edgeColoringInkTrap, DYNAMIC_ANGLE_THRESHOLD, 0);
+			geometry.wrapBox(specification.em_size, specification.px_range / specification.em_size, DYNAMIC_MITER_LIMIT);
+
+			int width, height;
+			geometry.getBoxSize(width, height);
+			if (width > 0 && height > 0) {
+				int x, y;
+				Page* page = find_page(width, height, x, y);
+				if (!page) {
+					// Not remembered as missing: there may be room next frame.
+					full_misses++;
+					if (!warned_full) {
+						CORE_WARN("[DynamicFontAtlas] {}: all {} pages are in use this frame, skipping glyphs.", specification.debug_name,
+							specification.max_pages);
+						warned_full = true;
+					}
+					return nullptr;
+				}
+				geometry.placeBox(x, y);
+
+				msdf_atlas::GeneratorAttributes attributes;
+				attributes.config.overlapSupport = true;
+				attributes.scanlinePass = true;
+				msdfgen::Bitmap<float, 4> bitmap(width, height);
+				msdf_atlas::mtsdfGenerator(bitmap, geometry, attributes);
+
+				std::vector<uint8_t> rgba8;
+				FontAtlasCache::quantise(static_cast<const float*>(bitmap), static_cast<size_t>(width) * height, 4, rgba8);
+
+				// Rows stay bottom-up, as in the eagerly built atlases.
+				const size_t page_stride = static_cast<size_t>(specification.page_size) * 4;
+				for (int row = 0; row < height; row++) {
+					std::memcpy(page->pixels.data() + static_cast<size_t>(y + row) * page_stride + static_cast<size_t>(x) * 4,
+						rgba8.data() + static_cast<size_t>(row) * width * 4, static_cast<size_t>(width) * 4);
+				}
+				page->dirty = true;
+				page->glyph_count++;
+				page->last_used_frame = frame;
+
+				double pl, pb, pr, pt;
+				geometry.getQuadPlaneBounds(pl, pb, pr, pt);
+				double l, b, r, t;
+				geometry.getQuadAtlasBounds(l, b, r, t);
+
+				const double texel = 1.0 / specification.page_size;
+				glyph.plane_min = { pl, pb };
+				glyph.plane_max = { pr, pt };
+				glyph.uv_min = { l * texel, b * texel };
+				glyph.uv_max = { r * texel, t * texel };
+				glyph.page = page->index;
+			}
+		}
+
+		Entry& entry = glyphs[code_point];
+		entry.glyph = glyph;
+		entry.available = true;
+		return &entry.glyph;
+	}
+
+	double DynamicFontAtlas::get_kerning(char32_t first, char32_t second)
+	{
+		const uint64_t key = (static_cast<uint64_t>(first) << 32) | second;
+		auto [it, inserted] = kerning.try_emplace(key, 0.0);
+		if (inserted) {
+			double value;
+			if (msdfgen::getKerning(value, font, first, second))
+				it->second = value * geometry_scale;
+		}
+		return it->second;
+	}
+
+	void DynamicFontAtlas::touch_pages(uint32_t page_mask)
+	{
+		for (uint32_t i = 0; i < pages.size(); i++) {
+			if (page_mask & (1u << i))
+				pages[i]->last_used_frame = frame;
+		}
+	}
+
+	void DynamicFontAtlas::update()
+	{
+		for (auto& page : pages) {
+			if (!page->dirty)
+				continue;
+
+			page->dirty = false;
+			if (page->glyph_count == 0) {
+				page->texture = nullptr;
+				continue;
+			}
+
+			// A new texture rather than an update in place, frames in flight keep sampling the old one.
+			TextureProperties properties;
+			properties.DebugName = fmt::format("{} page {}", specification.debug_name, page->index);
+			properties.SamplerWrap = TextureWrap::Clamp;
+			properties.GenerateMips = false;
+			page->texture = Texture2D::create(ImageFormat::RGBA, specification.page_size, specification.page_size, page->pixels.data(), properties);
+		}
+	}
+
+	Reference<Texture2D> DynamicFontAtlas::get_page_texture(uint32_t page) const
+	{
+		core_assert(page < pages.size(), "Not a page of this atlas.");
+		return pages[page]->texture;
+	}
+
+	bool DynamicFontAtlas::try_place(Page& page, int width, int height, int& x, int& y)
+	{
+		msdf_atlas::Rectangle rectangle { -1, -1, width, height };
+		if (page.packer.pack(&rectangle, 1) != 0)
+			return false;
+
+		x = rectangle.x;
+		y = rectangle.y;
+		return true;
+	}
+
+	DynamicFontAtlas::Page* DynamicFontAtlas::find_page(int width, int height, int& x, int& y)
+	{
+		const auto page_size = static_cast<int>(specification.page_size);
+		if (width > page_size || height > page_size)
+			return nullptr;
+
+		for (auto& page : pages) {
+			if (try_place(*page, width, height, x, y))
+				return page.get();
+		}
+
+		if (pages.size() < specification.max_pages) {
+			auto& page = *pages.emplace_back(std::make_unique<Page>());
+			page.index = static_cast<uint32_t>(pages.size() - 1);
+			page.packer = msdf_atlas::RectanglePacker(page_size, page_size);
+			page.pixels.resize(static_cast<size_t>(specification.page_size) * specification.page_size * 4);
+			return try_place(page, width, height, x, y) ? &page : nullptr;
+		}
+
+		// Over budget: empty the page drawn from longest ago, unless every page is needed this frame.
+		Page* victim = nullptr;
+		for (auto& page : pages) {
+			if (page->last_used_frame < frame && (!victim || page->last_used_frame < victim->last_used_frame))
+				victim = page.get();
+		}
+		if (!victim)
+			return nullptr;
+
+		evict(*victim);
+		return try_place(*victim, width, height, x, y) ? victim : nullptr;
+	}
+
+	void DynamicFontAtlas::evict(Page& page)
+	{
+		std::erase_if(glyphs, [&page](const auto& item) { return item.second.glyph.page == page.index; });
+
+		const auto page_size = static_cast<int>(specification.page_size);
+		page.packer = msdf_atlas::RectanglePacker(page_size, page_size);
+		std::fill(page.pixels.begin(), page.pixels.end(), uint8_t { 0 });
+		page.glyph_count = 0;
+		page.dirty = true;
+
+		generation++;
+		warned_full = false;
+	}
+
+} // namespace ForgottenEngine
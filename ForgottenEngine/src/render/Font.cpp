@@ -2,8 +2,9 @@
 
 #include "render/Font.hpp"
 
+#include "ThreadPool.hpp"
+#include "render/FontAtlasCache.hpp"
 #include "render/MSDFData.hpp"
-#include "utilities/FileSystem.hpp"
 
 namespace ForgottenEngine {
 
@@ -36,96 +37,144 @@ namespace ForgottenEngine {
 	constexpr auto DEFAULT_MITER_LIMIT = 1.0;
 	constexpr auto LCG_MULTIPLIER = 6364136223846793005ull;
 	constexpr auto LCG_INCREMENT = 1442695040888963407ull;
-	constexpr auto THREADS = 8;
 
-	namespace Utils {
+	/// Atlas pixels made by load_glyphs, waiting for the main thread to turn them into a texture.
+	struct Font::LoadedAtlas {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		const void* pixels = nullptr; // RGBA8, into generated or cache_file.
+		std::vector<uint8_t> generated;
+		MappedFile cache_file;
+	};
 
-		static std::filesystem::path cache_dir = Assets::slashed_string_to_filepath("fonts/cache/font_atlases");
+	static Reference<Texture2D> create_atlas_texture(uint32_t width, uint32_t height, const void* rgba8_pixels)
+	{
+		TextureProperties props;
+		props.GenerateMips = false;
+		props.SamplerWrap = TextureWrap::Clamp;
+		props.DebugName = "FontAtlas";
+		return Texture2D::create(ImageFormat::RGBA, width, height, rgba8_pixels, props);
+	}
 
-		static void create_cache_directory_if_needed()
-		{
-			if (!std::filesystem::exists(Utils::cache_dir))
-				std::filesystem::create_directories(Utils::cache_dir);
+	template <int N, GeneratorFunction<float, N> GEN_FN>
+	static void create_cache_atlas(const std::string& font_name, uint64_t key, const std::vector<GlyphGeometry>& glyphs, const Configuration& config,
+		std::vector<uint8_t>& pixels)
+	{
+		ImmediateAtlasGenerator<float, N, GEN_FN, BitmapAtlasStorage<float, N>> generator(config.width, config.height);
+		generator.setAttributes(config.generator_attributes);
+		generator.setThreadCount((int)ThreadPool::get_hardware_thread_count());
+		generator.generate(glyphs.data(), glyphs.size());
+
+		msdfgen::BitmapConstRef<float, N> bitmap = (msdfgen::BitmapConstRef<float, N>)generator.atlasStorage();
+
+		FontAtlasHeader header;
+		header.Key = key;
+		header.Width = bitmap.width;
+		header.Height = bitmap.height;
+		header.GlyphCount = (uint32_t)glyphs.size();
+		header.EmSize = (float)config.em_size;
+		header.PixelRange = (float)config.px_range;
+
+		std::vector<FontAtlasGlyph> placements(glyphs.size());
+		for (size_t i = 0; i < glyphs.size(); i++) {
+			placements[i].CodePoint = glyphs[i].getCodepoint();
+			int x, y, w, h;
+			glyphs[i].getBoxRect(x, y, w, h);
+			if (!glyphs[i].isWhitespace() && w > 0 && h > 0) {
+				placements[i].X = x;
+				placements[i].Y = y;
+				placements[i].Width = w;
+				placements[i].Height = h;
+			}
 		}
-	} // namespace Utils
 
-	struct AtlasHeader {
-		uint32_t Type = 0;
-		uint32_t Width, Height;
-	};
+		FontAtlasCache::quantise(bitmap.pixels, (size_t)bitmap.width * bitmap.height, N, pixels);
+		FontAtlasCache::write(font_name, header, placements, pixels.data());
+	}
 
-	static bool try_read_font_atlas_from_cache(
-		const std::string& font_name, float font_size, AtlasHeader& header, void*& pixels, Buffer& storage_buffer)
+	/// Puts every glyph back where the cached atlas has it, as TightAtlasPacker would have. False if the cache
+	/// does not match the loaded glyphs.
+	static bool restore_packing(std::vector<GlyphGeometry>& glyphs, const FontAtlasView& view, double miter_limit)
 	{
-		std::string filename = fmt::format("{0}-{1}.hfa", font_name, font_size);
-		std::filesystem::path filepath = Utils::cache_dir / filename;
+		if (view.glyphs.size() != glyphs.size())
+			return false;
+
+		const double scale = view.header->EmSize;
+		const double range = view.header->PixelRange;
+		for (size_t i = 0; i < glyphs.size(); i++) {
+			const FontAtlasGlyph& placement = view.glyphs[i];
+			GlyphGeometry& glyph = glyphs[i];
+			if (glyph.getCodepoint() != placement.CodePoint)
+				return false;
+			if (glyph.isWhitespace())
+				continue;
 
-		if (std::filesystem::exists(filepath)) {
-			storage_buffer = FileSystem::read_bytes(filepath);
-			header = *storage_buffer.as<AtlasHeader>();
-			pixels = (uint8_t*)storage_buffer.data + sizeof(AtlasHeader);
-			return true;
+			glyph.wrapBox(scale, range / scale, miter_limit);
+			int w, h;
+			glyph.getBoxSize(w, h);
+			if (w != placement.Width || h != placement.Height)
+				return false;
+			if (w > 0 && h > 0)
+				glyph.placeBox(placement.X, placement.Y);
 		}
-		return false;
+
+		return true;
 	}
 
-	static void cache_font_atlas(const std::string& font_name, float font_size, AtlasHeader header, const void* pixels)
+	Font::Font(const std::filesystem::path& filepath)
+		: file_path(filepath)
+		, msdf_data(new MSDFData())
 	{
-		Utils::create_cache_directory_if_needed();
-
-		std::string filename = fmt::format("{0}-{1}.hfa", font_name, font_size);
-		std::filesystem::path filepath = Utils::cache_dir / filename;
+		LoadedAtlas atlas;
+		load_glyphs(atlas);
+		texture_atlas = create_atlas_texture(atlas.width, atlas.height, atlas.pixels);
+	}
 
-		std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
-		if (!stream) {
-			stream.close();
-			CORE_ERROR("Failed to cache font atlas to {0}", filepath.string());
-			return;
-		}
+	Font::Font(const std::filesystem::path& filepath, AsyncLoad)
+		: file_path(filepath)
+		, msdf_data(new MSDFData())
+		, loaded_atlas(std::make_unique<LoadedAtlas>())
+	{
+	}
 
-		stream.write((char*)&header, sizeof(AtlasHeader));
-		stream.write((char*)pixels, header.Width * header.Height * sizeof(float) * 4);
+	Reference<Font> Font::load_async(const std::filesystem::path& filepath)
+	{
+		Reference<Font> font(new Font(filepath, AsyncLoad {}));
+		// The destructor waits for the load, so the raw pointer outlives the task.
+		Font* loading = font.raw();
+		font->pending_load = ThreadPool::get().submit([loading]() { loading->load_glyphs(*loading->loaded_atlas); });
+		return font;
 	}
 
-	template <typename T, typename S, int N, GeneratorFunction<S, N> GEN_FN>
-	static Reference<Texture2D> create_cache_atlas(const std::string& font_name, float font_size, const std::vector<GlyphGeometry>& glyphs,
-		const FontGeometry& fontGeometry, const Configuration& config)
+	bool Font::is_ready()
 	{
-		ImmediateAtlasGenerator<S, N, GEN_FN, BitmapAtlasStorage<T, N>> generator(config.width, config.height);
-		generator.setAttributes(config.generator_attributes);
-		generator.setThreadCount(THREADS);
-		generator.generate(glyphs.data(), glyphs.size());
+		if (!pending_load.valid())
+			return true;
+		if (pending_load.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
 
-		msdfgen::BitmapConstRef<T, N> bitmap = (msdfgen::BitmapConstRef<T, N>)generator.atlasStorage();
+		finish_loading();
+		return true;
+	}
 
-		AtlasHeader header;
-		header.Width = bitmap.width;
-		header.Height = bitmap.height;
-		cache_font_atlas(font_name, font_size, header, bitmap.pixels);
+	void Font::wait()
+	{
+		if (!pending_load.valid())
+			return;
 
-		TextureProperties props;
-		props.GenerateMips = false;
-		props.SamplerWrap = TextureWrap::Clamp;
-		props.DebugName = "FontAtlas";
-		Reference<Texture2D> texture = Texture2D::create(ImageFormat::RGBA32F, header.Width, header.Height, bitmap.pixels, props);
-		return texture;
+		pending_load.wait();
+		finish_loading();
 	}
 
-	static Reference<Texture2D> create_cached_atlas(AtlasHeader header, const void* pixels)
+	void Font::finish_loading()
 	{
-		TextureProperties props;
-		props.GenerateMips = false;
-		props.SamplerWrap = TextureWrap::Clamp;
-		props.DebugName = "FontAtlas";
-		Reference<Texture2D> texture = Texture2D::create(ImageFormat::RGBA32F, header.Width, header.Height, pixels, props);
-		return texture;
+		pending_load.get();
+		texture_atlas = create_atlas_texture(loaded_atlas->width, loaded_atlas->height, loaded_atlas->pixels);
+		loaded_atlas.reset();
 	}
 
-	Font::Font(const std::filesystem::path& filepath)
-		: file_path(filepath)
-		, msdf_data(new MSDFData())
+	void Font::load_glyphs(LoadedAtlas& atlas)
 	{
-		int result = 0;
 		FontInput fontInput = {};
 		Configuration config = {};
 		fontInput.glyph_type = GlyphIdentifierType::UNICODE_CODEPOINT;
@@ -242,9 +291,32 @@ namespace ForgottenEngine {
 		if (fontInput.font_name)
 			msdf_data->font_geometry.setName(fontInput.font_name);
 
-		// NOTE(Yan): we still need to "pack" the font to determine atlas metadata, though this could also be cached.
-		//            The most intensive part is the actual atlas generation, which is what we do cache - it takes
-		//            around 96% of total time spent in this Font constructor.
+		std::string font_name = file_path.filename().string();
+
+		// The cached atlas holds both the packing and the pixels, so a hit skips everything below.
+		uint64_t config_hash = FontAtlasCache::hash_bytes(charset_ranges, sizeof(charset_ranges));
+		auto mix = [&config_hash](const auto& value) { config_hash = FontAtlasCache::hash_bytes(&value, sizeof(value), config_hash); };
+		mix(config.image_type);
+		mix(config.em_size);
+		mix(rangeValue);
+		mix(config.angle_threshold);
+		mix(config.miter_limit);
+		mix(config.expensive_colouring);
+		mix(config.colouring_seed);
+		mix(config.generator_attributes.config.overlapSupport);
+		mix(config.generator_attributes.scanlinePass);
+		mix(atlasSizeConstraint);
+		const uint64_t cache_key = FontAtlasCache::make_key(file_path, config_hash);
+
+		MappedFile cache_file;
+		FontAtlasView cached;
+		if (FontAtlasCache::read(font_name, cache_key, cache_file, cached) && restore_packing(msdf_data->glyphs, cached, config.miter_limit)) {
+			atlas.width = cached.header->Width;
+			atlas.height = cached.header->Height;
+			atlas.pixels = cached.pixels;
+			atlas.cache_file = std::move(cache_file);
+			return;
+		}
 
 		// Determine final atlas dimensions, scale and range, pack glyphs
 		double px_range = rangeValue;
@@ -291,7 +363,7 @@ namespace ForgottenEngine {
 						return true;
 					},
 					msdf_data->glyphs.size())
-					.finish(THREADS);
+					.finish((int)ThreadPool::get_hardware_thread_count());
 			} else {
 				unsigned long long glyphSeed = config.colouring_seed;
 				for (GlyphGeometry& glyph : msdf_data->glyphs) {
@@ -301,44 +373,35 @@ namespace ForgottenEngine {
 			}
 		}
 
-		std::string font_name = filepath.filename().string();
-
-		// Check cache here
-		Buffer storage_buffer;
-		AtlasHeader header;
-		void* pixels;
-		if (try_read_font_atlas_from_cache(font_name, (float)config.em_size, header, pixels, storage_buffer)) {
-			texture_atlas = create_cached_atlas(header, pixels);
-			storage_buffer.release();
-		} else {
-			bool floatingPointFormat = true;
-			Reference<Texture2D> texture;
-			switch (config.image_type) {
-			case ImageType::MSDF:
-				if (floatingPointFormat)
-					texture = create_cache_atlas<float, float, 3, msdfGenerator>(
-						font_name, (float)config.em_size, msdf_data->glyphs, msdf_data->font_geometry, config);
-				else
-					texture = create_cache_atlas<byte, float, 3, msdfGenerator>(
-						font_name, (float)config.em_size, msdf_data->glyphs, msdf_data->font_geometry, config);
-				break;
-			case ImageType::MTSDF:
-				if (floatingPointFormat)
-					texture = create_cache_atlas<float, float, 4, mtsdfGenerator>(
-						font_name, (float)config.em_size, msdf_data->glyphs, msdf_data->font_geometry, config);
-				else
-					texture = create_cache_atlas<byte, float, 4, mtsdfGenerator>(
-						font_name, (float)config.em_size, msdf_data->glyphs, msdf_data->font_geometry, config);
-				break;
-			default:
-				core_assert_bool(false);
-			}
-
-			texture_atlas = texture;
+		switch (config.image_type) {
+		case ImageType::MSDF:
+			create_cache_atlas<3, msdfGenerator>(font_name, cache_key, msdf_data->glyphs, config, atlas.generated);
+			break;
+		case ImageType::MTSDF:
+			create_cache_atlas<4, mtsdfGenerator>(font_name, cache_key, msdf_data->glyphs, config, atlas.generated);
+			break;
+		default:
+			core_assert_bool(false);
 		}
+		atlas.width = (uint32_t)config.width;
+		atlas.height = (uint32_t)config.height;
+		atlas.pixels = atlas.generated.data();
+	}
+
+	Font::Font(const std::filesystem::path& filepath, const DynamicFontAtlasSpecification& specification)
+		: file_path(filepath)
+	{
+		DynamicFontAtlasSpecification atlas_specification = specification;
+		atlas_specification.debug_name = fmt::format("{} {}", specification.debug_name, filepath.filename().string());
+		dynamic_atlas = make<DynamicFontAtlas>(filepath, atlas_specification);
 	}
 
-	Font::~Font() { delete msdf_data; }
+	Font::~Font()
+	{
+		if (pending_load.valid())
+			pending_load.wait();
+		delete msdf_data;
+	}
 
 	Reference<Font> Font::default_font;
 
@@ -348,7 +411,8 @@ namespace ForgottenEngine {
 
 		core_assert(path, "Could not find font file under {}", (*path).string());
 
-		default_font = make<Font>(*path);
+		// The UI draws a few dozen distinct characters; generating them on demand beats the whole charset up front.
+		default_font = make<Font>(*path, DynamicFontAtlasSpecification());
 	}
 
 	void Font::shutdown() { default_font.reset(); }
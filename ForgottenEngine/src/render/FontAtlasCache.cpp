@@ -0,0 +1,108 @@
+#include "fg_pch.hpp"
+
+#include "render/FontAtlasCache.hpp"
+
+#include "utilities/FileSystem.hpp"
+
+namespace ForgottenEngine::FontAtlasCache {
+
+	static std::filesystem::path cache_dir = Assets::slashed_string_to_filepath("fonts/cache/font_atlases");
+
+	static void create_cache_directory_if_needed()
+	{
+		if (!std::filesystem::exists(cache_dir))
+			std::filesystem::create_directories(cache_dir);
+	}
+
+	static size_t get_glyph_offset() { return sizeof(FontAtlasHeader); }
+
+	static size_t get_pixel_offset(const FontAtlasHeader& header) { return get_glyph_offset() + header.GlyphCount * sizeof(FontAtlasGlyph); }
+
+	static size_t get_pixel_size(const FontAtlasHeader& header) { return (size_t)header.Width * header.Height * 4; }
+
+	uint64_t hash_bytes(const void* data, size_t size, uint64_t seed)
+	{
+		constexpr uint64_t fnv_prime = 0x100000001b3ull;
+
+		uint64_t hash = seed;
+		const auto* bytes = (const uint8_t*)data;
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= fnv_prime;
+		}
+		return hash;
+	}
+
+	uint64_t make_key(const std::filesystem::path& font_file, uint64_t config_hash)
+	{
+		MappedFile file;
+		if (!file.open(font_file))
+			return 0;
+
+		const uint32_t version = FontAtlasHeader::current_version;
+		uint64_t key = hash_bytes(file.get_data(), file.get_size());
+		key = hash_bytes(&config_hash, sizeof(config_hash), key);
+		return hash_bytes(&version, sizeof(version), key);
+	}
+
+	std::filesystem::path get_path(const std::string& font_name, uint64_t key)
+	{
+		return cache_dir / fmt::format("{0}-{1:016x}.hfa", font_name, key);
+	}
+
+	bool read(const std::string& font_name, uint64_t key, MappedFile& file, FontAtlasView& view)
+	{
+		if (!file.open(get_path(font_name, key)))
+			return false;
+
+		if (file.get_size() < sizeof(FontAtlasHeader)) {
+			file.close();
+			return false;
+		}
+
+		const auto* header = (const FontAtlasHeader*)file.get_data();
+		const bool valid = header->Magic == FontAtlasHeader::magic && header->Version == FontAtlasHeader::current_version && header->Key == key
+			&& file.get_size() >= get_pixel_offset(*header) + get_pixel_size(*header);
+		if (!valid) {
+			CORE_WARN("Ignoring stale font atlas cache {0}", get_path(font_name, key).string());
+			file.close();
+			return false;
+		}
+
+		view.header = header;
+		view.glyphs = { (const FontAtlasGlyph*)(file.get_data() + get_glyph_offset()), header->GlyphCount };
+		view.pixels = file.get_data() + get_pixel_offset(*header);
+		return true;
+	}
+
+	void write(const std::string& font_name, const FontAtlasHeader& header, std::span<const FontAtlasGlyph> glyphs, const uint8_t* pixels)
+	{
+		core_assert(header.GlyphCount == glyphs.size(), "Font atlas header and glyph count disagree.");
+		create_cache_directory_if_needed();
+
+		std::filesystem::path filepath = get_path(font_name, header.Key);
+
+		std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+		if (!stream) {
+			stream.close();
+			CORE_ERROR("Failed to cache font atlas to {0}", filepath.string());
+			return;
+		}
+
+		stream.write((const char*)&header, sizeof(FontAtlasHeader));
+		stream.write((const char*)glyphs.data(), (std::streamsize)glyphs.size_bytes());
+		stream.write((const char*)pixels, (std::streamsize)get_pixel_size(header));
+	}
+
+	void quantise(const float* pixels, size_t texel_count, uint32_t channels, std::vector<uint8_t>& out_rgba8)
+	{
+		out_rgba8.resize(texel_count * 4);
+		for (size_t i = 0; i < texel_count; i++) {
+			for (uint32_t c = 0; c < 4; c++) {
+				const float value = c < channels ? pixels[i * channels + c] : 1.0f;
+				out_rgba8[i * 4 + c] = (uint8_t)(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+			}
+		}
+	}
+
+} // namespace ForgottenEngine::FontAtlasCache
@@ -15,6 +15,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanImage2D>::create(specification);
@@ -26,6 +27,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanImage2D>::create(specification);
@@ -2,6 +2,7 @@
 
 #include "render/IndexBuffer.hpp"
 
+#include "null/NullIndexBuffer.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanIndexBuffer.hpp"
@@ -15,6 +16,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanIndexBuffer>::create(data, size);
+		case RendererAPIType::Null:
+			return Reference<NullIndexBuffer>::create(data, size);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -26,6 +29,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanIndexBuffer>::create(size);
+		case RendererAPIType::Null:
+			return Reference<NullIndexBuffer>::create(size);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
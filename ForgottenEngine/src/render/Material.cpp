@@ -2,6 +2,7 @@
 
 #include "render/Material.hpp"
 
+#include "null/NullMaterial.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanMaterial.hpp"
@@ -15,6 +16,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanMaterial>::create(shader, name);
+		case RendererAPIType::Null:
+			return Reference<NullMaterial>::create(shader, name);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -26,6 +29,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanMaterial>::create(other, name);
+		case RendererAPIType::Null:
+			return Reference<NullMaterial>::create(other, name);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -4,6 +4,7 @@
 
 #include "fg_pch.hpp"
 
+#include "null/NullPipeline.hpp"
 #include "render/Pipeline.hpp"
 
 #include "render/RendererAPI.hpp"
@@ -21,6 +22,8 @@ namespace ForgottenEngine {
 			pipeline->invalidate();
 			return pipeline;
 		}
+		case RendererAPIType::Null:
+			return Reference<NullPipeline>::create(spec);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -7,6 +7,7 @@
 
 #include "render/RenderCommandBuffer.hpp"
 
+#include "null/NullRenderCommandBuffer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanRenderCommandBuffer.hpp"
 
@@ -19,6 +20,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanRenderCommandBuffer>::create(count);
+		case RendererAPIType::Null:
+			return Reference<NullRenderCommandBuffer>::create();
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -30,6 +33,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanRenderCommandBuffer>::create();
+		case RendererAPIType::Null:
+			return Reference<NullRenderCommandBuffer>::create();
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
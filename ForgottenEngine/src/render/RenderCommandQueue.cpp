@@ -4,49 +4,139 @@
 
 namespace ForgottenEngine {
 
-	static constexpr auto command_queue_size = 10 * 1024 * 1024;
+	// How many executes the queue waits before trimming chunks above the recent high-water mark.
+	static constexpr uint32_t release_interval = 300;
 
-	RenderCommandQueue::RenderCommandQueue()
+	static inline uint8_t* align_up(uint8_t* pointer, size_t alignment)
 	{
-		command_buffer = hnew uint8_t[command_queue_size]; // 10mb buffer
-		command_buffer_ptr = command_buffer;
-		memset(command_buffer, 0, command_queue_size);
+		const auto address = reinterpret_cast<uintptr_t>(pointer);
+		return pointer + ((alignment - (address & (alignment - 1))) & (alignment - 1));
 	}
 
-	RenderCommandQueue::~RenderCommandQueue() { delete[] command_buffer; }
+	RenderCommandQueue::RenderCommandQueue(uint32_t chunk_size)
+		: chunk_size(chunk_size)
+	{
+	}
 
-	void* RenderCommandQueue::allocate(RenderCommandFn fn, uint32_t size)
+	RenderCommandQueue::~RenderCommandQueue()
 	{
-		// TODO: alignment
-		*(RenderCommandFn*)command_buffer_ptr = fn;
-		command_buffer_ptr += sizeof(RenderCommandFn);
+		for (Chunk* chunk = first_chunk; chunk;) {
+			Chunk* next = chunk->next;
+			delete[] reinterpret_cast<uint8_t*>(chunk);
+			chunk = next;
+		}
+	}
 
-		*(uint32_t*)command_buffer_ptr = size;
-		command_buffer_ptr += sizeof(uint32_t);
+	void* RenderCommandQueue::allocate(RenderCommandFn fn, uint32_t size, uint32_t alignment)
+	{
+		// Packets are [header][padding][payload][padding] and never straddle chunks.
+		const size_t required = sizeof(CommandHeader) + alignment + size + alignof(CommandHeader);
+		if (!current_chunk || current_chunk->used + required > current_chunk->size)
+			advance_chunk(required);
+
+		uint8_t* packet = chunk_data(current_chunk) + current_chunk->used;
+		auto* header = reinterpret_cast<CommandHeader*>(packet);
+		uint8_t* payload = align_up(packet + sizeof(CommandHeader), alignment);
+		uint8_t* next = align_up(payload + size, alignof(CommandHeader));
 
-		void* memory = command_buffer_ptr;
-		command_buffer_ptr += size;
+		header->function = fn;
+		header->payload_offset = static_cast<uint32_t>(payload - packet);
+		header->packet_size = static_cast<uint32_t>(next - packet);
 
+		current_chunk->used += header->packet_size;
+		bytes_written += header->packet_size;
 		command_count++;
-		return memory;
+		return payload;
 	}
 
 	void RenderCommandQueue::execute()
 	{
-		byte* buffer = command_buffer;
-
-		for (uint32_t i = 0; i < command_count; i++) {
-			RenderCommandFn function = *(RenderCommandFn*)buffer;
-			buffer += sizeof(RenderCommandFn);
+		uint32_t executed = 0;
 
-			uint32_t size = *(uint32_t*)buffer;
-			buffer += sizeof(uint32_t);
-			function(buffer);
-			buffer += size;
+		// Commands may submit more commands while running; `used` and `next` are re-read every step so those run too.
+		for (Chunk* chunk = first_chunk; chunk; chunk = chunk->next) {
+			size_t offset = 0;
+			while (offset < chunk->used) {
+				uint8_t* packet = chunk_data(chunk) + offset;
+				const auto* header = reinterpret_cast<const CommandHeader*>(packet);
+				offset += header->packet_size;
+				header->function(packet + header->payload_offset);
+				executed++;
+			}
+			chunk->used = 0;
 		}
 
-		command_buffer_ptr = command_buffer;
+		stats.command_count = executed;
+		stats.bytes = bytes_written;
+		stats.peak_command_count = std::max(stats.peak_command_count, executed);
+		stats.peak_bytes = std::max(stats.peak_bytes, bytes_written);
+		window_peak_bytes = std::max(window_peak_bytes, bytes_written);
+
+		current_chunk = first_chunk;
 		command_count = 0;
+		bytes_written = 0;
+
+		if (++executes_since_release >= release_interval)
+			release_unused_chunks();
+	}
+
+	RenderCommandQueue::Chunk* RenderCommandQueue::allocate_chunk(size_t size)
+	{
+		// Plain new: the pages are only committed once commands are actually written to them.
+		auto* chunk = reinterpret_cast<Chunk*>(hnew uint8_t[chunk_header_size + size]);
+		chunk->next = nullptr;
+		chunk->size = size;
+		chunk->used = 0;
+
+		stats.committed_bytes += size;
+		stats.chunk_count++;
+		return chunk;
+	}
+
+	void RenderCommandQueue::advance_chunk(size_t required)
+	{
+		if (!first_chunk) {
+			first_chunk = current_chunk = allocate_chunk(std::max(chunk_size, required));
+			return;
+		}
+
+		Chunk* next = current_chunk->next;
+		if (!next || next->size < required) {
+			// Oversized commands get a chunk of their own, spliced in front of the regular ones.
+			Chunk* chunk = allocate_chunk(std::max(chunk_size, required));
+			chunk->next = next;
+			current_chunk->next = chunk;
+			next = chunk;
+		}
+
+		current_chunk = next;
+	}
+
+	void RenderCommandQueue::release_unused_chunks()
+	{
+		size_t kept = 0;
+		Chunk* last_kept = nullptr;
+		for (Chunk* chunk = first_chunk; chunk; chunk = chunk->next) {
+			// One spare chunk on top of the peak covers the tails left unused when a packet moves to the next chunk.
+			if (kept >= window_peak_bytes + chunk_size && last_kept)
+				break;
+			kept += chunk->size;
+			last_kept = chunk;
+		}
+
+		if (last_kept) {
+			for (Chunk* chunk = last_kept->next; chunk;) {
+				Chunk* next = chunk->next;
+				stats.committed_bytes -= chunk->size;
+				stats.chunk_count--;
+				delete[] reinterpret_cast<uint8_t*>(chunk);
+				chunk = next;
+			}
+			last_kept->next = nullptr;
+		}
+
+		window_peak_bytes = 0;
+		executes_since_release = 0;
 	}
 
 } // namespace ForgottenEngine
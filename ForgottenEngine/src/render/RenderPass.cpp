@@ -6,6 +6,7 @@
 
 #include "render/RenderPass.hpp"
 
+#include "null/NullRenderPass.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanRenderPass.hpp"
@@ -19,6 +20,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanRenderPass>::create(spec);
+		case RendererAPIType::Null:
+			return Reference<NullRenderPass>::create(spec);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -0,0 +1,140 @@
+#include "fg_pch.hpp"
+
+#include "render/RenderThread.hpp"
+
+#include "render/Renderer.hpp"
+
+namespace ForgottenEngine {
+
+	namespace {
+
+		thread_local bool executing_render_commands = false;
+
+		using Clock = std::chrono::steady_clock;
+
+		float milliseconds_since(Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		}
+
+	} // namespace
+
+	RenderThread::RenderThread(ThreadingPolicy policy, RenderThreadSyncPolicy sync_policy)
+		: policy(policy)
+		, sync_policy(sync_policy)
+	{
+	}
+
+	RenderThread::~RenderThread() { terminate(); }
+
+	void RenderThread::run()
+	{
+		if (!is_multi_threaded() || running)
+			return;
+
+		running = true;
+		thread = std::thread([this]() { render_loop(); });
+		CORE_INFO("Started render thread.");
+	}
+
+	void RenderThread::terminate()
+	{
+		if (!running)
+			return;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wait_for_idle(lock);
+			running = false;
+		}
+		condition.notify_all();
+
+		thread.join();
+	}
+
+	void RenderThread::kick()
+	{
+		const auto kick_start = Clock::now();
+
+		if (!is_multi_threaded()) {
+			Renderer::wait_and_render();
+
+			std::scoped_lock<std::mutex> lock(mutex);
+			timings.main_thread_work_time = std::chrono::duration<float, std::milli>(kick_start - last_kick).count();
+			timings.render_thread_work_time = milliseconds_since(kick_start);
+			last_kick = Clock::now();
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(mutex);
+		timings.main_thread_work_time = std::chrono::duration<float, std::milli>(kick_start - last_kick).count();
+
+		wait_for_idle(lock);
+
+		// The render thread is parked, so the queues and the frame index can change hands here.
+		Renderer::swap_queues();
+		state = State::Kick;
+		condition.notify_all();
+
+		if (sync_policy == RenderThreadSyncPolicy::Strict)
+			wait_for_idle(lock);
+
+		timings.main_thread_wait_time = milliseconds_since(kick_start);
+		last_kick = Clock::now();
+	}
+
+	void RenderThread::block_until_rendering_complete()
+	{
+		if (!is_multi_threaded())
+			return;
+
+		std::unique_lock<std::mutex> lock(mutex);
+		wait_for_idle(lock);
+	}
+
+	RenderThreadTimings RenderThread::get_timings() const
+	{
+		std::scoped_lock<std::mutex> lock(mutex);
+		return timings;
+	}
+
+	bool RenderThread::is_render_thread() { return executing_render_commands; }
+
+	void RenderThread::render_loop()
+	{
+		executing_render_commands = true;
+
+		for (;;) {
+			std::unique_lock<std::mutex> lock(mutex);
+
+			const auto wait_start = Clock::now();
+			condition.wait(lock, [this]() { return state == State::Kick || !running; });
+			const float wait_time = milliseconds_since(wait_start);
+
+			if (state != State::Kick)
+				break;
+
+			state = State::Busy;
+			lock.unlock();
+
+			const auto work_start = Clock::now();
+			Renderer::rt_execute_render_queue();
+			const float work_time = milliseconds_since(work_start);
+
+			lock.lock();
+			timings.render_thread_wait_time = wait_time;
+			timings.render_thread_work_time = work_time;
+			state = State::Idle;
+			lock.unlock();
+			condition.notify_all();
+		}
+
+		executing_render_commands = false;
+	}
+
+	void RenderThread::wait_for_idle(std::unique_lock<std::mutex>& lock)
+	{
+		condition.wait(lock, [this]() { return state == State::Idle; });
+	}
+
+} // namespace ForgottenEngine
@@ -3,6 +3,7 @@
 #include "render/Renderer.hpp"
 
 #include "Application.hpp"
+#include "null/NullRenderer.hpp"
 #include "render/ComputePipeline.hpp"
 #include "render/IndexBuffer.hpp"
 #include "render/Material.hpp"
@@ -10,15 +11,19 @@
 #include "render/RenderCommandQueue.hpp"
 #include "render/RendererAPI.hpp"
 #include "render/RenderPass.hpp"
+#include "render/RenderThread.hpp"
 #include "render/SceneEnvironment.hpp"
 #include "render/Shader.hpp"
 #include "render/StorageBufferSet.hpp"
 #include "render/Texture.hpp"
+#include "render/UniformBufferRing.hpp"
 #include "render/UniformBufferSet.hpp"
 #include "render/VertexBuffer.hpp"
 #include "vulkan/VulkanRenderer.hpp"
 #include "vulkan/VulkanSwapchain.hpp"
 
+#include <atomic>
+
 namespace std {
 	template <> struct hash<ForgottenEngine::WeakReference<ForgottenEngine::Shader>> {
 		size_t operator()(const ForgottenEngine::WeakReference<ForgottenEngine::Shader>& shader) const noexcept { return shader->get_hash(); }
@@ -51,11 +56,34 @@ namespace ForgottenEngine {
 	static RenderCommandQueue resource_free_queue[3];
 	static RendererConfig config;
 
+	// Always a three-slot ring, independent of frames_in_flight: commands submitted before begin_frame
+	// (window events, init) live in the previous slot and must survive until the next wait_and_render.
+	static constexpr uint32_t frame_allocator_count = 3;
+	static LinearAllocator frame_allocators[frame_allocator_count];
+	static uint32_t frame_allocator_index = 0;
+
+	// The main thread records into one queue while the render thread executes the other;
+	// RenderThread::kick swaps them once the render thread is idle.
+	static RenderCommandQueue* command_queues[2] = { nullptr, nullptr };
+	static std::atomic<uint32_t> submission_queue_index = 0;
+	// Frame slot the main thread is recording. Runs one frame ahead of the swapchain when threaded.
+	static uint32_t main_thread_frame_index = 0;
+
+	static std::vector<UniformBufferRing*> uniform_buffer_rings;
+
+	static RendererFrameStats frame_stats;
+	static AllocationStats frame_start_allocations;
+
+	// Without an Application there is no render thread either; commands then run on the calling thread.
+	static bool is_multi_threaded() { return Application::exists() && Application::the().get_render_thread().is_multi_threaded(); }
+
 	static std::unique_ptr<RendererAPI> init_renderer_api()
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::Vulkan:
 			return std::make_unique<VulkanRenderer>();
+		case RendererAPIType::Null:
+			return std::make_unique<NullRenderer>();
 		default:
 			core_assert(false, "Unknown RendererAPI");
 		}
@@ -73,8 +101,11 @@ namespace ForgottenEngine {
 		CORE_DEBUG("Initializing renderer.");
 		renderer_api = init_renderer_api();
 
-		auto fif = Application::the().get_window().get_swapchain().get_image_count();
-		config.frames_in_flight = glm::min<uint32_t>(config.frames_in_flight, fif);
+		// The Null backend has no swapchain and keeps the configured count.
+		if (RendererAPI::current() != RendererAPIType::Null) {
+			auto fif = Application::the().get_window().get_swapchain().get_image_count();
+			config.frames_in_flight = glm::min<uint32_t>(config.frames_in_flight, fif);
+		}
 		// Much stuff
 
 		renderer_data.shader_library = Reference<ShaderLibrary>::create();
@@ -84,16 +115,21 @@ namespace ForgottenEngine {
 		if (!config.shader_pack_path.empty())
 			shader_library->load_shader_pack(config.shader_pack_path);
 
-		shader_library->load("SceneComposite.glsl");
-		shader_library->load("Renderer2D_Circle.glsl");
-		shader_library->load("Renderer2D_Render.glsl");
-		shader_library->load("Renderer2D_Line.glsl");
-		shader_library->load("Renderer2D.glsl");
-		shader_library->load("Renderer2D_Text.glsl");
-		shader_library->load("TexturePass.glsl");
-		shader_library->load("PreDepth.glsl");
-		shader_library->load("LightCulling.glsl");
-		shader_library->load("DirShadowMap.glsl");
+		shader_library->load_all({
+			"SceneComposite.glsl",
+			"Renderer2D_Circle.glsl",
+			"Renderer2D_Render.glsl",
+			"Renderer2D_Line.glsl",
+			"Renderer2D.glsl",
+			"Renderer2D_Text.glsl",
+			"Renderer2D_Sprite.glsl",
+			"Renderer2D_Bindless.glsl",
+			"Renderer2D_Sprite_Bindless.glsl",
+			"TexturePass.glsl",
+			"PreDepth.glsl",
+			"LightCulling.glsl",
+			"DirShadowMap.glsl",
+		});
 
 		// Compile shaders
 		Renderer::compile_shaders();
@@ -109,9 +145,14 @@ namespace ForgottenEngine {
 			props.SamplerWrap = TextureWrap::Clamp;
 			const auto brdf_lut = Assets::find_resources_by_path(Assets::slashed_string_to_filepath("renderer/brdf_lut.tga"));
 
-			core_assert(brdf_lut, "Could not find a file under {}", (*brdf_lut).string());
+			if (RendererAPI::current() == RendererAPIType::Null) {
+				// Headless hosts need not run next to the resources; a Null texture does not read its file.
+				renderer_data.brdf_lut = Texture2D::create(brdf_lut ? (*brdf_lut).string() : "renderer/brdf_lut.tga", props);
+			} else {
+				core_assert(brdf_lut, "Could not find a file under {}", (*brdf_lut).string());
 
-			renderer_data.brdf_lut = Texture2D::create((*brdf_lut).string(), props);
+				renderer_data.brdf_lut = Texture2D::create((*brdf_lut).string(), props);
+			}
 		}
 		constexpr uint32_t black_cube_data[6] = { 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000 };
 		renderer_data.black_cube = TextureCube::create(ImageFormat::RGBA, 1, 1, &black_cube_data);
@@ -173,9 +214,43 @@ namespace ForgottenEngine {
 		}
 	}
 
-	void Renderer::wait_and_render() { command_queue().execute(); }
+	void Renderer::wait_and_render()
+	{
+		if (is_multi_threaded()) {
+			// Init, shutdown and shader compilation need their commands done before returning; run them here
+			// rather than handing them over, which would also advance the frame.
+			Application::the().get_render_thread().block_until_rendering_complete();
+		}
+		submission_queue().execute();
+	}
+
+	void Renderer::swap_queues()
+	{
+		submission_queue_index = (submission_queue_index + 1) % 2;
+		// Taken from the slot the render thread is about to execute rather than counted separately, so the two
+		// cannot drift apart when a present is skipped or the swapchain is recreated.
+		main_thread_frame_index = (rt_get_current_frame_index() + 1) % config.frames_in_flight;
+	}
+
+	void Renderer::rt_execute_render_queue() { render_queue().execute(); }
+
+	void Renderer::begin_frame()
+	{
+		const AllocationStats allocations = Memory::get_allocation_stats();
+		frame_stats.heap_allocations = allocations.AllocationCount - frame_start_allocations.AllocationCount;
+		frame_stats.heap_bytes = allocations.TotalAllocated - frame_start_allocations.TotalAllocated;
+		frame_stats.frame_allocator_bytes = get_frame_allocator().get_used();
+		frame_stats.frame_allocator_capacity = get_frame_allocator().get_capacity();
+		frame_start_allocations = allocations;
 
-	void Renderer::begin_frame() { renderer_api->begin_frame(); }
+		frame_allocator_index = (frame_allocator_index + 1) % frame_allocator_count;
+		frame_allocators[frame_allocator_index].reset();
+
+		for (auto* ring : uniform_buffer_rings)
+			ring->begin_frame();
+
+		renderer_api->begin_frame();
+	}
 
 	void Renderer::begin_render_pass(const Reference<RenderCommandBuffer>& command_buffer, Reference<RenderPass> render_pass, bool explicit_clear)
 	{
@@ -196,6 +271,15 @@ namespace ForgottenEngine {
 		return renderer_api->render_geometry(cmd_buffer, pipeline, ubs, sbs, material, vb, ib, transform, index_count);
 	}
 
+	void Renderer::render_instanced_geometry(const Reference<RenderCommandBuffer>& cmd_buffer, const Reference<Pipeline>& pipeline,
+		const Reference<UniformBufferSet>& ubs, const Reference<StorageBufferSet>& sbs, const Reference<Material>& material,
+		const Reference<VertexBuffer>& vb, const Reference<IndexBuffer>& ib, const Reference<VertexBuffer>& instance_vb, const glm::mat4& transform,
+		uint32_t index_count, uint32_t instance_count)
+	{
+		return renderer_api->render_instanced_geometry(
+			cmd_buffer, pipeline, ubs, sbs, material, vb, ib, instance_vb, transform, index_count, instance_count);
+	}
+
 	void Renderer::submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline,
 		const Reference<UniformBufferSet>& uniformBufferSet, const Reference<Material>& material)
 	{
@@ -225,6 +309,10 @@ namespace ForgottenEngine {
 		shader_dependencies[shader->get_hash()].computations.push_back(compute);
 	}
 
+	void Renderer::register_uniform_buffer_ring(UniformBufferRing* ring) { uniform_buffer_rings.push_back(ring); }
+
+	void Renderer::unregister_uniform_buffer_ring(UniformBufferRing* ring) { std::erase(uniform_buffer_rings, ring); }
+
 	void Renderer::on_shader_reloaded(size_t hash)
 	{
 		if (shader_dependencies.find(hash) != shader_dependencies.end()) {
@@ -293,22 +381,56 @@ namespace ForgottenEngine {
 
 	RenderCommandQueue& Renderer::command_queue()
 	{
-		static RenderCommandQueue* cmd;
+		// Commands submitted while executing belong to the batch that is running.
+		return RenderThread::is_render_thread() ? render_queue() : submission_queue();
+	}
 
-		if (!cmd) {
-			cmd = new RenderCommandQueue();
+	static RenderCommandQueue& get_command_queue(uint32_t index)
+	{
+		if (!command_queues[index]) {
+			command_queues[index] = new RenderCommandQueue();
 		}
 
-		return *cmd;
+		return *command_queues[index];
 	}
 
+	RenderCommandQueue& Renderer::submission_queue() { return get_command_queue(submission_queue_index); }
+
+	RenderCommandQueue& Renderer::render_queue() { return get_command_queue((submission_queue_index + 1) % 2); }
+
 	RendererConfig& Renderer::get_config() { return config; }
 
 	Reference<RendererContext> Renderer::get_context() { return Application::the().get_window().get_context(); }
 
 	Reference<ShaderLibrary>& Renderer::get_shader_library() { return renderer_data.shader_library; }
 
-	uint32_t Renderer::get_current_frame_index() { return Application::the().get_window().get_swapchain().get_current_buffer_index(); }
+	uint32_t Renderer::get_current_frame_index()
+	{
+		if (is_multi_threaded())
+			return main_thread_frame_index;
+
+		return rt_get_current_frame_index();
+	}
+
+	uint32_t Renderer::rt_get_current_frame_index()
+	{
+		if (RendererAPI::current() == RendererAPIType::Null)
+			return NullRenderer::get_current_frame_index();
+
+		return Application::the().get_window().get_swapchain().get_current_buffer_index();
+	}
+
+	LinearAllocator& Renderer::get_frame_allocator() { return frame_allocators[frame_allocator_index]; }
+
+	const RendererFrameStats& Renderer::get_frame_stats() { return frame_stats; }
+
+	const RenderCommandQueueStats& Renderer::get_command_queue_stats()
+	{
+		// The queue that executed last; without a render thread the queues are never swapped.
+		return is_multi_threaded() ? render_queue().get_stats() : submission_queue().get_stats();
+	}
+
+	const RendererCapabilities& Renderer::get_capabilities() { return renderer_api->get_capabilities(); }
 
 	Reference<Texture2D> Renderer::get_white_texture() { return renderer_data.white_texture; }
 
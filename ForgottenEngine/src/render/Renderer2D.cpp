@@ -2,22 +2,27 @@
 
 #include "render/Renderer2D.hpp"
 
+#include "render/DynamicFontAtlas.hpp"
 #include "render/Font.hpp"
 #include "render/IndexBuffer.hpp"
 #include "render/Material.hpp"
 #include "render/Mesh.hpp"
-#include "render/MSDFData.hpp"
 #include "render/Pipeline.hpp"
 #include "render/RenderCommandBuffer.hpp"
 #include "render/Renderer.hpp"
+#include "render/Renderer2DContext.hpp"
+#include "render/RendererAPI.hpp"
+#include "render/SpriteAtlas.hpp"
+#include "render/SpriteTransform.hpp"
 #include "render/StorageBuffer.hpp"
 #include "render/StorageBufferSet.hpp"
 #include "render/UniformBuffer.hpp"
+#include "render/UniformBufferRing.hpp"
 #include "render/UniformBufferSet.hpp"
 #include "render/VertexBuffer.hpp"
 
-#include <codecvt>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 
 // TEMP
 #include "vulkan/VulkanRenderCommandBuffer.hpp"
@@ -61,10 +66,12 @@ namespace ForgottenEngine {
 		render_pass_spec.debug_name = "Renderer2D";
 		Reference<RenderPass> render_pass = RenderPass::create(render_pass_spec);
 
+		bindless_textures = Renderer::get_capabilities().bindless_textures;
+
 		{
 			PipelineSpecification pipeline_specification;
 			pipeline_specification.debug_name = "Renderer2D-Quad";
-			pipeline_specification.shader = Renderer::get_shader_library()->get("Renderer2D");
+			pipeline_specification.shader = Renderer::get_shader_library()->get(bindless_textures ? "Renderer2D_Bindless" : "Renderer2D");
 			pipeline_specification.render_pass = render_pass;
 			pipeline_specification.backface_culling = false;
 			pipeline_specification.layout
@@ -72,13 +79,6 @@ namespace ForgottenEngine {
 					  { ShaderDataType::Float, "a_TextureIndex" }, { ShaderDataType::Float, "a_TilingFactor" } };
 			quad_pipeline = Pipeline::create(pipeline_specification);
 
-			quad_vertex_buffer.resize(frames_in_flight);
-			quad_vertex_buffer_base.resize(frames_in_flight);
-			for (uint32_t i = 0; i < frames_in_flight; i++) {
-				quad_vertex_buffer[i] = VertexBuffer::create(max_vertices * sizeof(QuadVertex));
-				quad_vertex_buffer_base[i] = new QuadVertex[max_vertices];
-			}
-
 			auto* quad_indices = new uint32_t[max_indices];
 
 			uint32_t offset = 0;
@@ -94,7 +94,7 @@ namespace ForgottenEngine {
 				offset += 4;
 			}
 
-			quad_index_buffer = IndexBuffer::create(quad_indices, max_indices);
+			quad_index_buffer = IndexBuffer::create(quad_indices, max_indices * sizeof(uint32_t));
 			delete[] quad_indices;
 		}
 
@@ -103,10 +103,29 @@ namespace ForgottenEngine {
 		// set all texture slots to 0
 		texture_slots[0] = white_texture;
 
-		quad_vertex_positions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
-		quad_vertex_positions[1] = { -0.5f, 0.5f, 0.0f, 1.0f };
-		quad_vertex_positions[2] = { 0.5f, 0.5f, 0.0f, 1.0f };
-		quad_vertex_positions[3] = { 0.5f, -0.5f, 0.0f, 1.0f };
+		// Sprites
+		{
+			PipelineSpecification pipeline_specification;
+			pipeline_specification.debug_name = "Renderer2D-Sprite";
+			pipeline_specification.shader
+				= Renderer::get_shader_library()->get(bindless_textures ? "Renderer2D_Sprite_Bindless" : "Renderer2D_Sprite");
+			pipeline_specification.render_pass = render_pass;
+			pipeline_specification.backface_culling = false;
+			pipeline_specification.layout = { { ShaderDataType::Float2, "a_Corner" }, { ShaderDataType::Float2, "a_TexCoord" } };
+			pipeline_specification.instance_layout = { { ShaderDataType::Float3, "a_Position" }, { ShaderDataType::UInt2, "a_Basis" },
+				{ ShaderDataType::UInt2, "a_UVRect" }, { ShaderDataType::UInt, "a_Color" }, { ShaderDataType::UInt, "a_TextureIndex" } };
+			sprite_pipeline = Pipeline::create(pipeline_specification);
+
+			// Same corners and texture coordinates as quad_vertex_positions, so sprites and quads look alike.
+			glm::vec2 corners[] = { { -0.5f, -0.5f }, { 0.0f, 0.0f }, { -0.5f, 0.5f }, { 1.0f, 0.0f }, { 0.5f, 0.5f }, { 1.0f, 1.0f },
+				{ 0.5f, -0.5f }, { 0.0f, 1.0f } };
+			sprite_corner_buffer = VertexBuffer::create(corners, sizeof(corners));
+
+			uint32_t sprite_indices[] = { 0, 1, 2, 2, 3, 0 };
+			sprite_index_buffer = IndexBuffer::create(sprite_indices, sizeof(sprite_indices));
+		}
+
+		sprite_texture_slots[0] = white_texture;
 
 		// Lines
 		{
@@ -121,19 +140,12 @@ namespace ForgottenEngine {
 			pipeline_specification.depth_test = false;
 			line_on_top_pipeline = Pipeline::create(pipeline_specification);
 
-			line_vertex_buffer.resize(frames_in_flight);
-			line_vertex_buffer_base.resize(frames_in_flight);
-			for (uint32_t i = 0; i < frames_in_flight; i++) {
-				line_vertex_buffer[i] = VertexBuffer::create(max_line_vertices * sizeof(LineVertex));
-				line_vertex_buffer_base[i] = new LineVertex[max_line_vertices];
-			}
-
 			auto* line_indices = new uint32_t[max_line_indices];
 			for (uint32_t i = 0; i < max_line_indices; i++) {
 				line_indices[i] = i;
 			}
 
-			line_index_buffer = IndexBuffer::create(line_indices, max_line_indices);
+			line_index_buffer = IndexBuffer::create(line_indices, max_line_indices * sizeof(uint32_t));
 			delete[] line_indices;
 		}
 
@@ -148,14 +160,7 @@ namespace ForgottenEngine {
 				{ ShaderDataType::Float2, "a_TextureCoords" }, { ShaderDataType::Float, "a_TextureIndex" } };
 
 			text_pipeline = Pipeline::create(pipeline_specification);
-			text_material = Material::create(pipeline_specification.shader);
 
-			text_vertex_buffer.resize(frames_in_flight);
-			text_vertex_buffer_base.resize(frames_in_flight);
-			for (uint32_t i = 0; i < frames_in_flight; i++) {
-				text_vertex_buffer[i] = VertexBuffer::create(max_vertices * sizeof(TextVertex));
-				text_vertex_buffer_base[i] = new TextVertex[max_vertices];
-			}
 
 			auto* text_indices = new uint32_t[max_indices];
 
@@ -172,7 +177,7 @@ namespace ForgottenEngine {
 				offset += 4;
 			}
 
-			text_index_buffer = IndexBuffer::create(text_indices, max_indices);
+			text_index_buffer = IndexBuffer::create(text_indices, max_indices * sizeof(uint32_t));
 			delete[] text_indices;
 		}
 
@@ -187,13 +192,6 @@ namespace ForgottenEngine {
 				{ ShaderDataType::Float2, "a_LocalPosition" }, { ShaderDataType::Float4, "a_Color" } };
 			circle_pipeline = Pipeline::create(pipeline_specification);
 			circle_material = Material::create(pipeline_specification.shader);
-
-			circle_vertex_buffer.resize(frames_in_flight);
-			circle_vertex_buffer_base.resize(frames_in_flight);
-			for (uint32_t i = 0; i < frames_in_flight; i++) {
-				circle_vertex_buffer[i] = VertexBuffer::create(max_vertices * sizeof(QuadVertex));
-				circle_vertex_buffer_base[i] = new CircleVertex[max_vertices];
-			}
 		}
 
 		VertexBufferLayout vertex_layout = { { ShaderDataType::Float3, "a_Position" }, { ShaderDataType::Float3, "a_Normal" },
@@ -213,35 +211,23 @@ namespace ForgottenEngine {
 		Renderer::compile_shaders();
 
 		uniform_buffer_set = UniformBufferSet::create(frames_in_flight);
-		uniform_buffer_set->create(sizeof(UBCamera), 0);
+		camera_ring = UniformBufferRing::create(sizeof(UBCamera), max_scenes_per_frame, 0);
+		uniform_buffer_set->set_ring(camera_ring);
+
+		// The first batch of each kind always exists; later ones are created when a scene overflows.
+		ensure_quad_batch(0);
+		ensure_sprite_batch(0);
+		ensure_batch(line_batches, 0, max_line_vertices);
+		ensure_batch(circle_batches, 0, max_vertices);
+		ensure_text_batch(0);
 
-		quad_material = Material::create(quad_pipeline->get_specification().shader, "QuadMaterial");
 		line_material = Material::create(line_pipeline->get_specification().shader, "LineMaterial");
 	}
 
-	void Renderer2D::shut_down()
-	{
-		for (auto buffer : quad_vertex_buffer_base) {
-			delete[] buffer;
-		}
-
-		for (auto buffer : text_vertex_buffer_base) {
-			delete[] buffer;
-		}
-
-		for (auto buffer : line_vertex_buffer_base) {
-			delete[] buffer;
-		}
-
-		for (auto buffer : circle_vertex_buffer_base) {
-			delete[] buffer;
-		}
-	}
+	void Renderer2D::shut_down() { contexts.clear(); }
 
 	void Renderer2D::begin_scene(const glm::mat4& view_proj, const glm::mat4& view, bool in_depth_test)
 	{
-		uint32_t frame_index = Renderer::get_current_frame_index();
-
 		// Dirty shader impl
 		// --------------------
 		// end dirty shader impl
@@ -249,23 +235,29 @@ namespace ForgottenEngine {
 		camera_view = view;
 		depth_test = in_depth_test;
 
-		Renderer::submit([ubs = uniform_buffer_set, view_proj]() mutable {
-			uint32_t buffer_index = Renderer::get_current_frame_index();
-			auto ub = ubs->get(0, 0, buffer_index);
-			ub->render_thread_set_data(&view_proj, sizeof(UBCamera), 0);
-		});
+		const UBCamera camera { view_proj };
+		camera_ring->push(&camera, sizeof(UBCamera));
 
+		// Each batch's vertices go into this frame's region of its buffer.
+		quad_batch_index = 0;
 		quad_index_count = 0;
-		quad_vertex_buffer_ptr = quad_vertex_buffer_base[frame_index];
+		quad_vertex_buffer_ptr = ensure_quad_batch(0).vertex_base;
 
+		sprite_batch_index = 0;
+		sprite_instance_buffer_ptr = ensure_sprite_batch(0).vertex_base;
+
+		text_batch_index = 0;
 		text_index_count = 0;
-		text_vertex_buffer_ptr = text_vertex_buffer_base[frame_index];
+		text_layout_cache.new_frame();
+		text_vertex_buffer_ptr = ensure_text_batch(0).vertex_base;
 
+		line_batch_index = 0;
 		line_index_count = 0;
-		line_vertex_buffer_ptr = line_vertex_buffer_base[frame_index];
+		line_vertex_buffer_ptr = ensure_batch(line_batches, 0, max_line_vertices).vertex_base;
 
+		circle_batch_index = 0;
 		circle_index_count = 0;
-		circle_vertex_buffer_ptr = circle_vertex_buffer_base[frame_index];
+		circle_vertex_buffer_ptr = ensure_batch(circle_batches, 0, max_vertices).vertex_base;
 
 		texture_slot_index = 1;
 		font_texture_slot_index = 0;
@@ -274,79 +266,151 @@ namespace ForgottenEngine {
 			texture_slots[i] = nullptr;
 		}
 
+		sprite_texture_slot_index = 1;
+		for (uint32_t i = 1; i < sprite_texture_slots.size(); i++) {
+			sprite_texture_slots[i] = nullptr;
+		}
+
 		for (auto& font_texture_slot : font_texture_slots) {
 			font_texture_slot = nullptr;
 		}
+		for (auto& font_texture_page : font_texture_pages) {
+			font_texture_page = {};
+		}
+
+		open_context_count = 0;
 	}
 
 	void Renderer2D::end_scene()
 	{
-		uint32_t frame_index = Renderer::get_current_frame_index();
+		merge_contexts();
+
+		// Close the batches that were still being written to.
+		{
+			auto& batch = quad_batches[quad_batch_index];
+			batch.vertex_count = (uint32_t)(quad_vertex_buffer_ptr - batch.vertex_base);
+			batch.index_count = quad_index_count;
+			batch.texture_slots = texture_slots;
+		}
+		{
+			auto& batch = sprite_batches[sprite_batch_index];
+			batch.vertex_count = (uint32_t)(sprite_instance_buffer_ptr - batch.vertex_base);
+			batch.texture_slots = sprite_texture_slots;
+		}
+		line_batches[line_batch_index].vertex_count = (uint32_t)(line_vertex_buffer_ptr - line_batches[line_batch_index].vertex_base);
+		line_batches[line_batch_index].index_count = line_index_count;
+		circle_batches[circle_batch_index].vertex_count = (uint32_t)(circle_vertex_buffer_ptr - circle_batches[circle_batch_index].vertex_base);
+		circle_batches[circle_batch_index].index_count = circle_index_count;
+		{
+			auto& batch = text_batches[text_batch_index];
+			batch.vertex_count = (uint32_t)(text_vertex_buffer_ptr - batch.vertex_base);
+			batch.index_count = text_index_count;
+			batch.texture_slots = font_texture_slots;
+			batch.texture_pages = font_texture_pages;
+		}
 
 		render_command_buffer->begin();
 		Renderer::begin_render_pass(render_command_buffer, quad_pipeline->get_specification().render_pass, false);
 
-		auto data_size = quad_vertex_buffer_ptr - quad_vertex_buffer_base[frame_index];
-		if (data_size) {
-			quad_vertex_buffer[frame_index]->set_data(quad_vertex_buffer_base[frame_index], data_size);
+		for (uint32_t i = 0; i <= quad_batch_index; i++) {
+			auto& batch = quad_batches[i];
+			if (!batch.index_count)
+				continue;
 
-			for (uint32_t i = 0; i < texture_slots.size(); i++) {
-				if (texture_slots[i]) {
-					quad_material->set("u_Textures", texture_slots[i], i);
-				} else {
-					quad_material->set("u_Textures", white_texture, i);
-				}
-			}
+			if (!bindless_textures)
+				set_texture_slots(batch.material, batch.texture_slots);
 
-			Renderer::render_geometry(render_command_buffer, quad_pipeline, uniform_buffer_set, nullptr, quad_material,
-				quad_vertex_buffer[frame_index], quad_index_buffer, glm::mat4(1.0f), quad_index_count);
+			Renderer::render_geometry(render_command_buffer, quad_pipeline, uniform_buffer_set, nullptr, batch.material,
+				batch.vertex_buffer, quad_index_buffer, glm::mat4(1.0f), batch.index_count);
 
 			stats.draw_calls++;
+			stats.batch_count++;
+		}
+
+		// Sprites
+		for (uint32_t i = 0; i <= sprite_batch_index; i++) {
+			auto& batch = sprite_batches[i];
+			if (!batch.vertex_count)
+				continue;
+
+			if (!bindless_textures)
+				set_texture_slots(batch.material, batch.texture_slots);
+
+			Renderer::render_instanced_geometry(render_command_buffer, sprite_pipeline, uniform_buffer_set, nullptr, batch.material,
+				sprite_corner_buffer, sprite_index_buffer, batch.vertex_buffer, glm::mat4(1.0f), 6, batch.vertex_count);
+
+			stats.draw_calls++;
+			stats.batch_count++;
 		}
 
 		// Render text
-		data_size = (uint32_t)((uint8_t*)text_vertex_buffer_ptr - (uint8_t*)text_vertex_buffer_base[frame_index]);
-		if (data_size) {
-			text_vertex_buffer[frame_index]->set_data(text_vertex_buffer_base[frame_index], data_size);
-
-			for (uint32_t i = 0; i < font_texture_slots.size(); i++) {
-				if (font_texture_slots[i]) {
-					text_material->set("u_FontAtlases", font_texture_slots[i], i);
-				} else {
-					text_material->set("u_FontAtlases", white_texture, i);
+		if (text_index_count || text_batch_index) {
+			// Glyphs generated this frame are only on the CPU so far; upload each atlas once, then bind what came of its pages.
+			scene_atlases.clear();
+			for (uint32_t i = 0; i <= text_batch_index; i++) {
+				for (auto& [atlas, page] : text_batches[i].texture_pages) {
+					if (atlas && std::find(scene_atlases.begin(), scene_atlases.end(), atlas.raw()) == scene_atlases.end()) {
+						atlas->update();
+						scene_atlases.push_back(atlas.raw());
+					}
 				}
 			}
 
-			Renderer::render_geometry(render_command_buffer, text_pipeline, uniform_buffer_set, nullptr, text_material,
-				text_vertex_buffer[frame_index], text_index_buffer, glm::mat4(1.0f), text_index_count);
+			for (uint32_t i = 0; i <= text_batch_index; i++) {
+				auto& batch = text_batches[i];
+				if (!batch.index_count)
+					continue;
 
-			stats.draw_calls++;
+				for (uint32_t slot = 0; slot < batch.texture_slots.size(); slot++) {
+					auto& [atlas, page] = batch.texture_pages[slot];
+					if (atlas)
+						batch.texture_slots[slot] = atlas->get_page_texture(page);
+
+					batch.material->set("u_FontAtlases", batch.texture_slots[slot] ? batch.texture_slots[slot] : white_texture, slot);
+				}
+
+				Renderer::render_geometry(render_command_buffer, text_pipeline, uniform_buffer_set, nullptr, batch.material,
+					batch.vertex_buffer, text_index_buffer, glm::mat4(1.0f), batch.index_count);
+
+				stats.draw_calls++;
+				stats.batch_count++;
+			}
+
+			for (auto* atlas : scene_atlases)
+				atlas->new_frame(); // Only after every batch has bound its pages: they may be evicted again now.
 		}
 
 		// Lines
-		data_size = (uint32_t)((uint8_t*)line_vertex_buffer_ptr - (uint8_t*)line_vertex_buffer_base[frame_index]);
-		if (data_size) {
-			line_vertex_buffer[frame_index]->set_data(line_vertex_buffer_base[frame_index], data_size);
-
-			Renderer::submit([line_width = line_width, render_command_buffer = render_command_buffer]() {
-				uint32_t index = Renderer::get_current_frame_index();
-				VkCommandBuffer command_buffer = render_command_buffer.as<VulkanRenderCommandBuffer>()->get_command_buffer(index);
-				vkCmdSetLineWidth(command_buffer, line_width);
-			});
+		for (uint32_t i = 0; i <= line_batch_index; i++) {
+			auto& batch = line_batches[i];
+			if (!batch.index_count)
+				continue;
+
+			if (RendererAPI::current() == RendererAPIType::Vulkan) {
+				Renderer::submit([line_width = line_width, render_command_buffer = render_command_buffer]() {
+					uint32_t index = Renderer::rt_get_current_frame_index();
+					VkCommandBuffer command_buffer = render_command_buffer.as<VulkanRenderCommandBuffer>()->get_command_buffer(index);
+					vkCmdSetLineWidth(command_buffer, line_width);
+				});
+			}
 			Renderer::render_geometry(render_command_buffer, line_pipeline, uniform_buffer_set, nullptr, line_material,
-				line_vertex_buffer[frame_index], line_index_buffer, glm::mat4(1.0f), line_index_count);
+				batch.vertex_buffer, line_index_buffer, glm::mat4(1.0f), batch.index_count);
 
 			stats.draw_calls++;
+			stats.batch_count++;
 		}
 
 		// Circles
-		data_size = (uint32_t)((uint8_t*)circle_vertex_buffer_ptr - (uint8_t*)circle_vertex_buffer_base[frame_index]);
-		if (data_size) {
-			circle_vertex_buffer[frame_index]->set_data(circle_vertex_buffer_base[frame_index], data_size);
+		for (uint32_t i = 0; i <= circle_batch_index; i++) {
+			auto& batch = circle_batches[i];
+			if (!batch.index_count)
+				continue;
+
 			Renderer::render_geometry(render_command_buffer, circle_pipeline, uniform_buffer_set, nullptr, circle_material,
-				circle_vertex_buffer[frame_index], quad_index_buffer, glm::mat4(1.0f), circle_index_count);
+				batch.vertex_buffer, quad_index_buffer, glm::mat4(1.0f), batch.index_count);
 
 			stats.draw_calls++;
+			stats.batch_count++;
 		}
 
 		Renderer::end_render_pass(render_command_buffer);
@@ -356,6 +420,92 @@ namespace ForgottenEngine {
 
 	void Renderer2D::flush() { }
 
+	Renderer2DContext& Renderer2D::open_context(uint64_t order_key)
+	{
+		std::scoped_lock lock(context_mutex);
+
+		if (open_context_count == contexts.size())
+			contexts.push_back(std::make_unique<Renderer2DContext>(bindless_textures));
+
+		auto& context = *contexts[open_context_count++];
+		context.reset(order_key);
+		return context;
+	}
+
+	void Renderer2D::merge_contexts()
+	{
+		std::scoped_lock lock(context_mutex);
+
+		const auto open_contexts = std::span(contexts).first(open_context_count);
+		std::sort(open_contexts.begin(), open_contexts.end(), [](const auto& a, const auto& b) { return a->get_order_key() < b->get_order_key(); });
+
+		for (const auto& context : open_contexts) {
+			merge_quads(*context);
+			merge_sprites(*context);
+		}
+
+		open_context_count = 0;
+	}
+
+	void Renderer2D::merge_quads(const Renderer2DContext& context)
+	{
+		std::span<const QuadVertex> vertices = context.get_quad_vertices();
+		stats.quad_count += (uint32_t)(vertices.size() / 4);
+
+		while (!vertices.empty()) {
+			if (quad_index_count >= max_indices) {
+				flush_and_reset();
+			}
+
+			if (bindless_textures) {
+				// The indices are already the textures' own, so whole runs are copied.
+				const size_t count = std::min<size_t>(vertices.size(), (max_indices - quad_index_count) / 6 * 4);
+				quad_vertex_buffer_ptr = std::copy_n(vertices.data(), count, quad_vertex_buffer_ptr);
+				quad_index_count += (uint32_t)(count / 4 * 6);
+				vertices = vertices.subspan(count);
+				continue;
+			}
+
+			const auto local_index = (uint32_t)vertices[0].TextureIndex;
+			const float texture_index = local_index ? get_quad_texture_index(context.get_texture(local_index)) : 0.0f;
+
+			for (size_t i = 0; i < 4; i++) {
+				*quad_vertex_buffer_ptr = vertices[i];
+				quad_vertex_buffer_ptr->TextureIndex = texture_index;
+				quad_vertex_buffer_ptr++;
+			}
+			quad_index_count += 6;
+			vertices = vertices.subspan(4);
+		}
+	}
+
+	void Renderer2D::merge_sprites(const Renderer2DContext& context)
+	{
+		std::span<const QuadInstance> instances = context.get_sprite_instances();
+		stats.quad_count += (uint32_t)instances.size();
+
+		while (!instances.empty()) {
+			if (sprite_instance_buffer_ptr - sprite_batches[sprite_batch_index].vertex_base >= max_quads) {
+				flush_and_reset_sprites();
+			}
+
+			if (bindless_textures) {
+				const size_t written = sprite_instance_buffer_ptr - sprite_batches[sprite_batch_index].vertex_base;
+				const size_t count = std::min<size_t>(instances.size(), max_quads - written);
+				sprite_instance_buffer_ptr = std::copy_n(instances.data(), count, sprite_instance_buffer_ptr);
+				instances = instances.subspan(count);
+				continue;
+			}
+
+			const uint32_t local_index = instances[0].TextureIndex;
+
+			*sprite_instance_buffer_ptr = instances[0];
+			sprite_instance_buffer_ptr->TextureIndex = local_index ? get_sprite_texture_index(context.get_texture(local_index)) : 0;
+			sprite_instance_buffer_ptr++;
+			instances = instances.subspan(1);
+		}
+	}
+
 	Reference<RenderPass> Renderer2D::get_target_render_pass() { return quad_pipeline->get_specification().render_pass; }
 
 	void Renderer2D::set_target_render_pass(const Reference<RenderPass>& render_pass)
@@ -367,6 +517,12 @@ namespace ForgottenEngine {
 				quad_pipeline = Pipeline::create(pipeline_specification);
 			}
 
+			{
+				PipelineSpecification pipeline_specification = sprite_pipeline->get_specification();
+				pipeline_specification.render_pass = render_pass;
+				sprite_pipeline = Pipeline::create(pipeline_specification);
+			}
+
 			{
 				PipelineSpecification pipeline_specification = line_pipeline->get_specification();
 				pipeline_specification.render_pass = render_pass;
@@ -388,81 +544,268 @@ namespace ForgottenEngine {
 		}
 	}
 
+	template <typename BatchType>
+	BatchType& Renderer2D::ensure_batch(std::vector<BatchType>& batches, uint32_t batch_index, uint32_t max_vertex_count)
+	{
+		using Vertex = typename BatchType::VertexType;
+
+		while (batches.size() <= batch_index) {
+			auto& batch = batches.emplace_back();
+			batch.vertex_buffer = VertexBuffer::create(max_vertex_count * sizeof(Vertex), VertexBufferUsage::Stream);
+		}
+
+		auto& batch = batches[batch_index];
+		batch.vertex_base = (Vertex*)batch.vertex_buffer->get_mapped_region(Renderer::get_current_frame_index());
+		return batch;
+	}
+
+	Renderer2D::QuadBatch& Renderer2D::ensure_quad_batch(uint32_t batch_index)
+	{
+		auto& batch = ensure_batch(quad_batches, batch_index, max_vertices);
+		if (!batch.material)
+			batch.material = Material::create(quad_pipeline->get_specification().shader, "QuadMaterial");
+		return batch;
+	}
+
+	Renderer2D::SpriteBatch& Renderer2D::ensure_sprite_batch(uint32_t batch_index)
+	{
+		auto& batch = ensure_batch(sprite_batches, batch_index, max_quads);
+		if (!batch.material)
+			batch.material = Material::create(sprite_pipeline->get_specification().shader, "SpriteMaterial");
+		return batch;
+	}
+
+	Renderer2D::TextBatch& Renderer2D::ensure_text_batch(uint32_t batch_index)
+	{
+		auto& batch = ensure_batch(text_batches, batch_index, max_vertices);
+		if (!batch.material)
+			batch.material = Material::create(text_pipeline->get_specification().shader, "TextMaterial");
+		return batch;
+	}
+
+	void Renderer2D::set_texture_slots(const Reference<Material>& material, const std::array<Reference<Texture2D>, max_texture_slots>& slots)
+	{
+		for (uint32_t slot = 0; slot < slots.size(); slot++) {
+			if (slots[slot]) {
+				material->set("u_Textures", slots[slot], slot);
+			} else {
+				material->set("u_Textures", white_texture, slot);
+			}
+		}
+	}
+
 	void Renderer2D::flush_and_reset()
 	{
-		uint32_t frame_index = Renderer::get_current_frame_index();
-		// end_scene();
+		{
+			auto& batch = quad_batches[quad_batch_index];
+			batch.vertex_count = (uint32_t)(quad_vertex_buffer_ptr - batch.vertex_base);
+			batch.index_count = quad_index_count;
+			batch.texture_slots = texture_slots;
+		}
 
+		quad_batch_index++;
 		quad_index_count = 0;
-		quad_vertex_buffer_ptr = quad_vertex_buffer_base[frame_index];
+		quad_vertex_buffer_ptr = ensure_quad_batch(quad_batch_index).vertex_base;
 
 		texture_slot_index = 1;
+		for (uint32_t i = 1; i < texture_slots.size(); i++) {
+			texture_slots[i] = nullptr;
+		}
 	}
 
-	void Renderer2D::flush_and_reset_lines() { }
+	void Renderer2D::flush_and_reset_lines()
+	{
+		line_batches[line_batch_index].vertex_count = (uint32_t)(line_vertex_buffer_ptr - line_batches[line_batch_index].vertex_base);
+		line_batches[line_batch_index].index_count = line_index_count;
 
-	void Renderer2D::draw_quad(const glm::mat4& transform, const glm::vec4& color)
+		line_batch_index++;
+		line_index_count = 0;
+		line_vertex_buffer_ptr = ensure_batch(line_batches, line_batch_index, max_line_vertices).vertex_base;
+	}
+
+	void Renderer2D::flush_and_reset_circles()
 	{
-		static constexpr size_t quad_vertex_count = 4;
-		static const float texture_index = 0.0f; // White Texture
-		static constexpr glm::vec2 texture_coords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		static const float tiling_factor = 1.0f;
+		circle_batches[circle_batch_index].vertex_count = (uint32_t)(circle_vertex_buffer_ptr - circle_batches[circle_batch_index].vertex_base);
+		circle_batches[circle_batch_index].index_count = circle_index_count;
 
-		if (quad_index_count >= max_indices) {
+		circle_batch_index++;
+		circle_index_count = 0;
+		circle_vertex_buffer_ptr = ensure_batch(circle_batches, circle_batch_index, max_vertices).vertex_base;
+	}
+
+	void Renderer2D::flush_and_reset_text()
+	{
+		{
+			auto& batch = text_batches[text_batch_index];
+			batch.vertex_count = (uint32_t)(text_vertex_buffer_ptr - batch.vertex_base);
+			batch.index_count = text_index_count;
+			batch.texture_slots = font_texture_slots;
+			batch.texture_pages = font_texture_pages;
+		}
+
+		text_batch_index++;
+		text_index_count = 0;
+		text_vertex_buffer_ptr = ensure_text_batch(text_batch_index).vertex_base;
+
+		font_texture_slot_index = 0;
+		for (uint32_t i = 0; i < font_texture_slots.size(); i++) {
+			font_texture_slots[i] = nullptr;
+			font_texture_pages[i] = {};
+		}
+	}
+
+	void Renderer2D::flush_and_reset_sprites()
+	{
+		{
+			auto& batch = sprite_batches[sprite_batch_index];
+			batch.vertex_count = (uint32_t)(sprite_instance_buffer_ptr - batch.vertex_base);
+			batch.texture_slots = sprite_texture_slots;
+		}
+
+		sprite_batch_index++;
+		sprite_instance_buffer_ptr = ensure_sprite_batch(sprite_batch_index).vertex_base;
+
+		sprite_texture_slot_index = 1;
+		for (uint32_t i = 1; i < sprite_texture_slots.size(); i++) {
+			sprite_texture_slots[i] = nullptr;
+		}
+	}
+
+	float Renderer2D::get_quad_texture_index(const Reference<Texture2D>& texture)
+	{
+		if (bindless_textures)
+			return (float)texture->get_bindless_index();
+
+		const ResourceHandle<Texture2D> handle = texture->get_handle();
+		for (uint32_t i = 1; i < texture_slot_index; i++) {
+			if (texture_slot_handles[i] == handle)
+				return (float)i;
+		}
+
+		if (texture_slot_index >= max_texture_slots)
 			flush_and_reset();
+
+		texture_slots[texture_slot_index] = texture;
+		texture_slot_handles[texture_slot_index] = handle;
+		return (float)texture_slot_index++;
+	}
+
+	uint32_t Renderer2D::get_sprite_texture_index(const Reference<Texture2D>& texture)
+	{
+		if (bindless_textures)
+			return texture->get_bindless_index();
+
+		const ResourceHandle<Texture2D> handle = texture->get_handle();
+		for (uint32_t i = 1; i < sprite_texture_slot_index; i++) {
+			if (sprite_texture_slot_handles[i] == handle)
+				return i;
 		}
 
-		for (size_t i = 0; i < quad_vertex_count; i++) {
-			quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[i];
-			quad_vertex_buffer_ptr->Color = color;
-			quad_vertex_buffer_ptr->TextureCoords = texture_coords[i];
-			quad_vertex_buffer_ptr->TextureIndex = texture_index;
-			quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-			quad_vertex_buffer_ptr++;
+		if (sprite_texture_slot_index >= max_texture_slots)
+			flush_and_reset_sprites();
+
+		sprite_texture_slots[sprite_texture_slot_index] = texture;
+		sprite_texture_slot_handles[sprite_texture_slot_index] = handle;
+		return sprite_texture_slot_index++;
+	}
+
+	Renderer2D::QuadInstance Renderer2D::make_quad_instance(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color,
+		uint32_t texture_index, const glm::vec4& uv_rect)
+	{
+		const float cos_rotation = std::cos(rotation);
+		const float sin_rotation = std::sin(rotation);
+
+		QuadInstance instance;
+		instance.Position = position;
+		instance.Basis[0] = glm::packHalf2x16(glm::vec2 { cos_rotation, sin_rotation } * size.x);
+		instance.Basis[1] = glm::packHalf2x16(glm::vec2 { -sin_rotation, cos_rotation } * size.y);
+		instance.UVRect[0] = glm::packUnorm2x16(glm::vec2 { uv_rect.x, uv_rect.y });
+		instance.UVRect[1] = glm::packUnorm2x16(glm::vec2 { uv_rect.z, uv_rect.w });
+		instance.Color = glm::packUnorm4x8(color);
+		instance.TextureIndex = texture_index;
+		return instance;
+	}
+
+	void Renderer2D::draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
+	{
+		if (sprite_instance_buffer_ptr - sprite_batches[sprite_batch_index].vertex_base >= max_quads) {
+			flush_and_reset_sprites();
 		}
 
-		quad_index_count += 6;
+		// Slot 0 is the white texture.
+		*sprite_instance_buffer_ptr++ = make_quad_instance(position, size, rotation, color, 0, { 0.0f, 0.0f, 1.0f, 1.0f });
 
 		stats.quad_count++;
 	}
 
-	void Renderer2D::draw_quad(const glm::mat4& transform, const Reference<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	void Renderer2D::draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+		const glm::vec4& uv_rect, const glm::vec4& tint_color)
+	{
+		if (sprite_instance_buffer_ptr - sprite_batches[sprite_batch_index].vertex_base >= max_quads) {
+			flush_and_reset_sprites();
+		}
+
+		const uint32_t texture_index = get_sprite_texture_index(texture);
+		*sprite_instance_buffer_ptr++ = make_quad_instance(position, size, rotation, tint_color, texture_index, uv_rect);
+
+		stats.quad_count++;
+	}
+
+	Renderer2D::QuadVertex* Renderer2D::write_quad_vertices(
+		QuadVertex* destination, const glm::mat4& transform, const glm::vec4& color, float texture_index, float tiling_factor)
 	{
-		static constexpr size_t quad_vertex_count = 4;
-		static constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
 		static constexpr glm::vec2 texture_coords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
 
+		for (size_t i = 0; i < 4; i++) {
+			destination->Position = transform * quad_vertex_positions[i];
+			destination->Color = color;
+			destination->TextureCoords = texture_coords[i];
+			destination->TextureIndex = texture_index;
+			destination->TilingFactor = tiling_factor;
+			destination++;
+		}
+		return destination;
+	}
+
+	Renderer2D::QuadVertex* Renderer2D::write_quad_vertices(
+		QuadVertex* destination, const glm::mat4& transform, const glm::vec4& color, float texture_index, const glm::vec4& uv_rect)
+	{
+		const glm::vec2 texture_coords[]
+			= { { uv_rect.x, uv_rect.y }, { uv_rect.z, uv_rect.y }, { uv_rect.z, uv_rect.w }, { uv_rect.x, uv_rect.w } };
+
+		for (size_t i = 0; i < 4; i++) {
+			destination->Position = transform * quad_vertex_positions[i];
+			destination->Color = color;
+			destination->TextureCoords = texture_coords[i];
+			destination->TextureIndex = texture_index;
+			destination->TilingFactor = 1.0f;
+			destination++;
+		}
+		return destination;
+	}
+
+	void Renderer2D::draw_quad(const glm::mat4& transform, const glm::vec4& color)
+	{
 		if (quad_index_count >= max_indices) {
 			flush_and_reset();
 		}
 
-		float texture_index = 0.0f;
-		for (uint32_t i = 1; i < texture_slot_index; i++) {
-			if (texture_slots[i]->get_hash() == texture->get_hash()) {
-				texture_index = (float)i;
-				break;
-			}
-		}
+		// Slot 0 is the white texture.
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, color, 0.0f, 1.0f);
+		quad_index_count += 6;
 
-		if (texture_index == 0.0f) {
-			if (texture_slot_index >= max_texture_slots) {
-				flush_and_reset();
-			}
+		stats.quad_count++;
+	}
 
-			texture_index = (float)texture_slot_index;
-			texture_slots[texture_slot_index] = texture;
-			texture_slot_index++;
+	void Renderer2D::draw_quad(const glm::mat4& transform, const Reference<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+	{
+		if (quad_index_count >= max_indices) {
+			flush_and_reset();
 		}
 
-		for (size_t i = 0; i < quad_vertex_count; i++) {
-			quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[i];
-			quad_vertex_buffer_ptr->Color = color;
-			quad_vertex_buffer_ptr->TextureCoords = texture_coords[i];
-			quad_vertex_buffer_ptr->TextureIndex = texture_index;
-			quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-			quad_vertex_buffer_ptr++;
-		}
+		const float texture_index = get_quad_texture_index(texture);
 
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tintColor, texture_index, tilingFactor);
 		quad_index_count += 6;
 
 		stats.quad_count++;
@@ -479,39 +822,10 @@ namespace ForgottenEngine {
 			flush_and_reset();
 		}
 
-		const float texture_index = 0.0f; // White Texture
-		const float tiling_factor = 1.0f;
-
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[0];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[1];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[2];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[3];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
+		// Slot 0 is the white texture.
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, color, 0.0f, 1.0f);
 		quad_index_count += 6;
 
 		stats.quad_count++;
@@ -530,101 +844,33 @@ namespace ForgottenEngine {
 			flush_and_reset();
 		}
 
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		float texture_index = 0.0f;
-		for (uint32_t i = 1; i < texture_slot_index; i++) {
-			if (*texture_slots[i].raw() == *texture.raw()) {
-				texture_index = (float)i;
-				break;
-			}
-		}
-
-		if (texture_index == 0.0f) {
-			texture_index = (float)texture_slot_index;
-			texture_slots[texture_slot_index] = texture;
-			texture_slot_index++;
-		}
+		const float texture_index = get_quad_texture_index(texture);
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[0];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[1];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[2];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[3];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tintColor, texture_index, tilingFactor);
 		quad_index_count += 6;
 
 		stats.quad_count++;
 	}
 
+	glm::mat4 Renderer2D::get_billboard_transform(const glm::vec3& position, const glm::vec2& size) const
+	{
+		// The quad's x and y axes are the camera's right and up vectors, so it always faces the camera.
+		const glm::vec3 cam_right_ws = { camera_view[0][0], camera_view[1][0], camera_view[2][0] };
+		const glm::vec3 cam_up_ws = { camera_view[0][1], camera_view[1][1], camera_view[2][1] };
+		return { glm::vec4(cam_right_ws * size.x, 0.0f), glm::vec4(cam_up_ws * size.y, 0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+			glm::vec4(position, 1.0f) };
+	}
+
 	void Renderer2D::draw_quad_billboard(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
 	{
 		if (quad_index_count >= max_indices) {
 			flush_and_reset();
 		}
 
-		const float texture_index = 0.0f; // White Texture
-		const float tiling_factor = 1.0f;
-
-		glm::vec3 cam_right_ws = { camera_view[0][0], camera_view[1][0], camera_view[2][0] };
-		glm::vec3 cam_up_ws = { camera_view[0][1], camera_view[1][1], camera_view[2][1] };
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * (quad_vertex_positions[0].x) * size.x + cam_up_ws * quad_vertex_positions[0].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[1].x * size.x + cam_up_ws * quad_vertex_positions[1].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[2].x * size.x + cam_up_ws * quad_vertex_positions[2].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[3].x * size.x + cam_up_ws * quad_vertex_positions[3].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
+		// Slot 0 is the white texture.
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, get_billboard_transform(position, size), color, 0.0f, 1.0f);
 		quad_index_count += 6;
 
 		stats.quad_count++;
@@ -637,57 +883,15 @@ namespace ForgottenEngine {
 			flush_and_reset();
 		}
 
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
-
-		float texture_index = 0.0f;
-		for (uint32_t i = 1; i < texture_slot_index; i++) {
-			if (texture_slots[i]->get_hash() == texture->get_hash()) {
-				texture_index = (float)i;
-				break;
-			}
-		}
-
-		if (texture_index == 0.0f) {
-			texture_index = (float)texture_slot_index;
-			texture_slots[texture_slot_index] = texture;
-			texture_slot_index++;
-		}
+		const float texture_index = get_quad_texture_index(texture);
 
-		glm::vec3 cam_right_ws = { camera_view[0][0], camera_view[1][0], camera_view[2][0] };
-		glm::vec3 cam_up_ws = { camera_view[0][1], camera_view[1][1], camera_view[2][1] };
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * (quad_vertex_positions[0].x) * size.x + cam_up_ws * quad_vertex_positions[0].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[1].x * size.x + cam_up_ws * quad_vertex_positions[1].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[2].x * size.x + cam_up_ws * quad_vertex_positions[2].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position
-			= position + cam_right_ws * quad_vertex_positions[3].x * size.x + cam_up_ws * quad_vertex_positions[3].y * size.y;
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
+		// Textured billboards have always had their texture coordinates a quarter turn from other quads'; turning
+		// the corners the other way keeps them as they were.
+		static const glm::mat4 quarter_turn = { { 0.0f, -1.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f, 0.0f },
+			{ 0.0f, 0.0f, 0.0f, 1.0f } };
+		const glm::mat4 transform = get_billboard_transform(position, size) * quarter_turn;
 
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tintColor, texture_index, tilingFactor);
 		quad_index_count += 6;
 
 		stats.quad_count++;
@@ -704,40 +908,11 @@ namespace ForgottenEngine {
 			flush_and_reset();
 		}
 
-		static constexpr float texture_index = 0.0f; // White Texture
-		static constexpr float tiling_factor = 1.0f;
-
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[0];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[1];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[2];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[3];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = texture_index;
-		quad_vertex_buffer_ptr->TilingFactor = tiling_factor;
-		quad_vertex_buffer_ptr++;
-
+		// Slot 0 is the white texture.
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, color, 0.0f, 1.0f);
 		quad_index_count += 6;
 
 		stats.quad_count++;
@@ -756,58 +931,91 @@ namespace ForgottenEngine {
 			flush_and_reset();
 		}
 
-		constexpr glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		const float texture_index = get_quad_texture_index(texture);
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < texture_slot_index; i++) {
-			if (texture_slots[i]->get_hash() == texture->get_hash()) {
-				textureIndex = (float)i;
-				break;
-			}
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tintColor, texture_index, tilingFactor);
+		quad_index_count += 6;
+
+		stats.quad_count++;
+	}
+
+	void Renderer2D::draw_quad(const glm::vec3& position, const glm::vec2& size, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		if (quad_index_count >= max_indices) {
+			flush_and_reset();
 		}
 
-		if (textureIndex == 0.0f) {
-			textureIndex = (float)texture_slot_index;
-			texture_slots[texture_slot_index] = texture;
-			texture_slot_index++;
+		const float texture_index = get_quad_texture_index(region.texture);
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tint_color, texture_index, region.uv_rect);
+		quad_index_count += 6;
+
+		stats.quad_count++;
+	}
+
+	void Renderer2D::draw_rotated_quad(
+		const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		if (quad_index_count >= max_indices) {
+			flush_and_reset();
 		}
 
+		const float texture_index = get_quad_texture_index(region.texture);
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
 			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[0];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = textureIndex;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[1];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 0.0f };
-		quad_vertex_buffer_ptr->TextureIndex = textureIndex;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[2];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 1.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = textureIndex;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
-		quad_vertex_buffer_ptr->Position = transform * quad_vertex_positions[3];
-		quad_vertex_buffer_ptr->Color = color;
-		quad_vertex_buffer_ptr->TextureCoords = { 0.0f, 1.0f };
-		quad_vertex_buffer_ptr->TextureIndex = textureIndex;
-		quad_vertex_buffer_ptr->TilingFactor = tilingFactor;
-		quad_vertex_buffer_ptr++;
-
+		quad_vertex_buffer_ptr = write_quad_vertices(quad_vertex_buffer_ptr, transform, tint_color, texture_index, region.uv_rect);
 		quad_index_count += 6;
 
 		stats.quad_count++;
 	}
 
+	void Renderer2D::draw_sprite(
+		const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		draw_sprite(position, size, rotation, region.texture, region.uv_rect, tint_color);
+	}
+
+	std::span<const SpriteInstance> Renderer2D::write_quads(std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor)
+	{
+		const size_t count = std::min<size_t>(sprites.size(), (max_indices - quad_index_count) / 6);
+
+		quad_vertex_buffer_ptr = SpriteTransform::write_quad_vertices(quad_vertex_buffer_ptr, sprites.first(count), texture_index, tiling_factor);
+		quad_index_count += (uint32_t)count * 6;
+
+		stats.quad_count += (uint32_t)count;
+		return sprites.subspan(count);
+	}
+
+	void Renderer2D::draw_quads(std::span<const SpriteInstance> sprites)
+	{
+		while (!sprites.empty()) {
+			if (quad_index_count >= max_indices) {
+				flush_and_reset();
+			}
+
+			// Slot 0 is the white texture.
+			sprites = write_quads(sprites, 0.0f, 1.0f);
+		}
+	}
+
+	void Renderer2D::draw_quads(std::span<const SpriteInstance> sprites, const Reference<Texture2D>& texture, float tiling_factor)
+	{
+		while (!sprites.empty()) {
+			if (quad_index_count >= max_indices) {
+				flush_and_reset();
+			}
+
+			// Looked up per batch, since starting a new batch clears the texture slots.
+			const float texture_index = get_quad_texture_index(texture);
+			sprites = write_quads(sprites, texture_index, tiling_factor);
+		}
+	}
+
 	void Renderer2D::draw_rotated_rect(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 	{
 		draw_rotated_rect({ position.x, position.y, 0.0f }, size, rotation, color);
@@ -815,7 +1023,8 @@ namespace ForgottenEngine {
 
 	void Renderer2D::draw_rotated_rect(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 	{
-		if (line_index_count >= max_line_indices) {
+		// Four lines, eight vertices.
+		if (line_index_count + 8 > max_line_vertices) {
 			flush_and_reset_lines();
 		}
 
@@ -850,7 +1059,7 @@ namespace ForgottenEngine {
 	void Renderer2D::fill_circle(const glm::vec3& position, float radius, const glm::vec4& color, float thickness)
 	{
 		if (circle_index_count >= max_indices) {
-			flush_and_reset();
+			flush_and_reset_circles();
 		}
 
 		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { radius * 2.0f, radius * 2.0f, 1.0f });
@@ -861,15 +1070,15 @@ namespace ForgottenEngine {
 			circle_vertex_buffer_ptr->LocalPosition = quad_vertex_positions[i] * 2.0f;
 			circle_vertex_buffer_ptr->Color = color;
 			circle_vertex_buffer_ptr++;
-
-			circle_index_count += 6;
-			stats.quad_count++;
 		}
+
+		circle_index_count += 6;
+		stats.quad_count++;
 	}
 
 	void Renderer2D::draw_line(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color)
 	{
-		if (line_index_count >= max_line_indices) {
+		if (line_index_count >= max_line_vertices) {
 			flush_and_reset_lines();
 		}
 
@@ -947,16 +1156,6 @@ namespace ForgottenEngine {
 		}
 	}
 
-	static bool NextLine(int index, const std::vector<int>& lines)
-	{
-		for (int line : lines) {
-			if (line == index) {
-				return true;
-			}
-		}
-		return false;
-	}
-
 	void Renderer2D::draw_string(const std::string& string, const glm::vec3& position, float maxWidth, const glm::vec4& color)
 	{
 		// Use default font
@@ -969,13 +1168,6 @@ namespace ForgottenEngine {
 		draw_string(string, font, glm::translate(glm::mat4(1.0f), position), maxWidth, color);
 	}
 
-	// From https://stackoverflow.com/questions/31302506/stdu32string-conversion-to-from-stdstring-and-stdu16string
-	static std::u32string to_utf_32(const std::string& s)
-	{
-		std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> conv;
-		return conv.from_bytes(s);
-	}
-
 	void Renderer2D::draw_string(const std::string& string, const Reference<Font>& font, const glm::mat4& transform, float maxWidth,
 		const glm::vec4& color, float lineHeightOffset, float kerningOffset)
 	{
@@ -983,154 +1175,98 @@ namespace ForgottenEngine {
 			return;
 		}
 
-		float texture_index = 0.0f;
+		// Fonts still loading in the background are stood in for by the default one.
+		Reference<Font> drawn_font = font;
+		if (!drawn_font->is_ready())
+			drawn_font = Font::get_default_font();
 
-		// TODO(Yan): this isn't really ideal, but we need to iterate through UTF-8 code points
-		std::u32string utf32string = to_utf_32(string);
+		const TextLayout& layout = text_layout_cache.get(string, drawn_font, maxWidth, lineHeightOffset, kerningOffset);
 
-		Reference<Texture2D> font_atlas = font->get_font_atlas();
-		core_assert(font_atlas, "");
+		if (auto atlas = drawn_font->get_dynamic_atlas())
+			atlas->touch_pages(layout.page_mask);
+		else
+			core_assert(drawn_font->get_font_atlas(), "");
 
-		for (uint32_t i = 0; i < font_texture_slot_index; i++) {
-			if (*font_texture_slots[i].raw() == *font_atlas.raw()) {
-				texture_index = (float)i;
-				break;
+		std::array<float, max_texture_slots> page_texture_indices {};
+		get_font_texture_indices(drawn_font, layout.page_mask, page_texture_indices);
+
+		for (const auto& glyph : layout.glyphs) {
+			if (text_index_count >= max_indices) {
+				flush_and_reset_text();
+				get_font_texture_indices(drawn_font, layout.page_mask, page_texture_indices); // The new batch starts with no slots.
 			}
-		}
 
-		if (texture_index == 0.0f) {
-			texture_index = (float)font_texture_slot_index;
-			font_texture_slots[font_texture_slot_index] = font_atlas;
-			font_texture_slot_index++;
+			const float texture_index = page_texture_indices[glyph.page];
+
+			text_vertex_buffer_ptr->Position = transform * glm::vec4(glyph.plane_min.x, glyph.plane_min.y, 0.0f, 1.0f);
+			text_vertex_buffer_ptr->Color = color;
+			text_vertex_buffer_ptr->TextureCoords = { glyph.uv_min.x, glyph.uv_min.y };
+			text_vertex_buffer_ptr->TextureIndex = texture_index;
+			text_vertex_buffer_ptr++;
+
+			text_vertex_buffer_ptr->Position = transform * glm::vec4(glyph.plane_min.x, glyph.plane_max.y, 0.0f, 1.0f);
+			text_vertex_buffer_ptr->Color = color;
+			text_vertex_buffer_ptr->TextureCoords = { glyph.uv_min.x, glyph.uv_max.y };
+			text_vertex_buffer_ptr->TextureIndex = texture_index;
+			text_vertex_buffer_ptr++;
+
+			text_vertex_buffer_ptr->Position = transform * glm::vec4(glyph.plane_max.x, glyph.plane_max.y, 0.0f, 1.0f);
+			text_vertex_buffer_ptr->Color = color;
+			text_vertex_buffer_ptr->TextureCoords = { glyph.uv_max.x, glyph.uv_max.y };
+			text_vertex_buffer_ptr->TextureIndex = texture_index;
+			text_vertex_buffer_ptr++;
+
+			text_vertex_buffer_ptr->Position = transform * glm::vec4(glyph.plane_max.x, glyph.plane_min.y, 0.0f, 1.0f);
+			text_vertex_buffer_ptr->Color = color;
+			text_vertex_buffer_ptr->TextureCoords = { glyph.uv_max.x, glyph.uv_min.y };
+			text_vertex_buffer_ptr->TextureIndex = texture_index;
+			text_vertex_buffer_ptr++;
+
+			text_index_count += 6;
 		}
 
-		auto& font_geometry = font->get_msdf_data()->font_geometry;
-		const auto& metrics = font_geometry.getMetrics();
-
-		// TODO(Yan): these font metrics really should be cleaned up/refactored...
-		//            (this is a first pass WIP)
-		std::vector<int> next_lines;
-		{
-			double x = 0.0;
-			double fs_scale = 1 / (metrics.ascenderY - metrics.descenderY);
-			double y = -fs_scale * metrics.ascenderY;
-			int last_space = -1;
-			for (int i = 0; i < utf32string.size(); i++) {
-				char32_t character = utf32string[i];
-				if (character == '\n') {
-					x = 0;
-					y -= fs_scale * metrics.lineHeight + lineHeightOffset;
-					continue;
-				}
-
-				auto glyph = font_geometry.getGlyph(character);
-				if (!glyph) {
-					glyph = font_geometry.getGlyph('?');
-				}
-				if (!glyph) {
-					continue;
-				}
-
-				if (character != ' ') {
-					// Calc geo
-					double pl, pb, pr, pt;
-					glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-					glm::vec2 quad_min((float)pl, (float)pb);
-					glm::vec2 quad_max((float)pr, (float)pt);
-
-					quad_min *= fs_scale;
-					quad_max *= fs_scale;
-					quad_min += glm::vec2(x, y);
-					quad_max += glm::vec2(x, y);
-
-					if (quad_max.x > maxWidth && last_space != -1) {
-						i = last_space;
-						next_lines.emplace_back(last_space);
-						last_space = -1;
-						x = 0;
-						y -= fs_scale * metrics.lineHeight + lineHeightOffset;
-					}
-				} else {
-					last_space = i;
-				}
+		stats.quad_count += (uint32_t)layout.glyphs.size();
+	}
 
-				double advance = glyph->getAdvance();
-				font_geometry.getAdvance(advance, character, utf32string[i + 1]);
-				x += fs_scale * advance + kerningOffset;
+	bool Renderer2D::try_get_font_texture_index(
+		const Reference<Texture2D>& texture, const Reference<DynamicFontAtlas>& atlas, uint32_t page, float& index)
+	{
+		for (uint32_t i = 0; i < font_texture_slot_index; i++) {
+			const auto& [slot_atlas, slot_page] = font_texture_pages[i];
+			if (atlas ? (slot_atlas.raw() == atlas.raw() && slot_page == page) : (!slot_atlas && *font_texture_slots[i].raw() == *texture.raw())) {
+				index = (float)i;
+				return true;
 			}
 		}
 
-		{
-			double x = 0.0;
-			double fs_scale = 1 / (metrics.ascenderY - metrics.descenderY);
-			double y = 0.0; // -fsScale * metrics.ascenderY;
-			for (int i = 0; i < utf32string.size(); i++) {
-				char32_t character = utf32string[i];
-				if (character == '\n' || NextLine(i, next_lines)) {
-					x = 0;
-					y -= fs_scale * metrics.lineHeight + lineHeightOffset;
-					continue;
-				}
-
-				auto glyph = font_geometry.getGlyph(character);
-				if (!glyph) {
-					glyph = font_geometry.getGlyph('?');
-				}
-				if (!glyph) {
-					continue;
-				}
-
-				double l, b, r, t;
-				glyph->getQuadAtlasBounds(l, b, r, t);
-
-				double pl, pb, pr, pt;
-				glyph->getQuadPlaneBounds(pl, pb, pr, pt);
-
-				pl *= fs_scale, pb *= fs_scale, pr *= fs_scale, pt *= fs_scale;
-				pl += x, pb += y, pr += x, pt += y;
+		if (font_texture_slot_index == max_texture_slots)
+			return false;
 
-				double texel_width = 1. / font_atlas->get_width();
-				double texel_height = 1. / font_atlas->get_height();
-				l *= texel_width, b *= texel_height, r *= texel_width, t *= texel_height;
-
-				// ImGui::begin("Font");
-				// ImGui::Text("buffer_size: %d, %d", m_ExampleFontSheet->get_width(),
-				// m_ExampleFontSheet->get_height()); UI::Image(m_ExampleFontSheet,
-				// ImVec2(m_ExampleFontSheet->get_width(), m_ExampleFontSheet->get_height()), ImVec2(0, 1), ImVec2(1,
-				// 0)); ImGui::End();
-
-				text_vertex_buffer_ptr->Position = transform * glm::vec4(pl, pb, 0.0f, 1.0f);
-				text_vertex_buffer_ptr->Color = color;
-				text_vertex_buffer_ptr->TextureCoords = { l, b };
-				text_vertex_buffer_ptr->TextureIndex = texture_index;
-				text_vertex_buffer_ptr++;
-
-				text_vertex_buffer_ptr->Position = transform * glm::vec4(pl, pt, 0.0f, 1.0f);
-				text_vertex_buffer_ptr->Color = color;
-				text_vertex_buffer_ptr->TextureCoords = { l, t };
-				text_vertex_buffer_ptr->TextureIndex = texture_index;
-				text_vertex_buffer_ptr++;
-
-				text_vertex_buffer_ptr->Position = transform * glm::vec4(pr, pt, 0.0f, 1.0f);
-				text_vertex_buffer_ptr->Color = color;
-				text_vertex_buffer_ptr->TextureCoords = { r, t };
-				text_vertex_buffer_ptr->TextureIndex = texture_index;
-				text_vertex_buffer_ptr++;
-
-				text_vertex_buffer_ptr->Position = transform * glm::vec4(pr, pb, 0.0f, 1.0f);
-				text_vertex_buffer_ptr->Color = color;
-				text_vertex_buffer_ptr->TextureCoords = { r, b };
-				text_vertex_buffer_ptr->TextureIndex = texture_index;
-				text_vertex_buffer_ptr++;
+		font_texture_slots[font_texture_slot_index] = texture;
+		font_texture_pages[font_texture_slot_index] = { atlas, page };
+		index = (float)font_texture_slot_index++;
+		return true;
+	}
 
-				text_index_count += 6;
+	void Renderer2D::get_font_texture_indices(const Reference<Font>& font, uint32_t page_mask, std::array<float, max_texture_slots>& indices)
+	{
+		static_assert(DynamicFontAtlas::max_page_limit <= max_texture_slots, "Every page of one font must fit in an empty text batch.");
 
-				double advance = glyph->getAdvance();
-				font_geometry.getAdvance(advance, character, utf32string[i + 1]);
-				x += fs_scale * advance + kerningOffset;
+		const auto try_get_indices = [&]() {
+			const auto atlas = font->get_dynamic_atlas();
+			if (!atlas)
+				return try_get_font_texture_index(font->get_font_atlas(), nullptr, 0, indices[0]);
 
-				stats.quad_count++;
+			for (uint32_t page = 0; page < DynamicFontAtlas::max_page_limit; page++) {
+				if ((page_mask & (1u << page)) && !try_get_font_texture_index(nullptr, atlas, page, indices[page]))
+					return false;
 			}
+			return true;
+		};
+
+		if (!try_get_indices()) {
+			flush_and_reset_text();
+			try_get_indices();
 		}
 	}
 
@@ -0,0 +1,139 @@
+#include "fg_pch.hpp"
+
+#include "render/Renderer2DContext.hpp"
+
+#include "render/SpriteAtlas.hpp"
+#include "render/SpriteTransform.hpp"
+#include "render/Texture.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace ForgottenEngine {
+
+	Renderer2DContext::Renderer2DContext(bool bindless_textures)
+		: bindless_textures(bindless_textures)
+	{
+	}
+
+	void Renderer2DContext::reset(uint64_t key)
+	{
+		order_key = key;
+		quad_vertices.clear();
+		sprite_instances.clear();
+		textures.clear();
+		texture_handles.clear();
+	}
+
+	Renderer2D::QuadVertex* Renderer2DContext::append_quads(size_t count)
+	{
+		const size_t offset = quad_vertices.size();
+		quad_vertices.resize(offset + count * 4);
+		return quad_vertices.data() + offset;
+	}
+
+	uint32_t Renderer2DContext::get_texture_index(const Reference<Texture2D>& texture)
+	{
+		if (bindless_textures)
+			return texture->get_bindless_index();
+
+		// By handle, as Renderer2D matches its slots.
+		const ResourceHandle<Texture2D> handle = texture->get_handle();
+		for (uint32_t i = 0; i < texture_handles.size(); i++) {
+			if (texture_handles[i] == handle)
+				return i + 1;
+		}
+
+		textures.push_back(texture);
+		texture_handles.push_back(handle);
+		return (uint32_t)textures.size();
+	}
+
+	void Renderer2DContext::draw_quad(const glm::mat4& transform, const glm::vec4& color)
+	{
+		// Index 0 is the white texture.
+		Renderer2D::write_quad_vertices(append_quads(1), transform, color, 0.0f, 1.0f);
+	}
+
+	void Renderer2DContext::draw_quad(const glm::mat4& transform, const Reference<Texture2D>& texture, float tiling_factor, const glm::vec4& tint_color)
+	{
+		const float texture_index = (float)get_texture_index(texture);
+		Renderer2D::write_quad_vertices(append_quads(1), transform, tint_color, texture_index, tiling_factor);
+	}
+
+	void Renderer2DContext::draw_quad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		draw_quad(glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f }), color);
+	}
+
+	void Renderer2DContext::draw_quad(
+		const glm::vec3& position, const glm::vec2& size, const Reference<Texture2D>& texture, float tiling_factor, const glm::vec4& tint_color)
+	{
+		draw_quad(glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f }), texture, tiling_factor,
+			tint_color);
+	}
+
+	void Renderer2DContext::draw_quad(const glm::vec3& position, const glm::vec2& size, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		const float texture_index = (float)get_texture_index(region.texture);
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		Renderer2D::write_quad_vertices(append_quads(1), transform, tint_color, texture_index, region.uv_rect);
+	}
+
+	void Renderer2DContext::draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
+	{
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		draw_quad(transform, color);
+	}
+
+	void Renderer2DContext::draw_rotated_quad(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+		float tiling_factor, const glm::vec4& tint_color)
+	{
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		draw_quad(transform, texture, tiling_factor, tint_color);
+	}
+
+	void Renderer2DContext::draw_rotated_quad(
+		const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		const float texture_index = (float)get_texture_index(region.texture);
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position) * glm::rotate(glm::mat4(1.0f), rotation, { 0.0f, 0.0f, 1.0f })
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+
+		Renderer2D::write_quad_vertices(append_quads(1), transform, tint_color, texture_index, region.uv_rect);
+	}
+
+	void Renderer2DContext::draw_quads(std::span<const SpriteInstance> sprites)
+	{
+		SpriteTransform::write_quad_vertices(append_quads(sprites.size()), sprites, 0.0f, 1.0f);
+	}
+
+	void Renderer2DContext::draw_quads(std::span<const SpriteInstance> sprites, const Reference<Texture2D>& texture, float tiling_factor)
+	{
+		const float texture_index = (float)get_texture_index(texture);
+		SpriteTransform::write_quad_vertices(append_quads(sprites.size()), sprites, texture_index, tiling_factor);
+	}
+
+	void Renderer2DContext::draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
+	{
+		sprite_instances.push_back(Renderer2D::make_quad_instance(position, size, rotation, color, 0, { 0.0f, 0.0f, 1.0f, 1.0f }));
+	}
+
+	void Renderer2DContext::draw_sprite(const glm::vec3& position, const glm::vec2& size, float rotation, const Reference<Texture2D>& texture,
+		const glm::vec4& uv_rect, const glm::vec4& tint_color)
+	{
+		const uint32_t texture_index = get_texture_index(texture);
+		sprite_instances.push_back(Renderer2D::make_quad_instance(position, size, rotation, tint_color, texture_index, uv_rect));
+	}
+
+	void Renderer2DContext::draw_sprite(
+		const glm::vec3& position, const glm::vec2& size, float rotation, const AtlasRegion& region, const glm::vec4& tint_color)
+	{
+		draw_sprite(position, size, rotation, region.texture, region.uv_rect, tint_color);
+	}
+
+} // namespace ForgottenEngine
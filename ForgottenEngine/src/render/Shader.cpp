@@ -2,6 +2,7 @@
 
 #include "render/Shader.hpp"
 
+#include "null/NullShader.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/compiler/VulkanShaderCompiler.hpp"
@@ -21,6 +22,9 @@ namespace ForgottenEngine {
 		case RendererAPIType::Vulkan:
 			result = Reference<VulkanShader>::create(filepath, force_compile, disable_optimizations);
 			break;
+		case RendererAPIType::Null:
+			result = Reference<NullShader>::create(filepath);
+			break;
 		}
 		return result;
 	}
@@ -39,6 +43,13 @@ namespace ForgottenEngine {
 	{
 		Reference<Shader> shader;
 
+		if (RendererAPI::current() == RendererAPIType::Null) {
+			// Nothing to compile for, so the source is not needed either.
+			shader = Shader::create(std::string(path));
+			shaders[shader->get_name()] = shader;
+			return;
+		}
+
 		auto found_path = Assets::find_resources_by_path(path, "shaders");
 		core_assert(found_path, "Could not find a shader at: {}", *found_path);
 
@@ -57,6 +68,44 @@ namespace ForgottenEngine {
 		shaders[name] = shader;
 	}
 
+	void ShaderLibrary::load_all(const std::vector<std::string_view>& paths, bool force_compile, bool disable_optimizations)
+	{
+		std::vector<std::filesystem::path> to_compile;
+		for (const auto path : paths) {
+			if (RendererAPI::current() == RendererAPIType::Null) {
+				// Nothing to compile for, so the source is not needed either.
+				auto shader = Shader::create(std::string(path));
+				auto& name = shader->get_name();
+				core_assert(!is_in_map(shaders, name), "Shader with name [{}] already linked", name);
+				shaders[name] = shader;
+				continue;
+			}
+
+			auto found_path = Assets::find_resources_by_path(path, "shaders");
+			core_assert(found_path, "Could not find a shader at: {}", *found_path);
+
+			if (!force_compile && shader_pack) {
+				if (shader_pack->contains(path)) {
+					auto shader = shader_pack->load_shader((*found_path).string());
+					auto& name = shader->get_name();
+					core_assert(!is_in_map(shaders, name), "Shader with name [{}] already linked", name);
+					shaders[name] = shader;
+				}
+			} else {
+				to_compile.push_back(*found_path);
+			}
+		}
+
+		if (to_compile.empty())
+			return;
+
+		for (const auto& shader : VulkanShaderCompiler::compile(to_compile, force_compile, disable_optimizations)) {
+			auto& name = shader->get_name();
+			core_assert(!is_in_map(shaders, name), "Shader with name [{}] already linked", name);
+			shaders[name] = shader;
+		}
+	}
+
 	void ShaderLibrary::load(std::string_view name, const std::string& path)
 	{
 		std::string shader_name(name);
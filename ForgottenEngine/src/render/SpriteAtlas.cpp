@@ -0,0 +1,232 @@
+#include "fg_pch.hpp"
+
+#include "render/SpriteAtlas.hpp"
+
+#include "render/Texture.hpp"
+#include "stb_image.h"
+
+#undef INFINITE
+#include "msdf-atlas-gen.h"
+
+namespace ForgottenEngine {
+
+	struct SpriteAtlas::Page {
+		uint32_t index = 0;
+		msdf_atlas::RectanglePacker packer;
+		std::vector<uint8_t> pixels; // RGBA8, page_size squared
+		std::vector<Handle> sprites;
+		Reference<Texture2D> texture;
+
+		bool dirty = false; // Pixels differ from the texture.
+		bool needs_repack = false; // A sprite was removed, its space is only reclaimed by packing the page again.
+	};
+
+	SpriteAtlas::SpriteAtlas(const SpriteAtlasSpecification& specification)
+		: specification(specification)
+	{
+		core_assert(specification.max_sprite_size + 2 * specification.padding <= specification.page_size,
+			"Sprites of max_sprite_size must fit a page with their padding.");
+	}
+
+	SpriteAtlas::~SpriteAtlas() = default;
+
+	SpriteAtlas::Handle SpriteAtlas::add(uint32_t width, uint32_t height, const void* rgba_pixels)
+	{
+		if (width == 0 || height == 0 || width > specification.max_sprite_size || height > specification.max_sprite_size)
+			return invalid_handle;
+
+		Handle handle;
+		if (!free_handles.empty()) {
+			handle = free_handles.back();
+			free_handles.pop_back();
+		} else {
+			handle = static_cast<Handle>(sprites.size());
+			sprites.emplace_back();
+		}
+
+		auto& sprite = sprites[handle];
+		sprite.width = width;
+		sprite.height = height;
+		sprite.pixels.assign(static_cast<const uint8_t*>(rgba_pixels), static_cast<const uint8_t*>(rgba_pixels) + width * height * 4);
+		sprite.alive = true;
+		sprite_count++;
+
+		pack_into_any_page(handle);
+		return handle;
+	}
+
+	SpriteAtlas::Handle SpriteAtlas::add(const std::filesystem::path& path)
+	{
+		int width, height, channels;
+		stbi_uc* data = stbi_load(path.string().c_str(), &width, &height, &channels, 4);
+		if (!data) {
+			CORE_ERROR("[SpriteAtlas] Could not load {}.", path.string());
+			return invalid_handle;
+		}
+
+		const Handle handle = add(static_cast<uint32_t>(width), static_cast<uint32_t>(height), data);
+		stbi_image_free(data);
+		return handle;
+	}
+
+	void SpriteAtlas::remove(Handle handle)
+	{
+		if (handle >= sprites.size() || !sprites[handle].alive)
+			return;
+
+		auto& sprite = sprites[handle];
+		auto& page = *pages[sprite.page];
+		std::erase(page.sprites, handle);
+		page.needs_repack = true;
+
+		sprite.alive = false;
+		sprite.pixels = {};
+		free_handles.push_back(handle);
+		sprite_count--;
+	}
+
+	void SpriteAtlas::update()
+	{
+		for (uint32_t i = 0; i < pages.size(); i++) {
+			if (pages[i]->needs_repack)
+				repack(i);
+		}
+
+		for (auto& page : pages) {
+			if (!page->dirty)
+				continue;
+
+			page->dirty = false;
+			if (page->sprites.empty()) {
+				page->texture = nullptr;
+				continue;
+			}
+
+			// A new texture rather than an update in place, frames in flight keep sampling the old one.
+			TextureProperties properties;
+			properties.DebugName = fmt::format("{} page {}", specification.debug_name, page->index);
+			properties.SamplerWrap = TextureWrap::Clamp;
+			properties.GenerateMips = false; // Mips would blend neighbouring sprites.
+			page->texture = Texture2D::create(ImageFormat::RGBA, specification.page_size, specification.page_size, page->pixels.data(), properties);
+		}
+	}
+
+	AtlasRegion SpriteAtlas::get_region(Handle handle) const
+	{
+		core_assert(handle < sprites.size() && sprites[handle].alive, "Not a sprite of this atlas.");
+
+		const auto& sprite = sprites[handle];
+		const auto& page = *pages[sprite.page];
+		core_assert(page.texture, "SpriteAtlas::update has not run since the sprite was added.");
+
+		const float scale = 1.0f / static_cast<float>(specification.page_size);
+		return { page.texture, glm::vec4(sprite.x, sprite.y, sprite.x + sprite.width, sprite.y + sprite.height) * scale };
+	}
+
+	bool SpriteAtlas::try_pack(Page& page, Handle handle)
+	{
+		auto& sprite = sprites[handle];
+		const auto padding = static_cast<int>(specification.padding);
+
+		msdf_atlas::Rectangle rectangle { -1, -1, static_cast<int>(sprite.width) + 2 * padding, static_cast<int>(sprite.height) + 2 * padding };
+		if (page.packer.pack(&rectangle, 1) != 0)
+			return false;
+
+		sprite.page = page.index;
+		sprite.x = static_cast<uint32_t>(rectangle.x + padding);
+		sprite.y = static_cast<uint32_t>(rectangle.y + padding);
+		page.sprites.push_back(handle);
+		blit(page, sprite);
+		return true;
+	}
+
+	void SpriteAtlas::pack_into_any_page(Handle handle)
+	{
+		for (auto& page : pages) {
+			if (try_pack(*page, handle))
+				return;
+		}
+
+		// Space freed by remove() only comes back with a repack; try that before growing.
+		for (uint32_t i = 0; i < pages.size(); i++) {
+			if (pages[i]->needs_repack) {
+				repack(i);
+				if (try_pack(*pages[i], handle))
+					return;
+			}
+		}
+
+		auto& page = *pages.emplace_back(std::make_unique<Page>());
+		page.index = static_cast<uint32_t>(pages.size() - 1);
+		page.packer = msdf_atlas::RectanglePacker(static_cast<int>(specification.page_size), static_cast<int>(specification.page_size));
+		page.pixels.resize(static_cast<size_t>(specification.page_size) * specification.page_size * 4);
+
+		const bool packed = try_pack(page, handle);
+		core_assert(packed, "A sprite within max_sprite_size always fits an empty page.");
+	}
+
+	void SpriteAtlas::repack(uint32_t page_index)
+	{
+		auto& page = *pages[page_index];
+		page.needs_repack = false;
+		page.dirty = true;
+
+		std::vector<Handle> handles = std::move(page.sprites);
+		page.sprites.clear();
+		page.packer = msdf_atlas::RectanglePacker(static_cast<int>(specification.page_size), static_cast<int>(specification.page_size));
+		std::fill(page.pixels.begin(), page.pixels.end(), uint8_t { 0 });
+
+		// All at once, so the packer can pick the best fit among them.
+		const auto padding = static_cast<int>(specification.padding);
+		std::vector<msdf_atlas::Rectangle> rectangles(handles.size());
+		for (size_t i = 0; i < handles.size(); i++) {
+			const auto& sprite = sprites[handles[i]];
+			rectangles[i] = { -1, -1, static_cast<int>(sprite.width) + 2 * padding, static_cast<int>(sprite.height) + 2 * padding };
+		}
+		page.packer.pack(rectangles.data(), static_cast<int>(rectangles.size()));
+
+		std::vector<Handle> overflow;
+		for (size_t i = 0; i < handles.size(); i++) {
+			if (rectangles[i].x < 0) {
+				overflow.push_back(handles[i]);
+				continue;
+			}
+
+			auto& sprite = sprites[handles[i]];
+			sprite.x = static_cast<uint32_t>(rectangles[i].x + padding);
+			sprite.y = static_cast<uint32_t>(rectangles[i].y + padding);
+			page.sprites.push_back(handles[i]);
+			blit(page, sprite);
+		}
+
+		// A different packing order can leave a few out; they move to another page.
+		for (const auto handle : overflow)
+			pack_into_any_page(handle);
+	}
+
+	void SpriteAtlas::blit(Page& page, const Sprite& sprite)
+	{
+		const auto padding = static_cast<int>(specification.padding);
+		const auto width = static_cast<int>(sprite.width);
+		const auto height = static_cast<int>(sprite.height);
+		const size_t page_stride = static_cast<size_t>(specification.page_size) * 4;
+
+		for (int row = -padding; row < height + padding; row++) {
+			const int source_row = std::clamp(row, 0, height - 1);
+			const auto page_row = static_cast<size_t>(static_cast<int>(sprite.y) + row);
+			uint8_t* destination = page.pixels.data() + page_row * page_stride + (sprite.x - specification.padding) * 4;
+			const uint8_t* source = sprite.pixels.data() + static_cast<size_t>(source_row) * width * 4;
+
+			// Left padding, the row itself, right padding.
+			for (int column = 0; column < padding; column++, destination += 4)
+				std::memcpy(destination, source, 4);
+			std::memcpy(destination, source, static_cast<size_t>(width) * 4);
+			destination += static_cast<size_t>(width) * 4;
+			for (int column = 0; column < padding; column++, destination += 4)
+				std::memcpy(destination, source + (width - 1) * 4, 4);
+		}
+
+		page.dirty = true;
+	}
+
+} // namespace ForgottenEngine
@@ -0,0 +1,235 @@
+#include "fg_pch.hpp"
+
+#include "render/SpriteTransform.hpp"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FORGOTTEN_SPRITE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FORGOTTEN_SPRITE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FORGOTTEN_SPRITE_NEON
+#endif
+
+namespace ForgottenEngine::SpriteTransform {
+
+	// Each Lanes type wraps one instruction set behind the few operations the kernel needs.
+	struct ScalarLanes {
+		using Float = float;
+		static constexpr size_t width = 1;
+		static constexpr const char* name = "scalar";
+
+		static Float set(float value) { return value; }
+		static Float load(const float* source) { return *source; }
+		static void store(float* destination, Float value) { *destination = value; }
+		static Float add(Float a, Float b) { return a + b; }
+		static Float sub(Float a, Float b) { return a - b; }
+		static Float mul(Float a, Float b) { return a * b; }
+		static Float abs(Float a) { return std::fabs(a); }
+		static Float round(Float a) { return std::nearbyint(a); }
+		static Float copy_sign(Float magnitude, Float sign) { return std::copysign(magnitude, sign); }
+		static Float select_greater(Float a, Float b, Float if_greater, Float otherwise) { return a > b ? if_greater : otherwise; }
+	};
+
+#if defined(FORGOTTEN_SPRITE_AVX2)
+	struct Avx2Lanes {
+		using Float = __m256;
+		static constexpr size_t width = 8;
+		static constexpr const char* name = "avx2";
+
+		static Float set(float value) { return _mm256_set1_ps(value); }
+		static Float load(const float* source) { return _mm256_load_ps(source); }
+		static void store(float* destination, Float value) { _mm256_store_ps(destination, value); }
+		static Float add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static Float round(Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static Float copy_sign(Float magnitude, Float sign)
+		{
+			const __m256 sign_bit = _mm256_set1_ps(-0.0f);
+			return _mm256_or_ps(_mm256_andnot_ps(sign_bit, magnitude), _mm256_and_ps(sign_bit, sign));
+		}
+		static Float select_greater(Float a, Float b, Float if_greater, Float otherwise)
+		{
+			return _mm256_blendv_ps(otherwise, if_greater, _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+		}
+	};
+	using NativeLanes = Avx2Lanes;
+#elif defined(FORGOTTEN_SPRITE_SSE2)
+	struct Sse2Lanes {
+		using Float = __m128;
+		static constexpr size_t width = 4;
+		static constexpr const char* name = "sse2";
+
+		static Float set(float value) { return _mm_set1_ps(value); }
+		static Float load(const float* source) { return _mm_load_ps(source); }
+		static void store(float* destination, Float value) { _mm_store_ps(destination, value); }
+		static Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+		static Float abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		// SSE2 has no round instruction; the conversion rounds to nearest even like the others.
+		static Float round(Float a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+		static Float copy_sign(Float magnitude, Float sign)
+		{
+			const __m128 sign_bit = _mm_set1_ps(-0.0f);
+			return _mm_or_ps(_mm_andnot_ps(sign_bit, magnitude), _mm_and_ps(sign_bit, sign));
+		}
+		static Float select_greater(Float a, Float b, Float if_greater, Float otherwise)
+		{
+			const __m128 mask = _mm_cmpgt_ps(a, b);
+			return _mm_or_ps(_mm_and_ps(mask, if_greater), _mm_andnot_ps(mask, otherwise));
+		}
+	};
+	using NativeLanes = Sse2Lanes;
+#elif defined(FORGOTTEN_SPRITE_NEON)
+	struct NeonLanes {
+		using Float = float32x4_t;
+		static constexpr size_t width = 4;
+		static constexpr const char* name = "neon";
+
+		static Float set(float value) { return vdupq_n_f32(value); }
+		static Float load(const float* source) { return vld1q_f32(source); }
+		static void store(float* destination, Float value) { vst1q_f32(destination, value); }
+		static Float add(Float a, Float b) { return vaddq_f32(a, b); }
+		static Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+		static Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+		static Float abs(Float a) { return vabsq_f32(a); }
+		static Float round(Float a) { return vrndnq_f32(a); }
+		static Float copy_sign(Float magnitude, Float sign) { return vbslq_f32(vdupq_n_u32(0x80000000u), sign, magnitude); }
+		static Float select_greater(Float a, Float b, Float if_greater, Float otherwise)
+		{
+			return vbslq_f32(vcgtq_f32(a, b), if_greater, otherwise);
+		}
+	};
+	using NativeLanes = NeonLanes;
+#else
+	using NativeLanes = ScalarLanes;
+#endif
+
+	static constexpr float pi = 3.14159265358979f;
+	static constexpr float half_pi = pi * 0.5f;
+	static constexpr float two_pi = pi * 2.0f;
+
+	/// sin(x) for x in [-pi, pi]: folds into [-pi/2, pi/2] with sin(x) = sin(+-pi - x), then a degree 11 Taylor polynomial.
+	template <typename Lanes> static typename Lanes::Float sin_folded(typename Lanes::Float x)
+	{
+		using L = Lanes;
+
+		const auto folded = L::select_greater(L::abs(x), L::set(half_pi), L::sub(L::copy_sign(L::set(pi), x), x), x);
+		const auto x2 = L::mul(folded, folded);
+
+		auto polynomial = L::set(-2.5052108e-8f);
+		polynomial = L::add(L::mul(polynomial, x2), L::set(2.7557319e-6f));
+		polynomial = L::add(L::mul(polynomial, x2), L::set(-1.9841270e-4f));
+		polynomial = L::add(L::mul(polynomial, x2), L::set(8.3333333e-3f));
+		polynomial = L::add(L::mul(polynomial, x2), L::set(-1.6666667e-1f));
+		polynomial = L::add(L::mul(polynomial, x2), L::set(1.0f));
+		return L::mul(polynomial, folded);
+	}
+
+	/// Within about 1e-7 of std::sin/std::cos for the rotations sprites use.
+	template <typename Lanes> static void sin_cos(typename Lanes::Float angle, typename Lanes::Float& sine, typename Lanes::Float& cosine)
+	{
+		using L = Lanes;
+
+		// Into [-pi, pi]. 2pi is split in two so that turns * 6.28125 is exact.
+		const auto turns = L::round(L::mul(angle, L::set(1.0f / two_pi)));
+		auto reduced = L::sub(angle, L::mul(turns, L::set(6.28125f)));
+		reduced = L::sub(reduced, L::mul(turns, L::set(1.9353071795864769e-3f)));
+
+		// cos(x) = sin(x + pi/2), wrapped back into [-pi, pi].
+		auto shifted = L::add(reduced, L::set(half_pi));
+		shifted = L::select_greater(shifted, L::set(pi), L::sub(shifted, L::set(two_pi)), shifted);
+
+		sine = sin_folded<L>(reduced);
+		cosine = sin_folded<L>(shifted);
+	}
+
+	template <typename Lanes>
+	static Renderer2D::QuadVertex* write_lanes(
+		Renderer2D::QuadVertex* destination, std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor)
+	{
+		using L = Lanes;
+		constexpr size_t width = L::width;
+
+		static constexpr glm::vec2 texture_coords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		const size_t full = sprites.size() - sprites.size() % width;
+		for (size_t first = 0; first < full; first += width) {
+			alignas(32) float position_x[width], position_y[width], rotation[width], half_width[width], half_height[width];
+			for (size_t lane = 0; lane < width; lane++) {
+				const auto& sprite = sprites[first + lane];
+				position_x[lane] = sprite.Position.x;
+				position_y[lane] = sprite.Position.y;
+				rotation[lane] = sprite.Rotation;
+				half_width[lane] = sprite.Size.x * 0.5f;
+				half_height[lane] = sprite.Size.y * 0.5f;
+			}
+
+			typename L::Float sine, cosine;
+			sin_cos<L>(L::load(rotation), sine, cosine);
+
+			// Half axes of the quad: x is (hw cos, hw sin), y is (-hh sin, hh cos).
+			const auto x_axis_x = L::mul(L::load(half_width), cosine);
+			const auto x_axis_y = L::mul(L::load(half_width), sine);
+			const auto y_axis_x = L::mul(L::load(half_height), sine);
+			const auto y_axis_y = L::mul(L::load(half_height), cosine);
+
+			const auto left_x = L::sub(L::load(position_x), x_axis_x);
+			const auto left_y = L::sub(L::load(position_y), x_axis_y);
+			const auto right_x = L::add(L::load(position_x), x_axis_x);
+			const auto right_y = L::add(L::load(position_y), x_axis_y);
+
+			// Same corner order as Renderer2D::quad_vertex_positions.
+			alignas(32) float corner_x[4][width], corner_y[4][width];
+			L::store(corner_x[0], L::add(left_x, y_axis_x));
+			L::store(corner_y[0], L::sub(left_y, y_axis_y));
+			L::store(corner_x[1], L::sub(left_x, y_axis_x));
+			L::store(corner_y[1], L::add(left_y, y_axis_y));
+			L::store(corner_x[2], L::sub(right_x, y_axis_x));
+			L::store(corner_y[2], L::add(right_y, y_axis_y));
+			L::store(corner_x[3], L::add(right_x, y_axis_x));
+			L::store(corner_y[3], L::sub(right_y, y_axis_y));
+
+			for (size_t lane = 0; lane < width; lane++) {
+				const auto& sprite = sprites[first + lane];
+				for (size_t corner = 0; corner < 4; corner++) {
+					destination->Position = { corner_x[corner][lane], corner_y[corner][lane], sprite.Position.z };
+					destination->Color = sprite.Color;
+					destination->TextureCoords = texture_coords[corner];
+					destination->TextureIndex = texture_index;
+					destination->TilingFactor = tiling_factor;
+					destination++;
+				}
+			}
+		}
+
+		if constexpr (width > 1) {
+			if (full < sprites.size())
+				destination = write_lanes<ScalarLanes>(destination, sprites.subspan(full), texture_index, tiling_factor);
+		}
+
+		return destination;
+	}
+
+	const char* kernel_name() { return NativeLanes::name; }
+
+	Renderer2D::QuadVertex* write_quad_vertices(
+		Renderer2D::QuadVertex* destination, std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor)
+	{
+		return write_lanes<NativeLanes>(destination, sprites, texture_index, tiling_factor);
+	}
+
+	Renderer2D::QuadVertex* write_quad_vertices_scalar(
+		Renderer2D::QuadVertex* destination, std::span<const SpriteInstance> sprites, float texture_index, float tiling_factor)
+	{
+		return write_lanes<ScalarLanes>(destination, sprites, texture_index, tiling_factor);
+	}
+
+} // namespace ForgottenEngine::SpriteTransform
@@ -11,6 +11,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanStorageBuffer>::create(size, binding);
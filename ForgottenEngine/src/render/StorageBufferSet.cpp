@@ -16,6 +16,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanStorageBufferSet>::create(size);
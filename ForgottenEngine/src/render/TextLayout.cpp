@@ -0,0 +1,278 @@
+#include "fg_pch.hpp"
+
+#include "render/TextLayout.hpp"
+
+#include "render/Font.hpp"
+#include "render/MSDFData.hpp"
+
+namespace ForgottenEngine {
+
+	namespace Utf8 {
+		static constexpr char32_t replacement_character = 0xFFFD;
+
+		bool decode_next(std::string_view string, size_t& offset, char32_t& out_code_point)
+		{
+			if (offset >= string.size())
+				return false;
+
+			const auto lead = (uint8_t)string[offset];
+			uint32_t length;
+			char32_t code_point;
+			if (lead < 0x80) {
+				out_code_point = lead;
+				offset++;
+				return true;
+			} else if ((lead & 0xE0) == 0xC0) {
+				length = 2;
+				code_point = lead & 0x1F;
+			} else if ((lead & 0xF0) == 0xE0) {
+				length = 3;
+				code_point = lead & 0x0F;
+			} else if ((lead & 0xF8) == 0xF0) {
+				length = 4;
+				code_point = lead & 0x07;
+			} else {
+				out_code_point = replacement_character;
+				offset++;
+				return true;
+			}
+
+			if (offset + length > string.size()) {
+				out_code_point = replacement_character;
+				offset++;
+				return true;
+			}
+
+			for (uint32_t i = 1; i < length; i++) {
+				const auto continuation = (uint8_t)string[offset + i];
+				if ((continuation & 0xC0) != 0x80) {
+					out_code_point = replacement_character;
+					offset++;
+					return true;
+				}
+				code_point = (code_point << 6) | (continuation & 0x3F);
+			}
+
+			// Overlong forms, surrogates and values past U+10FFFF are malformed too.
+			static constexpr char32_t min_for_length[] = { 0, 0, 0x80, 0x800, 0x10000 };
+			if (code_point < min_for_length[length] || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+				out_code_point = replacement_character;
+				offset++;
+				return true;
+			}
+
+			out_code_point = code_point;
+			offset += length;
+			return true;
+		}
+	} // namespace Utf8
+
+	size_t TextLayoutCache::KeyHasher::operator()(const Key& key) const
+	{
+		size_t hash = key.text_hash;
+		auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2); };
+		combine(std::hash<const Font*>()(key.font));
+		combine(std::hash<float>()(key.max_width));
+		combine(std::hash<float>()(key.line_height_offset));
+		combine(std::hash<float>()(key.kerning_offset));
+		return hash;
+	}
+
+	static uint64_t get_atlas_generation(const Font& font)
+	{
+		const auto& atlas = font.get_dynamic_atlas();
+		return atlas ? atlas->get_generation() : 0;
+	}
+
+	const TextLayout& TextLayoutCache::get(
+		std::string_view text, const Reference<Font>& font, float max_width, float line_height_offset, float kerning_offset)
+	{
+		const Key key { std::hash<std::string_view>()(text), font.raw(), max_width, line_height_offset, kerning_offset };
+
+		auto [it, inserted] = entries.try_emplace(key);
+		Entry& entry = it->second;
+		entry.last_used_frame = frame;
+		if (!inserted && entry.text == text && !entry.layout.incomplete && entry.layout.atlas_generation == get_atlas_generation(*font))
+			return entry.layout;
+
+		// New, another string with the same hash, glyphs that moved or were missing; either way the entry now holds this one.
+		entry.text = text;
+		entry.font = font;
+		build(entry.layout, text, *font, max_width, line_height_offset, kerning_offset, scratch);
+		return entry.layout;
+	}
+
+	void TextLayoutCache::new_frame()
+	{
+		frame++;
+		if (frame % max_unused_frames != 0)
+			return;
+
+		std::erase_if(entries, [this](const auto& item) { return frame - item.second.last_used_frame > max_unused_frames; });
+	}
+
+	namespace {
+		/// What layout needs of a glyph, whichever atlas it comes from.
+		struct GlyphInfo {
+			double advance;
+			double pl, pb, pr, pt;
+			glm::vec2 uv_min;
+			glm::vec2 uv_max;
+			uint32_t page;
+		};
+
+		struct LayoutMetrics {
+			double fs_scale;
+			double line_height;
+			double ascender;
+		};
+	} // namespace
+
+	/// `find_glyph(character, info)` fills in the glyph or its fallback, false if there is neither;
+	/// `get_advance(info, character, next)` adds kerning.
+	template <typename FIND_FN, typename ADVANCE_FN>
+	static void lay_out(TextLayout& layout, std::vector<char32_t>& scratch, int length, const LayoutMetrics& metrics, float max_width,
+		float line_height_offset, float kerning_offset, FIND_FN&& find_glyph, ADVANCE_FN&& get_advance)
+	{
+		const double fs_scale = metrics.fs_scale;
+		GlyphInfo glyph;
+
+		// Word wrap: a space where the line has to break becomes a line break.
+		{
+			double x = 0.0;
+			double y = -fs_scale * metrics.ascender;
+			int last_space = -1;
+			for (int i = 0; i < length; i++) {
+				char32_t character = scratch[i];
+				if (character == '\n') {
+					x = 0;
+					y -= fs_scale * metrics.line_height + line_height_offset;
+					continue;
+				}
+
+				if (!find_glyph(character, glyph))
+					continue;
+
+				if (character != ' ') {
+					if (fs_scale * glyph.pr + x > max_width && last_space != -1) {
+						i = last_space;
+						scratch[last_space] = '\n';
+						last_space = -1;
+						x = 0;
+						y -= fs_scale * metrics.line_height + line_height_offset;
+					}
+				} else {
+					last_space = i;
+				}
+
+				x += fs_scale * get_advance(glyph, character, scratch[i + 1]) + kerning_offset;
+			}
+		}
+
+		double x = 0.0;
+		double y = 0.0;
+		for (int i = 0; i < length; i++) {
+			char32_t character = scratch[i];
+			if (character == '\n') {
+				x = 0;
+				y -= fs_scale * metrics.line_height + line_height_offset;
+				continue;
+			}
+
+			if (!find_glyph(character, glyph))
+				continue;
+
+			// Blank glyphs such as spaces only advance.
+			if (glyph.pl != glyph.pr && glyph.pb != glyph.pt) {
+				TextLayout::Glyph& quad = layout.glyphs.emplace_back();
+				quad.plane_min = { glyph.pl * fs_scale + x, glyph.pb * fs_scale + y };
+				quad.plane_max = { glyph.pr * fs_scale + x, glyph.pt * fs_scale + y };
+				quad.uv_min = glyph.uv_min;
+				quad.uv_max = glyph.uv_max;
+				quad.page = glyph.page;
+			}
+
+			x += fs_scale * get_advance(glyph, character, scratch[i + 1]) + kerning_offset;
+		}
+	}
+
+	void TextLayoutCache::build(TextLayout& layout, std::string_view text, const Font& font, float max_width, float line_height_offset,
+		float kerning_offset, std::vector<char32_t>& scratch)
+	{
+		layout.glyphs.clear();
+		layout.page_mask = 0;
+		layout.incomplete = false;
+
+		scratch.clear();
+		size_t offset = 0;
+		char32_t code_point;
+		while (Utf8::decode_next(text, offset, code_point))
+			scratch.push_back(code_point);
+		const int length = (int)scratch.size();
+		scratch.push_back(0); // Kerning looks one character ahead.
+
+		if (auto atlas = font.get_dynamic_atlas()) {
+			const uint64_t full_misses = atlas->get_full_miss_count();
+			const auto& font_metrics = atlas->get_metrics();
+			const LayoutMetrics metrics { 1 / (font_metrics.ascender - font_metrics.descender), font_metrics.line_height, font_metrics.ascender };
+
+			auto find_glyph = [&atlas, &layout](char32_t character, GlyphInfo& out) {
+				auto glyph = atlas->get_glyph(character);
+				if (!glyph)
+					glyph = atlas->get_glyph('?');
+				if (!glyph)
+					return false;
+
+				out = { glyph->advance, glyph->plane_min.x, glyph->plane_min.y, glyph->plane_max.x, glyph->plane_max.y, glyph->uv_min,
+					glyph->uv_max, glyph->is_blank() ? 0 : glyph->page };
+				if (!glyph->is_blank())
+					layout.page_mask |= 1u << glyph->page;
+				return true;
+			};
+			auto get_advance = [&atlas](const GlyphInfo& glyph, char32_t character, char32_t next) {
+				return glyph.advance + atlas->get_kerning(character, next);
+			};
+
+			lay_out(layout, scratch, length, metrics, max_width, line_height_offset, kerning_offset, find_glyph, get_advance);
+
+			// After building: generating glyphs may itself have evicted a page, never one used here.
+			layout.atlas_generation = atlas->get_generation();
+			layout.incomplete = atlas->get_full_miss_count() != full_misses;
+			return;
+		}
+
+		const auto& font_geometry = font.get_msdf_data()->font_geometry;
+		const auto& font_metrics = font_geometry.getMetrics();
+		const LayoutMetrics metrics { 1 / (font_metrics.ascenderY - font_metrics.descenderY), font_metrics.lineHeight, font_metrics.ascenderY };
+
+		const auto& atlas = font.get_font_atlas();
+		const double texel_width = 1.0 / atlas->get_width();
+		const double texel_height = 1.0 / atlas->get_height();
+
+		auto find_glyph = [&](char32_t character, GlyphInfo& out) {
+			auto glyph = font_geometry.getGlyph(character);
+			if (!glyph)
+				glyph = font_geometry.getGlyph('?');
+			if (!glyph)
+				return false;
+
+			double l, b, r, t;
+			glyph->getQuadAtlasBounds(l, b, r, t);
+			out.advance = glyph->getAdvance();
+			glyph->getQuadPlaneBounds(out.pl, out.pb, out.pr, out.pt);
+			out.uv_min = { l * texel_width, b * texel_height };
+			out.uv_max = { r * texel_width, t * texel_height };
+			out.page = 0;
+			return true;
+		};
+		auto get_advance = [&font_geometry](const GlyphInfo& glyph, char32_t character, char32_t next) {
+			double advance = glyph.advance;
+			font_geometry.getAdvance(advance, character, next);
+			return advance;
+		};
+
+		lay_out(layout, scratch, length, metrics, max_width, line_height_offset, kerning_offset, find_glyph, get_advance);
+		layout.atlas_generation = 0;
+	}
+
+} // namespace ForgottenEngine
@@ -6,6 +6,7 @@
 
 #include "render/Texture.hpp"
 
+#include "null/NullTexture.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanTexture.hpp"
@@ -19,6 +20,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanTexture2D>::create(format, width, height, data, properties);
+		case RendererAPIType::Null:
+			return Reference<NullTexture2D>::create(format, width, height, data, properties);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -30,6 +33,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanTexture2D>::create(path, properties);
+		case RendererAPIType::Null:
+			return Reference<NullTexture2D>::create(path, properties);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -38,6 +43,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanTextureCube>::create(format, width, height, data, properties);
@@ -49,6 +55,7 @@ namespace ForgottenEngine {
 	{
 		switch (RendererAPI::current()) {
 		case RendererAPIType::None:
+		case RendererAPIType::Null:
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanTextureCube>::create(path, properties);
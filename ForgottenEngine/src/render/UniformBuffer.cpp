@@ -6,6 +6,7 @@
 
 #include "render/UniformBuffer.hpp"
 
+#include "null/NullUniformBuffer.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanUniformBuffer.hpp"
@@ -19,6 +20,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanUniformBuffer>::create(size, binding);
+		case RendererAPIType::Null:
+			return Reference<NullUniformBuffer>::create(size, binding);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -0,0 +1,29 @@
+#include "fg_pch.hpp"
+
+#include "render/UniformBufferRing.hpp"
+
+#include "null/NullUniformBufferRing.hpp"
+#include "render/Renderer.hpp"
+#include "render/RendererAPI.hpp"
+#include "vulkan/VulkanUniformBufferRing.hpp"
+
+namespace ForgottenEngine {
+
+	UniformBufferRing::UniformBufferRing() { Renderer::register_uniform_buffer_ring(this); }
+
+	UniformBufferRing::~UniformBufferRing() { Renderer::unregister_uniform_buffer_ring(this); }
+
+	Reference<UniformBufferRing> UniformBufferRing::create(uint32_t block_size, uint32_t block_count, uint32_t binding)
+	{
+		switch (RendererAPI::current()) {
+		case RendererAPIType::None:
+			return nullptr;
+		case RendererAPIType::Null:
+			return Reference<NullUniformBufferRing>::create(block_size, block_count, binding);
+		case RendererAPIType::Vulkan:
+			return Reference<VulkanUniformBufferRing>::create(block_size, block_count, binding);
+		}
+		core_assert(false, "Unknown RendererAPI");
+	}
+
+} // namespace ForgottenEngine
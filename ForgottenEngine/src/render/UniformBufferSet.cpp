@@ -6,6 +6,7 @@
 
 #include "render/UniformBufferSet.hpp"
 
+#include "null/NullUniformBuffer.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanUniformBufferSet.hpp"
@@ -19,6 +20,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanUniformBufferSet>::create(size);
+		case RendererAPIType::Null:
+			return Reference<NullUniformBufferSet>::create(size);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
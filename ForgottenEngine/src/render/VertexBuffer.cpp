@@ -2,6 +2,7 @@
 
 #include "render/VertexBuffer.hpp"
 
+#include "null/NullVertexBuffer.hpp"
 #include "render/Renderer.hpp"
 #include "render/RendererAPI.hpp"
 #include "vulkan/VulkanVertexBuffer.hpp"
@@ -15,6 +16,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanVertexBuffer>::create(data, size, usage);
+		case RendererAPIType::Null:
+			return Reference<NullVertexBuffer>::create(data, size, usage);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
@@ -25,6 +28,8 @@ namespace ForgottenEngine {
 			return nullptr;
 		case RendererAPIType::Vulkan:
 			return Reference<VulkanVertexBuffer>::create(size, usage);
+		case RendererAPIType::Null:
+			return Reference<NullVertexBuffer>::create(size, usage);
 		}
 		core_assert(false, "Unknown RendererAPI");
 	}
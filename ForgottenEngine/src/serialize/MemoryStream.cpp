@@ -20,6 +20,7 @@ namespace ForgottenEngine {
 			return false;
 
 		buffer.write(data, (uint32_t)size, (uint32_t)write_pos);
+		write_pos += size;
 		return true;
 	}
 
@@ -38,6 +39,7 @@ namespace ForgottenEngine {
 			return false;
 
 		memcpy(destination, (char*)buffer.data + read_pos, size);
+		read_pos += size;
 		return true;
 	}
 
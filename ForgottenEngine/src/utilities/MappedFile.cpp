@@ -0,0 +1,118 @@
+#include "fg_pch.hpp"
+
+#include "utilities/MappedFile.hpp"
+
+#ifdef FORGOTTEN_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ForgottenEngine {
+
+	MappedFile::~MappedFile() { close(); }
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		close();
+		data = std::exchange(other.data, nullptr);
+		size = std::exchange(other.size, 0);
+		file_handle = std::exchange(other.file_handle, nullptr);
+		mapping_handle = std::exchange(other.mapping_handle, nullptr);
+		return *this;
+	}
+
+#ifdef FORGOTTEN_WINDOWS
+	bool MappedFile::open(const std::filesystem::path& path)
+	{
+		close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		data = (const uint8_t*)view;
+		size = (size_t)file_size.QuadPart;
+		file_handle = file;
+		mapping_handle = mapping;
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (data)
+			UnmapViewOfFile(data);
+		if (mapping_handle)
+			CloseHandle(mapping_handle);
+		if (file_handle)
+			CloseHandle(file_handle);
+
+		data = nullptr;
+		size = 0;
+		file_handle = nullptr;
+		mapping_handle = nullptr;
+	}
+#else
+	bool MappedFile::open(const std::filesystem::path& path)
+	{
+		close();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat file_stat { };
+		if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+
+		void* view = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		// The mapping keeps the file referenced, the descriptor is not needed any more.
+		::close(fd);
+		if (view == MAP_FAILED)
+			return false;
+
+		data = (const uint8_t*)view;
+		size = (size_t)file_stat.st_size;
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (data)
+			munmap((void*)data, size);
+
+		data = nullptr;
+		size = 0;
+	}
+#endif
+
+} // namespace ForgottenEngine
@@ -56,6 +56,23 @@ namespace ForgottenEngine {
 		return allocation;
 	}
 
+	VmaAllocation VulkanAllocator::allocate_mapped_buffer(VkBufferCreateInfo bufferCreateInfo, VkBuffer& outBuffer, void*& outMappedData)
+	{
+		VmaAllocationCreateInfo allocCreateInfo = {};
+		allocCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+		allocCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		allocCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		VmaAllocation allocation;
+		VmaAllocationInfo allocInfo {};
+		vmaCreateBuffer(vma_data().allocator, &bufferCreateInfo, &allocCreateInfo, &outBuffer, &allocation, &allocInfo);
+
+		vma_data().total_allocated_bytes += allocInfo.size;
+		outMappedData = allocInfo.pMappedData;
+
+		return allocation;
+	}
+
 	VmaAllocation VulkanAllocator::allocate_image(VkImageCreateInfo imageCreateInfo, VmaMemoryUsage usage, VkImage& outImage)
 	{
 		VmaAllocationCreateInfo allocCreateInfo = {};
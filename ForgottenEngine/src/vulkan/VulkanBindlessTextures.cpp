@@ -0,0 +1,194 @@
+#include "fg_pch.hpp"
+
+#include "vulkan/VulkanBindlessTextures.hpp"
+
+#include "render/Renderer.hpp"
+#include "vulkan/VulkanContext.hpp"
+#include "vulkan/VulkanDevice.hpp"
+
+#include <mutex>
+
+namespace ForgottenEngine {
+
+	// Headroom for the per-material samplers that share a stage with the table.
+	static constexpr uint32_t reserved_samplers = 32;
+	static constexpr uint32_t max_capacity = 1u << 16;
+
+	struct BindlessTextureData {
+		std::mutex mutex;
+
+		bool capacity_queried = false;
+		uint32_t capacity = 0;
+		uint32_t next_index = VulkanBindlessTextures::white_texture_index + 1;
+		std::vector<uint32_t> free_indices;
+		bool warned_full = false;
+
+		VkDescriptorPool pool = nullptr;
+		VkDescriptorSetLayout layout = nullptr;
+		VkDescriptorSet set = nullptr;
+	};
+
+	static BindlessTextureData& bindless_data()
+	{
+		static BindlessTextureData data;
+		return data;
+	}
+
+	static uint32_t query_capacity(BindlessTextureData& data)
+	{
+		if (data.capacity_queried)
+			return data.capacity;
+
+		data.capacity_queried = true;
+		const auto& physical_device = VulkanContext::get_current_device()->get_physical_device();
+		if (!physical_device->supports_bindless_textures())
+			return data.capacity = 0;
+
+		const auto& limits = physical_device->get_descriptor_indexing_properties();
+		const uint32_t limit = std::min({ limits.maxDescriptorSetUpdateAfterBindSampledImages, limits.maxDescriptorSetUpdateAfterBindSamplers,
+			limits.maxPerStageDescriptorUpdateAfterBindSampledImages, limits.maxPerStageDescriptorUpdateAfterBindSamplers });
+		data.capacity = std::min(limit > reserved_samplers ? limit - reserved_samplers : 0, max_capacity);
+
+		CORE_INFO("[VulkanBindlessTextures] {} texture descriptors", data.capacity);
+		return data.capacity;
+	}
+
+	/// Called with the mutex held.
+	static void create_descriptor_set(BindlessTextureData& data)
+	{
+		if (data.set || !query_capacity(data))
+			return;
+
+		VkDevice device = VulkanContext::get_current_device()->get_vulkan_device();
+
+		VkDescriptorSetLayoutBinding binding = {};
+		binding.binding = 0;
+		binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		binding.descriptorCount = data.capacity;
+		binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		// Slots nobody wrote yet, or whose texture is gone, are fine as long as no shader reads them.
+		VkDescriptorBindingFlags binding_flags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+		VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info = {};
+		binding_flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+		binding_flags_info.bindingCount = 1;
+		binding_flags_info.pBindingFlags = &binding_flags;
+
+		VkDescriptorSetLayoutCreateInfo layout_info = {};
+		layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		layout_info.pNext = &binding_flags_info;
+		layout_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+		layout_info.bindingCount = 1;
+		layout_info.pBindings = &binding;
+		vk_check(vkCreateDescriptorSetLayout(device, &layout_info, nullptr, &data.layout));
+
+		VkDescriptorPoolSize pool_size = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, data.capacity };
+		VkDescriptorPoolCreateInfo pool_info = {};
+		pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+		pool_info.maxSets = 1;
+		pool_info.poolSizeCount = 1;
+		pool_info.pPoolSizes = &pool_size;
+		vk_check(vkCreateDescriptorPool(device, &pool_info, nullptr, &data.pool));
+
+		VkDescriptorSetAllocateInfo alloc_info = {};
+		alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool = data.pool;
+		alloc_info.descriptorSetCount = 1;
+		alloc_info.pSetLayouts = &data.layout;
+		vk_check(vkAllocateDescriptorSets(device, &alloc_info, &data.set));
+	}
+
+	bool VulkanBindlessTextures::is_supported() { return get_capacity() > 0; }
+
+	uint32_t VulkanBindlessTextures::get_capacity()
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+		return query_capacity(data);
+	}
+
+	uint32_t VulkanBindlessTextures::allocate()
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+
+		if (!data.free_indices.empty()) {
+			const uint32_t index = data.free_indices.back();
+			data.free_indices.pop_back();
+			return index;
+		}
+
+		if (data.next_index < query_capacity(data))
+			return data.next_index++;
+
+		if (data.capacity && !data.warned_full) {
+			CORE_WARN("[VulkanBindlessTextures] All {} texture descriptors are in use; new textures sample as white.", data.capacity);
+			data.warned_full = true;
+		}
+		return white_texture_index;
+	}
+
+	void VulkanBindlessTextures::release(uint32_t index)
+	{
+		if (index == white_texture_index)
+			return;
+
+		Renderer::submit_resource_free([index]() {
+			auto& data = bindless_data();
+			std::scoped_lock lock(data.mutex);
+			data.free_indices.push_back(index);
+		});
+	}
+
+	void VulkanBindlessTextures::rt_write(uint32_t index, const VkDescriptorImageInfo& image_info)
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+
+		create_descriptor_set(data);
+		if (!data.set || !image_info.imageView)
+			return;
+
+		VkWriteDescriptorSet write = {};
+		write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet = data.set;
+		write.dstBinding = 0;
+		write.dstArrayElement = index;
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		write.pImageInfo = &image_info;
+		vkUpdateDescriptorSets(VulkanContext::get_current_device()->get_vulkan_device(), 1, &write, 0, nullptr);
+	}
+
+	VkDescriptorSetLayout VulkanBindlessTextures::get_descriptor_set_layout()
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+		create_descriptor_set(data);
+		return data.layout;
+	}
+
+	VkDescriptorSet VulkanBindlessTextures::get_descriptor_set()
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+		create_descriptor_set(data);
+		return data.set;
+	}
+
+	void VulkanBindlessTextures::shut_down()
+	{
+		auto& data = bindless_data();
+		std::scoped_lock lock(data.mutex);
+
+		VkDevice device = VulkanContext::get_current_device()->get_vulkan_device();
+		if (data.pool)
+			vkDestroyDescriptorPool(device, data.pool, nullptr);
+
+		// Shader pipeline layouts keep referring to the set layout, and those are never destroyed either.
+		data.pool = nullptr;
+		data.set = nullptr;
+	}
+
+} // namespace ForgottenEngine
@@ -130,7 +130,7 @@ namespace ForgottenEngine {
 		core_assert(!active_command_buffer, "");
 
 		if (renderCommandBuffer) {
-			uint32_t frameIndex = Renderer::get_current_frame_index();
+			uint32_t frameIndex = Renderer::rt_get_current_frame_index();
 			active_command_buffer = renderCommandBuffer.as<VulkanRenderCommandBuffer>()->get_command_buffer(frameIndex);
 			using_graphics_queue = true;
 		} else {
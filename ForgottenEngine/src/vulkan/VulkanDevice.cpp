@@ -45,6 +45,23 @@ namespace ForgottenEngine {
 		vkGetPhysicalDeviceFeatures(physical_device, &features);
 		vkGetPhysicalDeviceMemoryProperties(physical_device, &memory_properties);
 
+		// Descriptor indexing is core in 1.2, which is also what the instance asks for.
+		if (properties.apiVersion >= VK_API_VERSION_1_2) {
+			descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+			timeline_semaphore_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+			descriptor_indexing_features.pNext = &timeline_semaphore_features;
+			VkPhysicalDeviceFeatures2 features2 {};
+			features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+			features2.pNext = &descriptor_indexing_features;
+			vkGetPhysicalDeviceFeatures2(physical_device, &features2);
+
+			descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+			VkPhysicalDeviceProperties2 properties2 {};
+			properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+			properties2.pNext = &descriptor_indexing_properties;
+			vkGetPhysicalDeviceProperties2(physical_device, &properties2);
+		}
+
 		uint32_t family_count;
 		vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count, nullptr);
 		core_assert_bool(family_count > 0);
@@ -183,6 +200,13 @@ namespace ForgottenEngine {
 		return indices;
 	}
 
+	bool VulkanPhysicalDevice::supports_bindless_textures() const
+	{
+		return descriptor_indexing_features.runtimeDescriptorArray && descriptor_indexing_features.descriptorBindingPartiallyBound
+			&& descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind
+			&& descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing;
+	}
+
 	Reference<VulkanPhysicalDevice> VulkanPhysicalDevice::select() { return Reference<VulkanPhysicalDevice>::create(); }
 
 	VulkanDevice::VulkanDevice(const Reference<VulkanPhysicalDevice>& p_device, VkPhysicalDeviceFeatures enabled)
@@ -204,6 +228,25 @@ namespace ForgottenEngine {
 		dci.pQueueCreateInfos = physical_device->queue_create_infos.data();
 		dci.pEnabledFeatures = &enabled_features;
 
+		// Timeline semaphores let VulkanUploadManager chain its transfer and graphics submissions without waiting.
+		VkPhysicalDeviceTimelineSemaphoreFeatures timeline_semaphore {};
+		timeline_semaphore.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+		if (physical_device->supports_timeline_semaphores()) {
+			timeline_semaphore.timelineSemaphore = VK_TRUE;
+			dci.pNext = &timeline_semaphore;
+		}
+
+		VkPhysicalDeviceDescriptorIndexingFeatures descriptor_indexing {};
+		descriptor_indexing.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+		if (physical_device->supports_bindless_textures()) {
+			descriptor_indexing.runtimeDescriptorArray = VK_TRUE;
+			descriptor_indexing.descriptorBindingPartiallyBound = VK_TRUE;
+			descriptor_indexing.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			descriptor_indexing.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			descriptor_indexing.pNext = (void*)dci.pNext;
+			dci.pNext = &descriptor_indexing;
+		}
+
 		// Enable the debug marker extension if it is present (likely meaning a debugging tool is present)
 		if (physical_device->is_extension_supported(VK_EXT_DEBUG_MARKER_EXTENSION_NAME)) {
 			device_exts.push_back(VK_EXT_DEBUG_MARKER_EXTENSION_NAME);
@@ -228,12 +271,21 @@ namespace ForgottenEngine {
 		// Get a graphics queue from the device
 		vkGetDeviceQueue(logical_device, physical_device->queue_family_indices.graphics, 0, &graphics_queue);
 		vkGetDeviceQueue(logical_device, physical_device->queue_family_indices.compute, 0, &compute_queue);
+
+		const auto& families = physical_device->queue_family_indices;
+		if (families.transfer != -1 && families.transfer != families.graphics)
+			vkGetDeviceQueue(logical_device, families.transfer, 0, &transfer_queue);
 	}
 
 	VulkanDevice::~VulkanDevice() = default;
 
 	void VulkanDevice::destroy()
 	{
+		if (upload_manager) {
+			upload_manager->destroy();
+			upload_manager = nullptr;
+		}
+
 		vkDestroyCommandPool(logical_device, command_pool, nullptr);
 		vkDestroyCommandPool(logical_device, compute_command_pool, nullptr);
 
@@ -241,6 +293,14 @@ namespace ForgottenEngine {
 		vkDestroyDevice(logical_device, nullptr);
 	}
 
+	const Reference<VulkanUploadManager>& VulkanDevice::get_upload_manager()
+	{
+		if (!upload_manager)
+			upload_manager = Reference<VulkanUploadManager>::create(*this);
+
+		return upload_manager;
+	}
+
 	VkCommandBuffer VulkanDevice::get_command_buffer(bool begin, bool compute)
 	{
 		VkCommandBuffer cmd_buffer;
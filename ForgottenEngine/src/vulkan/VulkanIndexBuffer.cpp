@@ -22,34 +22,13 @@ namespace ForgottenEngine {
 			auto device = VulkanContext::get_current_device();
 			VulkanAllocator allocator("IndexBuffer");
 
-			VkBufferCreateInfo bci {};
-			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			bci.size = instance->size;
-			bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VkBuffer stagingBuffer;
-			VmaAllocation stagingBufferAllocation = allocator.allocate_buffer(bci, VMA_MEMORY_USAGE_CPU_TO_GPU, stagingBuffer);
-
-			// Copy data to staging buffer
-			uint8_t* destData = allocator.map_memory<uint8_t>(stagingBufferAllocation);
-			memcpy(destData, instance->local_data.data, instance->local_data.size);
-			allocator.unmap_memory(stagingBufferAllocation);
-
 			VkBufferCreateInfo indexBufferCreateInfo = {};
 			indexBufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			indexBufferCreateInfo.size = instance->size;
 			indexBufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
 			instance->memory_allocation = allocator.allocate_buffer(indexBufferCreateInfo, VMA_MEMORY_USAGE_GPU_ONLY, instance->vulkan_buffer);
 
-			VkCommandBuffer copyCmd = device->get_command_buffer(true);
-
-			VkBufferCopy copyRegion = {};
-			copyRegion.size = instance->local_data.size;
-			vkCmdCopyBuffer(copyCmd, stagingBuffer, instance->vulkan_buffer, 1, &copyRegion);
-
-			device->flush_command_buffer(copyCmd);
-
-			allocator.destroy_buffer(stagingBuffer, stagingBufferAllocation);
+			device->get_upload_manager()->upload_buffer(instance->vulkan_buffer, instance->local_data.data, instance->local_data.size);
 		});
 	}
 
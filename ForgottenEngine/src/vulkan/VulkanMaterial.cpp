@@ -323,7 +323,7 @@ namespace ForgottenEngine {
 
 		std::vector<VkDescriptorImageInfo> array_image_infos;
 
-		uint32_t frame_index = Renderer::get_current_frame_index();
+		uint32_t frame_index = Renderer::rt_get_current_frame_index();
 		if (dirty_descriptor_sets[frame_index] || true) {
 			dirty_descriptor_sets[frame_index] = false;
 			write_descriptors[frame_index].clear();
@@ -77,6 +77,10 @@ namespace ForgottenEngine {
 			return VK_FORMAT_R32G32B32_SINT;
 		case ShaderDataType::Int4:
 			return VK_FORMAT_R32G32B32A32_SINT;
+		case ShaderDataType::UInt:
+			return VK_FORMAT_R32_UINT;
+		case ShaderDataType::UInt2:
+			return VK_FORMAT_R32G32_UINT;
 		default:
 			core_assert(false, "Unknown format");
 		}
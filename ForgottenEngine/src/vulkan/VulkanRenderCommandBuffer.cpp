@@ -98,7 +98,7 @@ namespace ForgottenEngine {
 	{
 		Reference<VulkanRenderCommandBuffer> instance = this;
 		Renderer::submit([instance]() mutable {
-			uint32_t frame_index = Renderer::get_current_frame_index();
+			uint32_t frame_index = Renderer::rt_get_current_frame_index();
 
 			VkCommandBufferBeginInfo cbi = {};
 			cbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -135,7 +135,7 @@ namespace ForgottenEngine {
 		Renderer::submit([instance]() mutable {
 			auto device = VulkanContext::get_current_device();
 
-			uint32_t frame_index = Renderer::get_current_frame_index();
+			uint32_t frame_index = Renderer::rt_get_current_frame_index();
 
 			VkSubmitInfo submit_info {};
 			submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -145,6 +145,7 @@ namespace ForgottenEngine {
 
 			vk_check(vkWaitForFences(device->get_vulkan_device(), 1, &instance->wait_fences[frame_index], VK_TRUE, UINT64_MAX));
 			vk_check(vkResetFences(device->get_vulkan_device(), 1, &instance->wait_fences[frame_index]));
+			device->get_upload_manager()->flush();
 			vk_check(vkQueueSubmit(device->get_graphics_queue(), 1, &submit_info, instance->wait_fences[frame_index]));
 		});
 	}
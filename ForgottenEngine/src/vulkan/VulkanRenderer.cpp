@@ -16,12 +16,15 @@
 #include "render/UniformBufferSet.hpp"
 #include "render/VertexBuffer.hpp"
 #include "vulkan/compiler/VulkanShaderCompiler.hpp"
+#include "vulkan/VulkanBindlessTextures.hpp"
 #include "vulkan/VulkanContext.hpp"
 #include "vulkan/VulkanFramebuffer.hpp"
 #include "vulkan/VulkanIndexBuffer.hpp"
 #include "vulkan/VulkanPipeline.hpp"
 #include "vulkan/VulkanRenderCommandBuffer.hpp"
 #include "vulkan/VulkanShader.hpp"
+#include "vulkan/VulkanTexture.hpp"
+#include "vulkan/VulkanUniformBufferRing.hpp"
 #include "vulkan/VulkanVertexBuffer.hpp"
 
 #include <vulkan/vulkan.h>
@@ -255,6 +258,23 @@ namespace ForgottenEngine {
 				for (auto&& [binding, shaderUB] : shader_descriptor_sets[0].uniform_buffers) {
 					auto& write_descriptors = renderer_data().uniform_buffer_write_descriptor_cache[ubs.raw()][shader_hash];
 					write_descriptors.resize(frames_in_flight);
+					if (VulkanShader::is_dynamic_uniform_buffer(shaderUB)) {
+						// One descriptor for every frame; the frame's region is picked by the dynamic offset.
+						Reference<VulkanUniformBufferRing> ring = ubs->get_ring(binding);
+						core_assert(ring, "Shader {} has dynamic uniform buffer {} but no UniformBufferRing is bound to it.", vulkan_shader->get_name(),
+							shaderUB.Name);
+
+						VkWriteDescriptorSet write_descriptor_set = {};
+						write_descriptor_set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						write_descriptor_set.descriptorCount = 1;
+						write_descriptor_set.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+						write_descriptor_set.pBufferInfo = &ring->get_descriptor_buffer_info();
+						write_descriptor_set.dstBinding = binding;
+						for (uint32_t frame = 0; frame < frames_in_flight; frame++)
+							write_descriptors[frame].push_back(write_descriptor_set);
+						continue;
+					}
+
 					for (uint32_t frame = 0; frame < frames_in_flight; frame++) {
 						Reference<VulkanUniformBuffer> uniform_buffer = ubs->get(binding, 0, frame); // set = 0 for now
 
@@ -313,6 +333,38 @@ namespace ForgottenEngine {
 		return renderer_data().storage_buffer_write_descriptor_cache[sbs.raw()][shader_hash];
 	}
 
+	/// Offsets of set 0's dynamic uniform buffers, read when the draw is submitted since the rings move on after it.
+	struct DynamicUniformOffsets {
+		std::array<uint32_t, 8> offsets {};
+		uint32_t count = 0;
+	};
+
+	static DynamicUniformOffsets get_dynamic_uniform_offsets(const Reference<UniformBufferSet>& ubs, const Reference<VulkanMaterial>& material)
+	{
+		DynamicUniformOffsets result;
+		if (!ubs || !material)
+			return result;
+
+		const auto& bindings = material->get_shader().as<VulkanShader>()->get_dynamic_uniform_buffer_bindings();
+		core_assert(bindings.size() <= result.offsets.size(), "Too many dynamic uniform buffers in one set.");
+		for (uint32_t binding : bindings) {
+			auto ring = ubs->get_ring(binding);
+			result.offsets[result.count++] = ring ? ring->get_offset() : 0;
+		}
+		return result;
+	}
+
+	static void rt_bind_bindless_textures(VkCommandBuffer command_buffer, const Reference<VulkanPipeline>& pipeline, VkPipelineLayout layout)
+	{
+		auto shader = pipeline->get_specification().shader.as<VulkanShader>();
+		auto set = shader->get_bindless_texture_set();
+		if (!set)
+			return;
+
+		VkDescriptorSet descriptor_set = VulkanBindlessTextures::get_descriptor_set();
+		vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, *set, 1, &descriptor_set, 0, nullptr);
+	}
+
 	void VulkanRenderer::init()
 	{
 		const auto& config = Renderer::get_config();
@@ -324,6 +376,17 @@ namespace ForgottenEngine {
 		caps.vendor = vulkan_vendor_to_identifier_string(properties.vendorID);
 		caps.device = properties.deviceName;
 		caps.version = std::to_string(properties.driverVersion);
+		caps.max_anisotropy = properties.limits.maxSamplerAnisotropy;
+		caps.max_texture_units = (int)properties.limits.maxPerStageDescriptorSamplers;
+		caps.bindless_textures = VulkanBindlessTextures::is_supported();
+		caps.max_bindless_textures = VulkanBindlessTextures::get_capacity();
+
+		if (caps.bindless_textures) {
+			// Slot 0 is what unsupported or overflowing allocations hand out, so it must hold something valid.
+			Renderer::submit([white_texture = Renderer::get_white_texture().as<VulkanTexture2D>()]() {
+				VulkanBindlessTextures::rt_write(VulkanBindlessTextures::white_texture_index, white_texture->get_vulkan_descriptor_info());
+			});
+		}
 
 		Renderer::submit([]() mutable {
 			// Create Descriptor Pool
@@ -389,8 +452,11 @@ namespace ForgottenEngine {
 		vkDeviceWaitIdle(device);
 
 		VulkanShaderCompiler::clear_uniform_buffers();
+		VulkanBindlessTextures::shut_down();
 	};
 
+	const RendererCapabilities& VulkanRenderer::get_capabilities() const { return renderer_data().render_caps; }
+
 	void VulkanRenderer::begin_frame()
 	{
 		Renderer::submit([]() {
@@ -514,7 +580,8 @@ namespace ForgottenEngine {
 		if (index_count == 0)
 			index_count = ib->get_count();
 
-		Renderer::submit([command_buffer, pipeline, ubs, vulkan_material, vb, ib, transform, index_count]() mutable {
+		const DynamicUniformOffsets dynamic_offsets = get_dynamic_uniform_offsets(ubs, vulkan_material);
+		Renderer::submit([command_buffer, pipeline, ubs, vulkan_material, vb, ib, transform, index_count, dynamic_offsets]() mutable {
 			VkCommandBuffer render_command_buffer = command_buffer.as<VulkanRenderCommandBuffer>()->get_active_command_buffer();
 
 			Reference<VulkanPipeline> vulkan_pipeline = pipeline.as<VulkanPipeline>();
@@ -528,17 +595,19 @@ namespace ForgottenEngine {
 			vulkan_material->rt_update_for_rendering(write_descriptors);
 			auto vulkan_mesh_vb = vb.as<VulkanVertexBuffer>();
 			VkBuffer vb_mesh_buffer = vulkan_mesh_vb->get_vulkan_buffer();
-			VkDeviceSize offsets[1] = { 0 };
+			VkDeviceSize offsets[1] = { vulkan_mesh_vb->rt_get_offset() };
 			vkCmdBindVertexBuffers(render_command_buffer, 0, 1, &vb_mesh_buffer, offsets);
 
 			auto vulkan_mesh_ib = ib.as<VulkanIndexBuffer>();
 			VkBuffer ib_mesh_buffer = vulkan_mesh_ib->get_vulkan_buffer();
 			vkCmdBindIndexBuffer(render_command_buffer, ib_mesh_buffer, 0, VK_INDEX_TYPE_UINT32);
 
-			uint32_t buffer_index = Renderer::get_current_frame_index();
+			uint32_t buffer_index = Renderer::rt_get_current_frame_index();
 			VkDescriptorSet descriptor_set = vulkan_material->get_descriptor_set(buffer_index);
 			if (descriptor_set)
-				vkCmdBindDescriptorSets(render_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptor_set, 0, nullptr);
+				vkCmdBindDescriptorSets(render_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptor_set, dynamic_offsets.count,
+					dynamic_offsets.offsets.data());
+			rt_bind_bindless_textures(render_command_buffer, vulkan_pipeline, layout);
 
 			vkCmdPushConstants(render_command_buffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &transform);
 			Buffer uniform_storage_buffers = vulkan_material->get_uniform_storage_buffer();
@@ -550,12 +619,60 @@ namespace ForgottenEngine {
 		});
 	}
 
+	void VulkanRenderer::render_instanced_geometry(Reference<RenderCommandBuffer> command_buffer, Reference<Pipeline> pipeline,
+		Reference<UniformBufferSet> ubs, Reference<StorageBufferSet> sbs, Reference<Material> material, Reference<VertexBuffer> vb,
+		Reference<IndexBuffer> ib, Reference<VertexBuffer> instance_vb, const glm::mat4& transform, uint32_t index_count, uint32_t instance_count)
+	{
+		Reference<VulkanMaterial> vulkan_material = material.as<VulkanMaterial>();
+		if (index_count == 0)
+			index_count = ib->get_count();
+
+		const DynamicUniformOffsets dynamic_offsets = get_dynamic_uniform_offsets(ubs, vulkan_material);
+		Renderer::submit([command_buffer, pipeline, ubs, vulkan_material, vb, ib, instance_vb, transform, index_count, instance_count,
+							 dynamic_offsets]() mutable {
+			VkCommandBuffer render_command_buffer = command_buffer.as<VulkanRenderCommandBuffer>()->get_active_command_buffer();
+
+			Reference<VulkanPipeline> vulkan_pipeline = pipeline.as<VulkanPipeline>();
+
+			VkPipelineLayout layout = vulkan_pipeline->get_vulkan_pipeline_layout();
+
+			VkPipeline vk_pipeline = vulkan_pipeline->get_vulkan_pipeline();
+			vkCmdBindPipeline(render_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vk_pipeline);
+
+			const auto& write_descriptors = rt_retrieve_or_create_uniform_buffer_write_descriptors(ubs, vulkan_material);
+			vulkan_material->rt_update_for_rendering(write_descriptors);
+
+			// Binding 0 is the per-vertex layout, binding 1 the per-instance one; see VulkanPipeline::invalidate.
+			auto vulkan_vb = vb.as<VulkanVertexBuffer>();
+			auto vulkan_instance_vb = instance_vb.as<VulkanVertexBuffer>();
+			VkBuffer vertex_buffers[2] = { vulkan_vb->get_vulkan_buffer(), vulkan_instance_vb->get_vulkan_buffer() };
+			VkDeviceSize offsets[2] = { vulkan_vb->rt_get_offset(), vulkan_instance_vb->rt_get_offset() };
+			vkCmdBindVertexBuffers(render_command_buffer, 0, 2, vertex_buffers, offsets);
+
+			auto vulkan_mesh_ib = ib.as<VulkanIndexBuffer>();
+			VkBuffer ib_mesh_buffer = vulkan_mesh_ib->get_vulkan_buffer();
+			vkCmdBindIndexBuffer(render_command_buffer, ib_mesh_buffer, 0, VK_INDEX_TYPE_UINT32);
+
+			uint32_t buffer_index = Renderer::rt_get_current_frame_index();
+			VkDescriptorSet descriptor_set = vulkan_material->get_descriptor_set(buffer_index);
+			if (descriptor_set)
+				vkCmdBindDescriptorSets(render_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptor_set, dynamic_offsets.count,
+					dynamic_offsets.offsets.data());
+			rt_bind_bindless_textures(render_command_buffer, vulkan_pipeline, layout);
+
+			vkCmdPushConstants(render_command_buffer, layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &transform);
+
+			vkCmdDrawIndexed(render_command_buffer, index_count, instance_count, 0, 0, 0);
+		});
+	}
+
 	void VulkanRenderer::submit_fullscreen_quad(const Reference<RenderCommandBuffer>& command_buffer, const Reference<Pipeline>& pipeline_in,
 		const Reference<UniformBufferSet>& ub, const Reference<StorageBufferSet>& sb, const Reference<Material>& material)
 	{
 
 		Reference<VulkanMaterial> vulkan_material = material.as<VulkanMaterial>();
-		Renderer::submit([this, command_buffer, pipe = pipeline_in, ubs = ub, sbs = sb, vulkan_material]() mutable {
+		const DynamicUniformOffsets dynamic_offsets = get_dynamic_uniform_offsets(ub, vulkan_material);
+		Renderer::submit([this, command_buffer, pipe = pipeline_in, ubs = ub, sbs = sb, vulkan_material, dynamic_offsets]() mutable {
 			VkCommandBuffer commandBuffer = command_buffer.as<VulkanRenderCommandBuffer>()->get_active_command_buffer();
 
 			Reference<VulkanPipeline> vulkanPipeline = pipe.as<VulkanPipeline>();
@@ -576,10 +693,11 @@ namespace ForgottenEngine {
 
 			this->rt_update_material_for_rendering(vulkan_material, ubs, sbs);
 
-			uint32_t bufferIndex = Renderer::get_current_frame_index();
+			uint32_t bufferIndex = Renderer::rt_get_current_frame_index();
 			VkDescriptorSet descriptorSet = vulkan_material->get_descriptor_set(bufferIndex);
 			if (descriptorSet)
-				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, 0, nullptr);
+				vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, 1, &descriptorSet, dynamic_offsets.count,
+					dynamic_offsets.offsets.data());
 
 			Buffer uniformStorageBuffer = vulkan_material->get_uniform_storage_buffer();
 			if (uniformStorageBuffer.size)
@@ -621,7 +739,7 @@ namespace ForgottenEngine {
 
 	VkDescriptorSet VulkanRenderer::rt_allocate_descriptor_set(VkDescriptorSetAllocateInfo alloc_info)
 	{
-		uint32_t buffer_index = Renderer::get_current_frame_index();
+		uint32_t buffer_index = Renderer::rt_get_current_frame_index();
 		alloc_info.descriptorPool = renderer_data().descriptor_pools[buffer_index];
 		VkDevice device = VulkanContext::get_current_device()->get_vulkan_device();
 		VkDescriptorSet result;
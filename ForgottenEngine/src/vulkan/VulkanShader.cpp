@@ -5,6 +5,7 @@
 #include "render/Renderer.hpp"
 #include "spirv_cross.hpp"
 #include "vulkan/compiler/VulkanShaderCompiler.hpp"
+#include "vulkan/VulkanBindlessTextures.hpp"
 #include "vulkan/VulkanContext.hpp"
 #include "vulkan/VulkanRenderer.hpp"
 
@@ -54,6 +55,38 @@ namespace ForgottenEngine {
 
 	} // namespace Utils
 
+	static bool is_bindless_texture_set(const ShaderResource::ShaderDescriptorSet& set)
+	{
+		if (set.image_samplers.size() != 1 || !set.uniform_buffers.empty() || !set.storage_buffers.empty() || !set.storage_images.empty()
+			|| !set.separate_textures.empty() || !set.separate_samplers.empty())
+			return false;
+
+		const auto& [binding, image_sampler] = *set.image_samplers.begin();
+		return binding == 0 && image_sampler.ArraySize == 0;
+	}
+
+	bool VulkanShader::is_dynamic_uniform_buffer(const ShaderResource::UniformBuffer& uniform_buffer)
+	{
+		return uniform_buffer.Name.starts_with("Dynamic");
+	}
+
+	/// Pool sizes for a set's uniform buffers, split into plain and dynamic ones.
+	static void add_uniform_buffer_pool_sizes(
+		std::vector<VkDescriptorPoolSize>& pool_sizes, const ShaderResource::ShaderDescriptorSet& set, uint32_t number_of_sets)
+	{
+		uint32_t dynamic_count = 0;
+		for (auto&& [binding, uniform_buffer] : set.uniform_buffers) {
+			if (VulkanShader::is_dynamic_uniform_buffer(uniform_buffer))
+				dynamic_count++;
+		}
+
+		const auto static_count = (uint32_t)set.uniform_buffers.size() - dynamic_count;
+		if (static_count)
+			pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, static_count * number_of_sets });
+		if (dynamic_count)
+			pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, dynamic_count * number_of_sets });
+	}
+
 	static ShaderType to_shader_type(const std::string& path)
 	{
 		if (path == ".vert") {
@@ -99,6 +132,8 @@ namespace ForgottenEngine {
 		stage_create_infos.clear();
 		descriptor_set_layouts.clear();
 		type_counts.clear();
+		bindless_texture_set.reset();
+		dynamic_uniform_buffer_bindings.clear();
 	}
 
 	VulkanShader::~VulkanShader()
@@ -160,14 +195,21 @@ namespace ForgottenEngine {
 		//////////////////////////////////////////////////////////////////////
 
 		type_counts.clear();
+		bindless_texture_set.reset();
+		dynamic_uniform_buffer_bindings.clear();
 		for (uint32_t set = 0; set < reflection_data.shader_descriptor_sets.size(); set++) {
 			auto& shader_desc_set = reflection_data.shader_descriptor_sets[set];
 
-			if (!shader_desc_set.uniform_buffers.empty()) {
-				VkDescriptorPoolSize& typeCount = type_counts[set].emplace_back();
-				typeCount.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-				typeCount.descriptorCount = (uint32_t)(shader_desc_set.uniform_buffers.size());
+			if (is_bindless_texture_set(shader_desc_set) && VulkanBindlessTextures::is_supported()) {
+				if (set >= descriptor_set_layouts.size())
+					descriptor_set_layouts.resize((set + 1));
+				descriptor_set_layouts[set] = VulkanBindlessTextures::get_descriptor_set_layout();
+				bindless_texture_set = set;
+				continue;
 			}
+
+			if (!shader_desc_set.uniform_buffers.empty())
+				add_uniform_buffer_pool_sizes(type_counts[set], shader_desc_set, 1);
 			if (!shader_desc_set.storage_buffers.empty()) {
 				VkDescriptorPoolSize& typeCount = type_counts[set].emplace_back();
 				typeCount.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
@@ -200,8 +242,14 @@ namespace ForgottenEngine {
 
 			std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
 			for (auto& [binding, uniformBuffer] : shader_desc_set.uniform_buffers) {
+				const bool dynamic = is_dynamic_uniform_buffer(uniformBuffer);
+				if (dynamic && set == 0) {
+					auto& bindings = dynamic_uniform_buffer_bindings;
+					bindings.insert(std::upper_bound(bindings.begin(), bindings.end(), binding), binding);
+				}
+
 				VkDescriptorSetLayoutBinding& layoutBinding = layoutBindings.emplace_back();
-				layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				layoutBinding.descriptorType = dynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 				layoutBinding.descriptorCount = 1;
 				layoutBinding.stageFlags = uniformBuffer.ShaderStage;
 				layoutBinding.pImmutableSamplers = nullptr;
@@ -235,7 +283,7 @@ namespace ForgottenEngine {
 			for (auto& [binding, imageSampler] : shader_desc_set.image_samplers) {
 				auto& layoutBinding = layoutBindings.emplace_back();
 				layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-				layoutBinding.descriptorCount = imageSampler.ArraySize;
+				layoutBinding.descriptorCount = std::max(imageSampler.ArraySize, 1u);
 				layoutBinding.stageFlags = imageSampler.ShaderStage;
 				layoutBinding.pImmutableSamplers = nullptr;
 				layoutBinding.binding = binding;
@@ -247,7 +295,7 @@ namespace ForgottenEngine {
 				set = {};
 				set.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				set.descriptorType = layoutBinding.descriptorType;
-				set.descriptorCount = imageSampler.ArraySize;
+				set.descriptorCount = layoutBinding.descriptorCount;
 				set.dstBinding = layoutBinding.binding;
 			}
 
@@ -393,11 +441,8 @@ namespace ForgottenEngine {
 			if (!shader_desc_set) // Empty descriptor set
 				continue;
 
-			if (!shader_desc_set.uniform_buffers.empty()) {
-				VkDescriptorPoolSize& typeCount = poolSizes[set].emplace_back();
-				typeCount.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-				typeCount.descriptorCount = (uint32_t)shader_desc_set.uniform_buffers.size() * numberOfSets;
-			}
+			if (!shader_desc_set.uniform_buffers.empty())
+				add_uniform_buffer_pool_sizes(poolSizes[set], shader_desc_set, numberOfSets);
 
 			if (!shader_desc_set.storage_buffers.empty()) {
 				VkDescriptorPoolSize& typeCount = poolSizes[set].emplace_back();
@@ -410,7 +455,7 @@ namespace ForgottenEngine {
 				typeCount.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 				uint32_t descriptorSetCount = 0;
 				for (auto&& [binding, imageSampler] : shader_desc_set.image_samplers)
-					descriptorSetCount += imageSampler.ArraySize;
+					descriptorSetCount += std::max(imageSampler.ArraySize, 1u);
 
 				typeCount.descriptorCount = descriptorSetCount * numberOfSets;
 			}
@@ -443,6 +443,9 @@ namespace ForgottenEngine {
 		present_submit_info.pCommandBuffers = &command_buffers[current_image_index].buffer;
 		present_submit_info.commandBufferCount = 1;
 
+		// Uploads recorded this frame go ahead of the frame that draws with them.
+		VulkanContext::get_current_device()->get_upload_manager()->flush();
+
 		vk_check(vkResetFences(get_device(), 1, &wait_fences[current_image_index]));
 		vk_check(vkQueueSubmit(VulkanContext::get_current_device()->get_graphics_queue(), 1, &present_submit_info, wait_fences[current_image_index]));
 
@@ -460,9 +463,12 @@ namespace ForgottenEngine {
 			result = vkQueuePresentKHR(VulkanContext::get_current_device()->get_graphics_queue(), &present_info);
 		}
 
+		const auto& config = Renderer::get_config();
 		if (result != VK_SUCCESS) {
 			if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
 				on_resize(width, height);
+				// The frame still used its slot; the main thread has moved on to the next one.
+				current_buffer_index = (current_buffer_index + 1) % config.frames_in_flight;
 				return;
 			} else {
 				vk_check(result);
@@ -470,7 +476,6 @@ namespace ForgottenEngine {
 		}
 
 		{
-			const auto& config = Renderer::get_config();
 			current_buffer_index = (current_buffer_index + 1) % config.frames_in_flight;
 			// Make sure the frame we're requesting has finished rendering
 			vk_check(vkWaitForFences(get_device(), 1, &wait_fences[current_image_index], VK_TRUE, default_fence_timeout));
@@ -4,6 +4,7 @@
 
 #include "render/Renderer.hpp"
 #include "stb_image.h"
+#include "vulkan/VulkanBindlessTextures.hpp"
 #include "vulkan/VulkanContext.hpp"
 #include "vulkan/VulkanDevice.hpp"
 #include "vulkan/VulkanImage.hpp"
@@ -78,6 +79,7 @@ namespace ForgottenEngine {
 	VulkanTexture2D::VulkanTexture2D(const std::string& path, const TextureProperties& properties)
 		: path(path)
 		, properties(properties)
+		, bindless_index(VulkanBindlessTextures::allocate())
 	{
 		bool loaded = load_image(path);
 		core_assert_bool(loaded);
@@ -104,6 +106,7 @@ namespace ForgottenEngine {
 		, height(height)
 		, properties(properties)
 		, format(format)
+		, bindless_index(VulkanBindlessTextures::allocate())
 	{
 		auto size = (uint32_t)Utils::get_memory_size(format, width, height);
 
@@ -129,6 +132,8 @@ namespace ForgottenEngine {
 		if (image)
 			image->release();
 
+		VulkanBindlessTextures::release(bindless_index);
+
 		image_data.release();
 	}
 
@@ -188,84 +193,15 @@ namespace ForgottenEngine {
 		auto& info = reference->get_image_info();
 
 		if (image_data) {
-			VkDeviceSize size = image_data.size;
-
-			VkMemoryAllocateInfo mem_alloc_info {};
-			mem_alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-
-			VulkanAllocator allocator("Texture2D");
-
-			// Create staging buffer
-			VkBufferCreateInfo buffer_create_info {};
-			buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			buffer_create_info.size = size;
-			buffer_create_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VkBuffer staging_buffer;
-			VmaAllocation staging_buffer_allocation = allocator.allocate_buffer(buffer_create_info, VMA_MEMORY_USAGE_CPU_TO_GPU, staging_buffer);
-
-			// Copy data to staging buffer
-			auto* dest_data = allocator.map_memory<uint8_t>(staging_buffer_allocation);
-			core_assert_bool(image_data.data);
-			memcpy(dest_data, image_data.data, size);
-			allocator.unmap_memory(staging_buffer_allocation);
-
-			VkCommandBuffer copy_cmd = device->get_command_buffer(true);
-
-			// Image memory barriers for the texture reference
-
-			// The sub resource range describes the regions of the reference that will be transitioned using the memory
-			// barriers below
-			VkImageSubresourceRange subresource_range = {};
-			// Image only contains color data
-			subresource_range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			// Start at first mip level
-			subresource_range.baseMipLevel = 0;
-			subresource_range.levelCount = 1;
-			subresource_range.layerCount = 1;
-
-			// Transition the texture reference layout to transfer target, so we can safely copy our buffer data to it.
-			VkImageMemoryBarrier image_memory_barrier {};
-			image_memory_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			image_memory_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-			image_memory_barrier.image = info.image;
-			image_memory_barrier.subresourceRange = subresource_range;
-			image_memory_barrier.srcAccessMask = 0;
-			image_memory_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			image_memory_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			image_memory_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-
-			vkCmdPipelineBarrier(
-				copy_cmd, VK_PIPELINE_STAGE_HOST_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &image_memory_barrier);
-
-			VkBufferImageCopy buffer_copy_region = {};
-			buffer_copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			buffer_copy_region.imageSubresource.mipLevel = 0;
-			buffer_copy_region.imageSubresource.baseArrayLayer = 0;
-			buffer_copy_region.imageSubresource.layerCount = 1;
-			buffer_copy_region.imageExtent.width = width;
-			buffer_copy_region.imageExtent.height = height;
-			buffer_copy_region.imageExtent.depth = 1;
-			buffer_copy_region.bufferOffset = 0;
-
-			vkCmdCopyBufferToImage(copy_cmd, staging_buffer, info.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_copy_region);
-
-			if (mip_count > 1) // Mips to generate
-			{
-				Utils::insert_image_memory_barrier(copy_cmd, info.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
-					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
-					VK_PIPELINE_STAGE_TRANSFER_BIT, subresource_range);
+			// Recorded into the upload manager's batch; the texture is ready once the batch has run, ahead of any frame using it.
+			auto& upload_manager = device->get_upload_manager();
+			if (mip_count > 1) {
+				upload_manager->upload_image(info.image, image_data.data, image_data.size, width, height,
+					[this](VkCommandBuffer command_buffer) { record_mips(command_buffer); });
 			} else {
-				Utils::insert_image_memory_barrier(copy_cmd, info.image, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
-					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, reference->get_descriptor_info().imageLayout, VK_PIPELINE_STAGE_TRANSFER_BIT,
-					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresource_range);
+				upload_manager->upload_image(
+					info.image, image_data.data, image_data.size, width, height, reference->get_descriptor_info().imageLayout);
 			}
-
-			device->flush_command_buffer(copy_cmd);
-
-			// Clean up staging resources
-			allocator.destroy_buffer(staging_buffer, staging_buffer_allocation);
 		} else {
 			VkCommandBuffer transition_command_buffer = device->get_command_buffer(true);
 			VkImageSubresourceRange subresource_range = {};
@@ -329,8 +265,8 @@ namespace ForgottenEngine {
 			reference->update_descriptor();
 		}
 
-		if (image_data && properties.GenerateMips && mip_count > 1)
-			generate_mips();
+		if (bindless_index != VulkanBindlessTextures::white_texture_index)
+			VulkanBindlessTextures::rt_write(bindless_index, get_vulkan_descriptor_info());
 
 		stbi_image_free(image_data.data);
 		image_data = Buffer();
@@ -363,16 +299,27 @@ namespace ForgottenEngine {
 	{
 		auto device = VulkanContext::get_current_device();
 
+		// Mip 0 may still be waiting in the upload batch.
+		device->get_upload_manager()->flush();
+
+		const VkCommandBuffer blit_cmd = device->get_command_buffer(true);
+		record_mips(blit_cmd);
+		device->flush_command_buffer(blit_cmd);
+	}
+
+	void VulkanTexture2D::record_mips(VkCommandBuffer blit_cmd)
+	{
 		auto img = this->image.as<VulkanImage2D>();
 		const auto& info = img->get_image_info();
 
-		const VkCommandBuffer blit_cmd = VulkanContext::get_current_device()->get_command_buffer(true);
+		VkImageSubresourceRange first_mip_range = {};
+		first_mip_range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		first_mip_range.levelCount = 1;
+		first_mip_range.layerCount = 1;
 
-		VkImageMemoryBarrier barrier = {};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.image = info.image;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		Utils::insert_image_memory_barrier(blit_cmd, info.image, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			first_mip_range);
 
 		const auto mip_levels = get_mip_level_count();
 		for (uint32_t i = 1; i < mip_levels; i++) {
@@ -423,8 +370,6 @@ namespace ForgottenEngine {
 		Utils::insert_image_memory_barrier(blit_cmd, info.image, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT,
 			VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT,
 			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, subresource_range);
-
-		device->flush_command_buffer(blit_cmd);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////
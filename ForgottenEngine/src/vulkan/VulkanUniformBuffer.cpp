@@ -16,8 +16,6 @@ namespace ForgottenEngine {
 		: size(in_size)
 		, binding(in_binding)
 	{
-		local_storage = hnew uint8_t[in_size];
-
 		Reference<VulkanUniformBuffer> instance = this;
 		Renderer::submit([instance]() mutable { instance->rt_invalidate(); });
 	}
@@ -36,9 +34,6 @@ namespace ForgottenEngine {
 
 		vk_buffer = nullptr;
 		memory_alloc = nullptr;
-
-		delete[] local_storage;
-		local_storage = nullptr;
 	}
 
 	void VulkanUniformBuffer::rt_invalidate()
@@ -68,10 +63,11 @@ namespace ForgottenEngine {
 
 	void VulkanUniformBuffer::set_data(const void* data, uint32_t in_size, uint32_t offset)
 	{
-		// TODO: local storage should be potentially replaced with render thread storage
-		memcpy(local_storage, data, in_size);
+		// A copy per call: the render thread may still be reading an earlier one when the next frame sets new data.
+		auto* copy = Renderer::get_frame_allocator().allocate_array<uint8_t>(in_size);
+		memcpy(copy, data, in_size);
 		Reference<VulkanUniformBuffer> instance = this;
-		Renderer::submit([instance, in_size, offset]() mutable { instance->render_thread_set_data(instance->local_storage, in_size, offset); });
+		Renderer::submit([instance, copy, in_size, offset]() mutable { instance->render_thread_set_data(copy, in_size, offset); });
 	}
 
 	void VulkanUniformBuffer::render_thread_set_data(const void* data, uint32_t in_size, uint32_t offset)
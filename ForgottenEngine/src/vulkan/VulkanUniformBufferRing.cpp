@@ -0,0 +1,67 @@
+#include "fg_pch.hpp"
+
+#include "vulkan/VulkanUniformBufferRing.hpp"
+
+#include "render/Renderer.hpp"
+#include "vulkan/VulkanAllocator.hpp"
+#include "vulkan/VulkanContext.hpp"
+
+namespace ForgottenEngine {
+
+	static uint32_t align_up(uint32_t value, uint32_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+	VulkanUniformBufferRing::VulkanUniformBufferRing(uint32_t block_size, uint32_t block_count, uint32_t binding)
+		: block_size(block_size)
+		, binding(binding)
+	{
+		const auto& limits = VulkanContext::get_current_device()->get_physical_device()->get_limits();
+		core_assert(block_size <= limits.maxUniformBufferRange, "Uniform block is larger than maxUniformBufferRange.");
+
+		alignment = (uint32_t)std::max<VkDeviceSize>(limits.minUniformBufferOffsetAlignment, 1);
+		frame_size = align_up(block_size, alignment) * block_count;
+
+		// Created here rather than on the render thread, so blocks can be pushed straight away.
+		VkBufferCreateInfo buffer_info = {};
+		buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		buffer_info.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+		buffer_info.size = (VkDeviceSize)frame_size * Renderer::get_config().frames_in_flight;
+
+		VulkanAllocator allocator("UniformBufferRing");
+		void* mapped = nullptr;
+		memory_alloc = allocator.allocate_mapped_buffer(buffer_info, vk_buffer, mapped);
+		mapped_data = (uint8_t*)mapped;
+
+		descriptor_buffer_info.buffer = vk_buffer;
+		descriptor_buffer_info.offset = 0;
+		descriptor_buffer_info.range = block_size;
+
+		begin_frame();
+	}
+
+	VulkanUniformBufferRing::~VulkanUniformBufferRing()
+	{
+		Renderer::submit_resource_free([buffer = vk_buffer, memory_alloc = memory_alloc]() {
+			VulkanAllocator allocator("UniformBufferRing");
+			allocator.destroy_buffer(buffer, memory_alloc);
+		});
+	}
+
+	void VulkanUniformBufferRing::begin_frame()
+	{
+		frame_start = Renderer::get_current_frame_index() * frame_size;
+		head = 0;
+		offset = frame_start;
+	}
+
+	uint32_t VulkanUniformBufferRing::push(const void* data, uint32_t size)
+	{
+		core_assert(size <= block_size, "Uniform block is larger than the ring's block size.");
+		core_assert(head + block_size <= frame_size, "UniformBufferRing is full for this frame.");
+
+		offset = frame_start + head;
+		memcpy(mapped_data + offset, data, size);
+		head += align_up(block_size, alignment);
+		return offset;
+	}
+
+} // namespace ForgottenEngine
@@ -30,4 +30,12 @@ namespace ForgottenEngine {
 	{
 		frame_ubs[frame][set][buffer->get_binding()] = buffer;
 	}
+
+	void VulkanUniformBufferSet::set_ring(const Reference<UniformBufferRing>& ring) { rings[ring->get_binding()] = ring; }
+
+	Reference<UniformBufferRing> VulkanUniformBufferSet::get_ring(uint32_t binding)
+	{
+		auto it = rings.find(binding);
+		return it != rings.end() ? it->second : nullptr;
+	}
 } // namespace ForgottenEngine
\ No newline at end of file
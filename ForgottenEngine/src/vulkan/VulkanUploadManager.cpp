@@ -0,0 +1,481 @@
+#include "fg_pch.hpp"
+
+#include "vulkan/VulkanUploadManager.hpp"
+
+#include "vulkan/VulkanAllocator.hpp"
+#include "vulkan/VulkanDevice.hpp"
+
+namespace ForgottenEngine {
+
+	namespace {
+		constexpr VkDeviceSize staging_alignment = 16;
+
+		constexpr VkAccessFlags buffer_read_access
+			= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		constexpr VkPipelineStageFlags buffer_read_stages = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT
+			| VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		VkImageSubresourceRange first_mip_range()
+		{
+			VkImageSubresourceRange range {};
+			range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			range.baseMipLevel = 0;
+			range.levelCount = 1;
+			range.layerCount = 1;
+			return range;
+		}
+
+		VkImageMemoryBarrier image_barrier(VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, VkAccessFlags src_access,
+			VkAccessFlags dst_access, uint32_t src_family = VK_QUEUE_FAMILY_IGNORED, uint32_t dst_family = VK_QUEUE_FAMILY_IGNORED)
+		{
+			VkImageMemoryBarrier barrier {};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.image = image;
+			barrier.subresourceRange = first_mip_range();
+			barrier.oldLayout = old_layout;
+			barrier.newLayout = new_layout;
+			barrier.srcAccessMask = src_access;
+			barrier.dstAccessMask = dst_access;
+			barrier.srcQueueFamilyIndex = src_family;
+			barrier.dstQueueFamilyIndex = dst_family;
+			return barrier;
+		}
+	} // namespace
+
+	VulkanUploadManager::VulkanUploadManager(VulkanDevice& vulkan_device, VkDeviceSize staging_size)
+		: device(vulkan_device.get_vulkan_device())
+		, ring_size(staging_size)
+	{
+		const auto& physical_device = vulkan_device.get_physical_device();
+		const auto& families = physical_device->get_queue_family_indices();
+
+		timeline_semaphores = physical_device->supports_timeline_semaphores();
+		graphics_family = (uint32_t)families.graphics;
+		graphics_queue = vulkan_device.get_graphics_queue();
+
+		// A transfer family of its own only pays off when the two submissions can be chained on the GPU.
+		dedicated_transfer = timeline_semaphores && families.transfer != -1 && families.transfer != families.graphics;
+		transfer_family = dedicated_transfer ? (uint32_t)families.transfer : graphics_family;
+		transfer_queue = dedicated_transfer ? vulkan_device.get_transfer_queue() : graphics_queue;
+		next_value = dedicated_transfer ? 2 : 1;
+
+		VkCommandPoolCreateInfo pool_info = {};
+		pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		pool_info.queueFamilyIndex = graphics_family;
+		vk_check(vkCreateCommandPool(device, &pool_info, nullptr, &graphics_command_pool));
+		if (dedicated_transfer) {
+			pool_info.queueFamilyIndex = transfer_family;
+			vk_check(vkCreateCommandPool(device, &pool_info, nullptr, &transfer_command_pool));
+		} else {
+			transfer_command_pool = graphics_command_pool;
+		}
+
+		if (timeline_semaphores) {
+			VkSemaphoreTypeCreateInfo type_info = {};
+			type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+			type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+			type_info.initialValue = 0;
+
+			VkSemaphoreCreateInfo semaphore_info = {};
+			semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+			semaphore_info.pNext = &type_info;
+			vk_check(vkCreateSemaphore(device, &semaphore_info, nullptr, &timeline));
+		} else {
+			VkFenceCreateInfo fence_info = {};
+			fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+			vk_check(vkCreateFence(device, &fence_info, nullptr, &fence));
+		}
+
+		VulkanAllocator allocator("UploadManager");
+		VkBufferCreateInfo bci = {};
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.size = ring_size;
+		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+		void* mapped = nullptr;
+		ring_allocation = allocator.allocate_mapped_buffer(bci, ring_buffer, mapped);
+		ring_data = (uint8_t*)mapped;
+	}
+
+	VulkanUploadManager::~VulkanUploadManager() = default;
+
+	void VulkanUploadManager::destroy()
+	{
+		if (!ring_buffer)
+			return;
+
+		wait(flush());
+		retire_completed();
+
+		if (transfer_command_pool != graphics_command_pool)
+			vkDestroyCommandPool(device, transfer_command_pool, nullptr);
+		vkDestroyCommandPool(device, graphics_command_pool, nullptr);
+		if (timeline)
+			vkDestroySemaphore(device, timeline, nullptr);
+		if (fence)
+			vkDestroyFence(device, fence, nullptr);
+
+		VulkanAllocator allocator("UploadManager");
+		allocator.destroy_buffer(ring_buffer, ring_allocation);
+		ring_buffer = nullptr;
+		ring_data = nullptr;
+	}
+
+	UploadTicket VulkanUploadManager::upload_buffer(VkBuffer destination, const void* data, VkDeviceSize size, VkDeviceSize offset)
+	{
+		StagingAllocation staging = allocate_staging(size);
+		memcpy(staging.data, data, size);
+
+		Batch& batch = open_batch();
+
+		VkBufferCopy region = {};
+		region.srcOffset = staging.offset;
+		region.dstOffset = offset;
+		region.size = size;
+		vkCmdCopyBuffer(batch.transfer_command_buffer, staging.buffer, destination, 1, &region);
+
+		VkBufferMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		barrier.buffer = destination;
+		barrier.offset = offset;
+		barrier.size = size;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		if (dedicated_transfer) {
+			// Release on the transfer queue, acquire on the graphics queue.
+			barrier.srcQueueFamilyIndex = transfer_family;
+			barrier.dstQueueFamilyIndex = graphics_family;
+			barrier.dstAccessMask = 0;
+			vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+				1, &barrier, 0, nullptr);
+
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = buffer_read_access;
+			vkCmdPipelineBarrier(
+				batch.graphics_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, buffer_read_stages, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+		} else {
+			barrier.dstAccessMask = buffer_read_access;
+			vkCmdPipelineBarrier(
+				batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, buffer_read_stages, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+		}
+
+		return get_pending_ticket();
+	}
+
+	UploadTicket VulkanUploadManager::upload_image(
+		VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height, VkImageLayout final_layout)
+	{
+		begin_image_upload(image, data, size, width, height);
+		Batch& batch = current;
+
+		if (dedicated_transfer) {
+			auto barrier = image_barrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, final_layout, VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+				transfer_family, graphics_family);
+			vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+				0, nullptr, 1, &barrier);
+
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			vkCmdPipelineBarrier(batch.graphics_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
+				nullptr, 0, nullptr, 1, &barrier);
+		} else {
+			auto barrier
+				= image_barrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, final_layout, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+			vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr,
+				0, nullptr, 1, &barrier);
+		}
+
+		return get_pending_ticket();
+	}
+
+	UploadTicket VulkanUploadManager::upload_image(VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height,
+		const std::function<void(VkCommandBuffer)>& record_on_graphics)
+	{
+		begin_image_upload(image, data, size, width, height);
+		Batch& batch = current;
+
+		if (dedicated_transfer) {
+			auto barrier = image_barrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				VK_ACCESS_TRANSFER_WRITE_BIT, 0, transfer_family, graphics_family);
+			vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr,
+				0, nullptr, 1, &barrier);
+
+			barrier.srcAccessMask = 0;
+			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+			vkCmdPipelineBarrier(batch.graphics_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+				nullptr, 1, &barrier);
+		}
+
+		record_on_graphics(batch.graphics_command_buffer);
+		return get_pending_ticket();
+	}
+
+	void VulkanUploadManager::begin_image_upload(VkImage image, const void* data, VkDeviceSize size, uint32_t width, uint32_t height)
+	{
+		StagingAllocation staging = allocate_staging(size);
+		memcpy(staging.data, data, size);
+
+		Batch& batch = open_batch();
+
+		auto barrier = image_barrier(image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT);
+		vkCmdPipelineBarrier(batch.transfer_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0,
+			nullptr, 1, &barrier);
+
+		VkBufferImageCopy region = {};
+		region.bufferOffset = staging.offset;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent.width = width;
+		region.imageExtent.height = height;
+		region.imageExtent.depth = 1;
+		vkCmdCopyBufferToImage(batch.transfer_command_buffer, staging.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+	}
+
+	UploadTicket VulkanUploadManager::flush()
+	{
+		if (!has_open_batch)
+			return last_submitted;
+
+		Batch batch = std::move(current);
+		current = Batch();
+		has_open_batch = false;
+
+		vk_check(vkEndCommandBuffer(batch.transfer_command_buffer));
+		if (dedicated_transfer)
+			vk_check(vkEndCommandBuffer(batch.graphics_command_buffer));
+
+		batch.value = next_value;
+		next_value += dedicated_transfer ? 2 : 1;
+
+		if (!timeline_semaphores) {
+			VkSubmitInfo submit_info = {};
+			submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submit_info.commandBufferCount = 1;
+			submit_info.pCommandBuffers = &batch.transfer_command_buffer;
+
+			vk_check(vkQueueSubmit(graphics_queue, 1, &submit_info, fence));
+			vk_check(vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX));
+			vk_check(vkResetFences(device, 1, &fence));
+			completed_value = batch.value;
+		} else if (dedicated_transfer) {
+			// The transfer submission signals value - 1, which the graphics submission waits for before acquiring.
+			const uint64_t transfer_value = batch.value - 1;
+
+			VkTimelineSemaphoreSubmitInfo transfer_timeline = {};
+			transfer_timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			transfer_timeline.signalSemaphoreValueCount = 1;
+			transfer_timeline.pSignalSemaphoreValues = &transfer_value;
+
+			VkSubmitInfo transfer_submit = {};
+			transfer_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			transfer_submit.pNext = &transfer_timeline;
+			transfer_submit.commandBufferCount = 1;
+			transfer_submit.pCommandBuffers = &batch.transfer_command_buffer;
+			transfer_submit.signalSemaphoreCount = 1;
+			transfer_submit.pSignalSemaphores = &timeline;
+			vk_check(vkQueueSubmit(transfer_queue, 1, &transfer_submit, nullptr));
+
+			VkTimelineSemaphoreSubmitInfo graphics_timeline = {};
+			graphics_timeline.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			graphics_timeline.waitSemaphoreValueCount = 1;
+			graphics_timeline.pWaitSemaphoreValues = &transfer_value;
+			graphics_timeline.signalSemaphoreValueCount = 1;
+			graphics_timeline.pSignalSemaphoreValues = &batch.value;
+
+			const VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+			VkSubmitInfo graphics_submit = {};
+			graphics_submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			graphics_submit.pNext = &graphics_timeline;
+			graphics_submit.waitSemaphoreCount = 1;
+			graphics_submit.pWaitSemaphores = &timeline;
+			graphics_submit.pWaitDstStageMask = &wait_stage;
+			graphics_submit.commandBufferCount = 1;
+			graphics_submit.pCommandBuffers = &batch.graphics_command_buffer;
+			graphics_submit.signalSemaphoreCount = 1;
+			graphics_submit.pSignalSemaphores = &timeline;
+			vk_check(vkQueueSubmit(graphics_queue, 1, &graphics_submit, nullptr));
+		} else {
+			VkTimelineSemaphoreSubmitInfo timeline_info = {};
+			timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+			timeline_info.signalSemaphoreValueCount = 1;
+			timeline_info.pSignalSemaphoreValues = &batch.value;
+
+			VkSubmitInfo submit_info = {};
+			submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submit_info.pNext = &timeline_info;
+			submit_info.commandBufferCount = 1;
+			submit_info.pCommandBuffers = &batch.transfer_command_buffer;
+			submit_info.signalSemaphoreCount = 1;
+			submit_info.pSignalSemaphores = &timeline;
+			vk_check(vkQueueSubmit(graphics_queue, 1, &submit_info, nullptr));
+		}
+
+		last_submitted = batch.value;
+		in_flight.push_back(std::move(batch));
+		retire_completed();
+		return last_submitted;
+	}
+
+	bool VulkanUploadManager::is_complete(UploadTicket ticket)
+	{
+		if (ticket > last_submitted)
+			return false;
+
+		return get_completed_value() >= ticket;
+	}
+
+	void VulkanUploadManager::wait(UploadTicket ticket)
+	{
+		if (ticket > last_submitted)
+			flush();
+
+		if (timeline_semaphores && get_completed_value() < ticket) {
+			VkSemaphoreWaitInfo wait_info = {};
+			wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+			wait_info.semaphoreCount = 1;
+			wait_info.pSemaphores = &timeline;
+			wait_info.pValues = &ticket;
+			vk_check(vkWaitSemaphores(device, &wait_info, UINT64_MAX));
+		}
+
+		retire_completed();
+	}
+
+	UploadTicket VulkanUploadManager::get_completed_value()
+	{
+		if (timeline_semaphores)
+			vk_check(vkGetSemaphoreCounterValue(device, timeline, &completed_value));
+
+		return completed_value;
+	}
+
+	VulkanUploadManager::Batch& VulkanUploadManager::open_batch()
+	{
+		if (has_open_batch)
+			return current;
+
+		VkCommandBufferAllocateInfo cbai = {};
+		cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		cbai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		cbai.commandBufferCount = 1;
+
+		VkCommandBufferBeginInfo begin_info = {};
+		begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+		cbai.commandPool = transfer_command_pool;
+		vk_check(vkAllocateCommandBuffers(device, &cbai, &current.transfer_command_buffer));
+		vk_check(vkBeginCommandBuffer(current.transfer_command_buffer, &begin_info));
+
+		if (dedicated_transfer) {
+			cbai.commandPool = graphics_command_pool;
+			vk_check(vkAllocateCommandBuffers(device, &cbai, &current.graphics_command_buffer));
+			vk_check(vkBeginCommandBuffer(current.graphics_command_buffer, &begin_info));
+		} else {
+			current.graphics_command_buffer = current.transfer_command_buffer;
+		}
+
+		has_open_batch = true;
+		return current;
+	}
+
+	VulkanUploadManager::StagingAllocation VulkanUploadManager::allocate_staging(VkDeviceSize size)
+	{
+		size = (size + staging_alignment - 1) & ~(staging_alignment - 1);
+
+		if (size > ring_size) {
+			// Too big for the ring; gets a buffer of its own that lives as long as the batch.
+			VulkanAllocator allocator("UploadManager");
+			VkBufferCreateInfo bci = {};
+			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bci.size = size;
+			bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+			StagingAllocation result;
+			DedicatedStaging dedicated;
+			void* mapped = nullptr;
+			dedicated.allocation = allocator.allocate_mapped_buffer(bci, dedicated.buffer, mapped);
+			result.buffer = dedicated.buffer;
+			result.data = (uint8_t*)mapped;
+			open_batch().dedicated_staging.push_back(dedicated);
+			return result;
+		}
+
+		StagingAllocation result;
+		while (!try_allocate_ring(size, result)) {
+			// Out of staging memory: submit what is recorded and wait for the oldest batch to hand its space back.
+			if (has_open_batch)
+				flush();
+
+			core_assert(!in_flight.empty(), "Upload staging ring is full without any uploads in flight.");
+			wait(in_flight.front().value);
+		}
+
+		return result;
+	}
+
+	bool VulkanUploadManager::try_allocate_ring(VkDeviceSize size, StagingAllocation& out)
+	{
+		if (ring_used == 0)
+			ring_head = 0;
+		if (ring_used == ring_size)
+			return false;
+
+		// Free space is [head, tail) modulo the ring size.
+		const VkDeviceSize tail = (ring_head + ring_size - ring_used) % ring_size;
+
+		VkDeviceSize offset = ring_head;
+		VkDeviceSize consumed = size;
+		if (ring_head >= tail) {
+			if (ring_head + size > ring_size) {
+				if (size > tail)
+					return false;
+
+				// Skip the end of the ring; the padding is handed back with this batch.
+				offset = 0;
+				consumed = (ring_size - ring_head) + size;
+			}
+		} else if (ring_head + size > tail) {
+			return false;
+		}
+
+		ring_head = (offset + size) % ring_size;
+		ring_used += consumed;
+		current.ring_bytes += consumed;
+
+		out.buffer = ring_buffer;
+		out.offset = offset;
+		out.data = ring_data + offset;
+		return true;
+	}
+
+	void VulkanUploadManager::retire_completed()
+	{
+		if (in_flight.empty())
+			return;
+
+		const UploadTicket completed = get_completed_value();
+		VulkanAllocator allocator("UploadManager");
+		while (!in_flight.empty() && in_flight.front().value <= completed) {
+			Batch& batch = in_flight.front();
+
+			vkFreeCommandBuffers(device, transfer_command_pool, 1, &batch.transfer_command_buffer);
+			if (dedicated_transfer)
+				vkFreeCommandBuffers(device, graphics_command_pool, 1, &batch.graphics_command_buffer);
+
+			for (auto& dedicated : batch.dedicated_staging)
+				allocator.destroy_buffer(dedicated.buffer, dedicated.allocation);
+
+			ring_used -= batch.ring_bytes;
+			in_flight.pop_front();
+		}
+	}
+
+} // namespace ForgottenEngine
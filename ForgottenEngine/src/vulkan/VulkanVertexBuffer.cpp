@@ -11,6 +11,21 @@ namespace ForgottenEngine {
 	VulkanVertexBuffer::VulkanVertexBuffer(uint32_t size, VertexBufferUsage usage)
 		: size(size)
 	{
+		if (usage == VertexBufferUsage::Stream) {
+			// Created here rather than on the render thread, so the caller can write into it straight away.
+			VulkanAllocator allocator("VertexBuffer");
+
+			VkBufferCreateInfo vbci = {};
+			vbci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			vbci.size = (VkDeviceSize)size * Renderer::get_config().frames_in_flight;
+			vbci.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+			void* mapped = nullptr;
+			memory_allocation = allocator.allocate_mapped_buffer(vbci, vulkan_buffer, mapped);
+			mapped_data = (uint8_t*)mapped;
+			return;
+		}
+
 		local_data.allocate(size);
 
 		Reference<VulkanVertexBuffer> instance = this;
@@ -37,34 +52,13 @@ namespace ForgottenEngine {
 			auto device = VulkanContext::get_current_device();
 			VulkanAllocator allocator("VertexBuffer");
 
-			VkBufferCreateInfo bci {};
-			bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			bci.size = instance->size;
-			bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VkBuffer staging_buffer;
-			VmaAllocation staging_buffer_allocation = allocator.allocate_buffer(bci, VMA_MEMORY_USAGE_CPU_TO_GPU, staging_buffer);
-
-			// copy data to staging buffer
-			auto* dest_data = allocator.map_memory<uint8_t>(staging_buffer_allocation);
-			memcpy(dest_data, instance->local_data.data, instance->local_data.size);
-			allocator.unmap_memory(staging_buffer_allocation);
-
 			VkBufferCreateInfo vbci = {};
 			vbci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 			vbci.size = instance->size;
 			vbci.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 			instance->memory_allocation = allocator.allocate_buffer(vbci, VMA_MEMORY_USAGE_GPU_ONLY, instance->vulkan_buffer);
 
-			VkCommandBuffer copy_cmd = device->get_command_buffer(true);
-
-			VkBufferCopy copy_region = {};
-			copy_region.size = instance->local_data.size;
-			vkCmdCopyBuffer(copy_cmd, staging_buffer, instance->vulkan_buffer, 1, &copy_region);
-
-			device->flush_command_buffer(copy_cmd);
-
-			allocator.destroy_buffer(staging_buffer, staging_buffer_allocation);
+			device->get_upload_manager()->upload_buffer(instance->vulkan_buffer, instance->local_data.data, instance->local_data.size);
 		});
 	}
 
@@ -81,8 +75,21 @@ namespace ForgottenEngine {
 		local_data.release();
 	}
 
+	void* VulkanVertexBuffer::get_mapped_region(uint32_t frame_index) { return mapped_data ? mapped_data + (size_t)frame_index * size : nullptr; }
+
+	VkDeviceSize VulkanVertexBuffer::rt_get_offset() const
+	{
+		return mapped_data ? (VkDeviceSize)Renderer::rt_get_current_frame_index() * size : 0;
+	}
+
 	void VulkanVertexBuffer::set_data(void* buffer, uint32_t in_size, uint32_t offset)
 	{
+		if (mapped_data) {
+			core_assert(in_size <= size, "Size is less than local in_size.");
+			memcpy(get_mapped_region(Renderer::get_current_frame_index()), (uint8_t*)buffer + offset, in_size);
+			return;
+		}
+
 		core_assert(in_size <= local_data.size, "Size is less than local in_size.");
 		memcpy(local_data.data, (uint8_t*)buffer + offset, in_size);
 		;
@@ -92,6 +99,11 @@ namespace ForgottenEngine {
 
 	void VulkanVertexBuffer::rt_set_data(void* buffer, uint32_t in_size, uint32_t offset)
 	{
+		if (mapped_data) {
+			memcpy(get_mapped_region(Renderer::rt_get_current_frame_index()), (uint8_t*)buffer + offset, in_size);
+			return;
+		}
+
 		VulkanAllocator allocator("VulkanVertexBuffer");
 		auto* data = allocator.map_memory<uint8_t>(memory_allocation);
 		memcpy(data, (uint8_t*)buffer + offset, in_size);
@@ -2,152 +2,201 @@
 
 #include "vulkan/compiler/VulkanShaderCache.hpp"
 
-#include "utilities/SerializationMacros.hpp"
+#include "serialize/FileStream.hpp"
 #include "vulkan/compiler/preprocessor/ShaderPreprocessor.hpp"
 #include "vulkan/VulkanShaderUtils.hpp"
-#include "yaml-cpp/yaml.h"
 
 namespace ForgottenEngine {
 
 	static std::filesystem::path cache_path = Assets::slashed_string_to_filepath("shaders/cache/shader_registry.cache");
 
+	namespace {
+		struct RegistryFileHeader {
+			char Magic[4] = { 'F', 'G', 'S', 'C' };
+			uint32_t Version = 1;
+		};
+
+		std::mutex registry_mutex;
+		std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>> registry;
+		bool registry_loaded = false;
+		bool registry_dirty = false;
+	} // namespace
+
 	VkShaderStageFlagBits VulkanShaderCache::has_changed(Reference<VulkanShaderCompiler> shader)
 	{
-		std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>> shader_cache;
+		std::lock_guard lock(registry_mutex);
+		if (!registry_loaded) {
+			if (!deserialize(registry))
+				registry.clear();
+			registry_loaded = true;
+		}
 
-		deserialize(shader_cache);
+		const std::string path = shader->shader_source_path.string();
+		const bool shader_not_cached = registry.find(path) == registry.end();
+		auto& cached_stages = registry[path];
 
 		VkShaderStageFlagBits changed_stages = {};
-		const bool shader_not_cached = shader_cache.find(shader->shader_source_path.string()) == shader_cache.end();
-
 		for (const auto& [stage, stage_source] : shader->shader_source) {
-			// Keep in mind that we're using the [] operator.
-			// Which means that we add the stage if it's not already there.
-			if (shader_not_cached || shader->stages_metadata.at(stage) != shader_cache[shader->shader_source_path.string()][stage]) {
-				shader_cache[shader->shader_source_path.string()][stage] = shader->stages_metadata.at(stage);
+			const auto cached = cached_stages.find(stage);
+			if (shader_not_cached || cached == cached_stages.end() || shader->stages_metadata.at(stage) != cached->second)
 				*(int*)&changed_stages |= stage;
-			}
 		}
 
-		// Update cache in case we added a stage but didn't remove the deleted(in file) stages
-		shader_cache[shader->shader_source_path.string()] = shader->stages_metadata;
-
-		if (changed_stages) {
-			serialize(shader_cache);
+		// Replaced as a whole so stages deleted from the file go too.
+		if (shader_not_cached || cached_stages != shader->stages_metadata) {
+			cached_stages = shader->stages_metadata;
+			registry_dirty = true;
 		}
 
 		return changed_stages;
 	}
 
-	void VulkanShaderCache::serialize(const std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>>& shader_cache)
+	void VulkanShaderCache::flush()
 	{
-		YAML::Emitter out;
-
-		out << YAML::BeginMap << YAML::Key << "ShaderRegistry" << YAML::BeginSeq; // ShaderRegistry_
-
-		for (auto& [filepath, shader] : shader_cache) {
-			out << YAML::BeginMap; // Shader_
-
-			out << YAML::Key << "ShaderPath" << YAML::Value << filepath;
-
-			out << YAML::Key << "Stages" << YAML::BeginSeq; // Stages_
-
-			for (auto& [stage, stageData] : shader) {
-				if (stage == VK_SHADER_STAGE_ALL)
-					continue;
-
-				out << YAML::BeginMap; // Stage_
-
-				out << YAML::Key << "Stage" << YAML::Value << ShaderUtils::shader_stage_to_string(stage).data();
-				out << YAML::Key << "StageHash" << YAML::Value << stageData.HashValue;
-
-				out << YAML::Key << "Headers" << YAML::BeginSeq; // Headers_
-				for (auto& header : stageData.Headers) {
+		std::lock_guard lock(registry_mutex);
+		if (!registry_dirty)
+			return;
 
-					out << YAML::BeginMap;
+		serialize(registry);
+		registry_dirty = false;
+	}
 
-					FG_SERIALIZE_PROPERTY("HeaderPath", header.IncludedFilePath.string(), out);
-					FG_SERIALIZE_PROPERTY("IncludeDepth", header.IncludeDepth, out);
-					FG_SERIALIZE_PROPERTY("IsRelative", header.IsRelative, out);
-					FG_SERIALIZE_PROPERTY("IsGuarded", header.IsGuarded, out);
-					FG_SERIALIZE_PROPERTY("HashValue", header.HashValue, out);
+	void VulkanShaderCache::serialize(const Registry& shader_cache)
+	{
+		const auto path = Assets::get_base_directory() / cache_path;
+		auto temporary_path = path;
+		temporary_path += ".tmp";
+
+		{
+			FileStreamWriter serializer(temporary_path);
+			if (!serializer) {
+				CORE_ERROR("Could not open {} output path.", temporary_path);
+				return;
+			}
 
-					out << YAML::EndMap;
+			serializer.write_raw(RegistryFileHeader());
+			serializer.write_raw<uint32_t>((uint32_t)shader_cache.size());
+			for (const auto& [filepath, shader] : shader_cache) {
+				serializer.write_string(filepath);
+
+				uint32_t stage_count = 0;
+				for (const auto& [stage, stage_data] : shader)
+					stage_count += stage != VK_SHADER_STAGE_ALL;
+				serializer.write_raw<uint32_t>(stage_count);
+
+				for (const auto& [stage, stage_data] : shader) {
+					if (stage == VK_SHADER_STAGE_ALL)
+						continue;
+
+					serializer.write_raw<uint32_t>((uint32_t)stage);
+					serializer.write_raw<uint32_t>(stage_data.HashValue);
+					serializer.write_raw<uint32_t>((uint32_t)stage_data.Headers.size());
+					for (const auto& header : stage_data.Headers) {
+						serializer.write_string(header.IncludedFilePath.string());
+						serializer.write_raw<uint32_t>((uint32_t)header.IncludeDepth);
+						serializer.write_raw<uint8_t>(header.IsRelative);
+						serializer.write_raw<uint8_t>(header.IsGuarded);
+						serializer.write_raw<uint32_t>(header.HashValue);
+					}
 				}
-				out << YAML::EndSeq; // Headers_
-
-				out << YAML::EndMap; // Stage_
 			}
-			out << YAML::EndSeq; // Stages_
-			out << YAML::EndMap; // Shader_
-		}
-		out << YAML::EndSeq; // ShaderRegistry_
-		out << YAML::EndMap; // File_
-
-		std::ofstream output(Assets::get_base_directory() / cache_path);
 
-		if (!output) {
-			CORE_ERROR("Could not open {} output path.", Assets::get_base_directory() / cache_path);
-			return;
+			if (!serializer) {
+				CORE_ERROR("[ShaderCache] Could not write the shader registry to {}.", temporary_path);
+				return;
+			}
 		}
 
-		output << out.c_str();
+		std::error_code error;
+		std::filesystem::rename(temporary_path, path, error);
+		if (error)
+			CORE_ERROR("[ShaderCache] Could not replace {}: {}", path, error.message());
 	}
 
-	void VulkanShaderCache::deserialize(std::unordered_map<std::string, std::unordered_map<VkShaderStageFlagBits, StageData>>& shader_cache)
+	// The registry is only a record of what was compiled, so a damaged file is a reason to rebuild it: reads report
+	// failure instead of asserting like StreamReader::read_raw.
+	template <typename T> static bool read_value(FileStreamReader& reader, T& value) { return reader.read_data((char*)&value, sizeof(T)); }
+
+	static bool read_string(FileStreamReader& reader, uint64_t file_size, std::string& string)
 	{
-		// Read registry
-		std::ifstream stream(Assets::get_base_directory() / cache_path);
-		if (!stream) {
-			CORE_ERROR("Could not load cache directory at {}", cache_path);
-			return;
-		}
+		size_t length = 0;
+		if (!read_value(reader, length))
+			return false;
 
-		std::stringstream str_stream;
-		str_stream << stream.rdbuf();
+		// Checked before the resize, a corrupt length could otherwise ask for any amount of memory.
+		const uint64_t position = reader.get_stream_position();
+		if (position > file_size || length > file_size - position)
+			return false;
 
-		YAML::Node data = YAML::Load(str_stream.str());
-		auto handles = data["ShaderRegistry"];
-		if (handles.IsNull()) {
-			CORE_ERROR("[ShaderCache] Shader Registry is invalid.");
-			return;
-		}
+		string.resize(length);
+		return reader.read_data(string.data(), length);
+	}
 
-		// Old format
-		if (handles.IsMap()) {
-			CORE_ERROR("[ShaderCache] Old Shader Registry format.");
-			return;
+	bool VulkanShaderCache::deserialize(Registry& shader_cache)
+	{
+		const auto path = Assets::get_base_directory() / cache_path;
+		std::error_code error;
+		const uint64_t file_size = std::filesystem::file_size(path, error);
+		if (error)
+			return false;
+
+		FileStreamReader serializer(path);
+		if (!serializer)
+			return false;
+
+		RegistryFileHeader expected;
+		RegistryFileHeader header;
+		if (!read_value(serializer, header) || memcmp(header.Magic, expected.Magic, sizeof(header.Magic)) != 0
+			|| header.Version != expected.Version) {
+			// Written by an older engine, possibly still in YAML; everything compiles once and it is rewritten.
+			CORE_WARN("[ShaderCache] Shader registry has an unknown format and will be rebuilt.");
+			return false;
 		}
 
-		for (auto shader : handles) {
-			std::string path;
-			FG_DESERIALIZE_PROPERTY("ShaderPath", path, shader, std::string());
-			for (auto stage : shader["Stages"]) // Stages
-			{
-				std::string stage_type;
-				uint32_t stage_hash;
-				FG_DESERIALIZE_PROPERTY("Stage", stage_type, stage, std::string());
-				FG_DESERIALIZE_PROPERTY("StageHash", stage_hash, stage, 0u);
-
-				auto& stage_cache = shader_cache[path][ShaderUtils::shader_type_from_string(stage_type)];
-				stage_cache.HashValue = stage_hash;
-
-				for (auto header : stage["Headers"]) {
-					std::string header_path;
-					uint32_t include_depth;
-					bool is_relative;
-					bool is_guarded;
-					uint32_t hash_value;
-					FG_DESERIALIZE_PROPERTY("HeaderPath", header_path, header, std::string());
-					FG_DESERIALIZE_PROPERTY("IncludeDepth", include_depth, header, 0u);
-					FG_DESERIALIZE_PROPERTY("IsRelative", is_relative, header, false);
-					FG_DESERIALIZE_PROPERTY("IsGuarded", is_guarded, header, false);
-					FG_DESERIALIZE_PROPERTY("HashValue", hash_value, header, 0u);
-
-					stage_cache.Headers.emplace(IncludeData { header_path, include_depth, is_relative, is_guarded, hash_value });
+		auto read_registry = [&]() {
+			uint32_t shader_count = 0;
+			if (!read_value(serializer, shader_count))
+				return false;
+
+			for (uint32_t i = 0; i < shader_count; i++) {
+				std::string shader_path;
+				uint32_t stage_count = 0;
+				if (!read_string(serializer, file_size, shader_path) || !read_value(serializer, stage_count))
+					return false;
+				auto& shader = shader_cache[shader_path];
+
+				for (uint32_t j = 0; j < stage_count; j++) {
+					uint32_t stage = 0;
+					uint32_t header_count = 0;
+					StageData stage_cache;
+					if (!read_value(serializer, stage) || !read_value(serializer, stage_cache.HashValue) || !read_value(serializer, header_count))
+						return false;
+
+					for (uint32_t k = 0; k < header_count; k++) {
+						std::string header_path;
+						uint32_t include_depth = 0;
+						uint8_t is_relative = 0;
+						uint8_t is_guarded = 0;
+						uint32_t hash_value = 0;
+						if (!read_string(serializer, file_size, header_path) || !read_value(serializer, include_depth)
+							|| !read_value(serializer, is_relative) || !read_value(serializer, is_guarded) || !read_value(serializer, hash_value))
+							return false;
+
+						stage_cache.Headers.emplace(IncludeData { header_path, include_depth, is_relative != 0, is_guarded != 0, hash_value });
+					}
+
+					shader[(VkShaderStageFlagBits)stage] = std::move(stage_cache);
 				}
 			}
+			return true;
+		};
+
+		if (!read_registry()) {
+			CORE_ERROR("[ShaderCache] Shader registry is truncated or damaged and will be rebuilt.");
+			return false;
 		}
+
+		return true;
 	}
 
 } // namespace ForgottenEngine
@@ -4,6 +4,7 @@
 
 #include "render/Renderer.hpp"
 #include "serialize/FileStream.hpp"
+#include "ThreadPool.hpp"
 #include "utilities/StringUtils.hpp"
 #include "vulkan/compiler/preprocessor/GlslIncluder.hpp"
 #include "vulkan/compiler/VulkanShaderCache.hpp"
@@ -25,6 +26,20 @@ namespace ForgottenEngine {
 
 	namespace Utils {
 
+		using Clock = std::chrono::steady_clock;
+
+		static float milliseconds_since(Clock::time_point start)
+		{
+			return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+		}
+
+		/// shaderc compilers are used by one thread at a time: each thread that compiles gets its own.
+		static shaderc::Compiler& get_thread_compiler()
+		{
+			thread_local shaderc::Compiler compiler;
+			return compiler;
+		}
+
 		static std::filesystem::path get_cache_directory()
 		{
 			auto cache_dir_local = Assets::slashed_string_to_filepath("shaders/cache/vulkan");
@@ -86,102 +101,126 @@ namespace ForgottenEngine {
 		language = ShaderUtils::shader_lang_from_extension(shader_source_path.extension().string());
 	}
 
-	bool VulkanShaderCompiler::reload(bool force_compile)
+	bool VulkanShaderCompiler::reload(bool force)
 	{
+		begin_reload(force);
+		for (const auto& [stage, source] : shader_source)
+			pre_process_stage(stage);
+		end_pre_process();
+
+		bool compile_success = true;
+		for (const auto& [stage, source] : shader_source)
+			compile_success = compile_success && compile_stage(stage, true) && compile_stage(stage, false);
+
+		return end_reload(compile_success);
+	}
+
+	void VulkanShaderCompiler::begin_reload(bool force)
+	{
+		force_compile = force;
 		shader_source.clear();
 		stages_metadata.clear();
+		stage_macros.clear();
+		stage_timings.clear();
 		spirv_debug_data.clear();
 		spirv_data.clear();
 
 		Utils::create_cache_directory_if_needed();
 		const std::string source = StringUtils::read_file_and_skip_bom(shader_source_path);
 		core_verify(source.size(), "Failed to load shader!");
-
-		shader_source = pre_process(source);
-		const VkShaderStageFlagBits changed_stages = VulkanShaderCache::has_changed(this);
-
-		bool compile_success = compile_or_get_vulkan_binaries(spirv_debug_data, spirv_data, changed_stages, force_compile);
-		if (!compile_success) {
-			core_assert_bool(false);
-			return false;
+		core_assert(language == ShaderUtils::SourceLang::GLSL, "Only GLSL supported.");
+
+		shader_source = ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(source, acknowledged_macros);
+		for (const auto& [stage, stage_source] : shader_source) {
+			stages_metadata[stage];
+			stage_macros[stage];
+			stage_timings[stage];
+			spirv_debug_data[stage];
+			spirv_data[stage];
 		}
-
-		// Reflection
-		if (force_compile || changed_stages || !try_read_cached_reflection_data()) {
-			reflect_all_shader_stages(spirv_debug_data);
-			serialize_reflection_data();
-		}
-
-		return true;
-	}
-
-	void VulkanShaderCompiler::clear_uniform_buffers()
-	{
-		compiler_uniform_buffers.clear();
-		compiler_storage_buffers.clear();
-	}
-
-	std::unordered_map<VkShaderStageFlagBits, std::string> VulkanShaderCompiler::pre_process(const std::string& source)
-	{
-		switch (language) {
-		case ShaderUtils::SourceLang::GLSL:
-			return pre_process_glsl(source);
-		default:
-			core_assert(false, "Only GLSL supported.");
-		}
-		return {};
 	}
 
-	std::unordered_map<VkShaderStageFlagBits, std::string> VulkanShaderCompiler::pre_process_glsl(const std::string& source)
+	void VulkanShaderCompiler::pre_process_stage(VkShaderStageFlagBits stage)
 	{
-		auto shaderSources = ShaderPreprocessor::PreprocessShader<ShaderUtils::SourceLang::GLSL>(source, acknowledged_macros);
-
-		static shaderc::Compiler compiler;
+		const auto start = Utils::Clock::now();
+		std::string& stage_source = shader_source.at(stage);
 
 		shaderc_util::FileFinder fileFinder;
 		fileFinder.search_path().emplace_back("Include/GLSL/"); // Main include directory
 		fileFinder.search_path().emplace_back("Include/Common/"); // Shared include directory
-		for (auto& [stage, shader_source] : shaderSources) {
-			shaderc::CompileOptions options;
-			options.AddMacroDefinition("__GLSL__");
-			options.AddMacroDefinition(std::string(ShaderUtils::vk_stage_to_shader_macro(stage)));
 
-			const auto& globalMacros = Renderer::get_global_shader_macros();
-			for (const auto& [name, value] : globalMacros)
-				options.AddMacroDefinition(name, value);
+		shaderc::CompileOptions options;
+		options.AddMacroDefinition("__GLSL__");
+		options.AddMacroDefinition(std::string(ShaderUtils::vk_stage_to_shader_macro(stage)));
 
-			// Deleted by shaderc and created per stage
-			GlslIncluder* includer = new GlslIncluder(&fileFinder);
-			options.SetIncluder(std::unique_ptr<GlslIncluder>(includer));
+		const auto& globalMacros = Renderer::get_global_shader_macros();
+		for (const auto& [name, value] : globalMacros)
+			options.AddMacroDefinition(name, value);
 
-			struct PreprocessorOptions {
-				std::string source;
-				shaderc_shader_kind stage;
-				const char* file_path;
-				shaderc::CompileOptions options;
-			};
+		// Deleted by shaderc and created per stage
+		GlslIncluder* includer = new GlslIncluder(&fileFinder);
+		options.SetIncluder(std::unique_ptr<GlslIncluder>(includer));
 
-			const auto fp = Assets::c_str(shader_source_path);
+		const auto result = Utils::get_thread_compiler().PreprocessGlsl(
+			stage_source, ShaderUtils::shader_stage_to_shader_c(stage), Assets::c_str(shader_source_path), options);
 
-			PreprocessorOptions preprocessor_options
-				= { .source = shader_source, .stage = ShaderUtils::shader_stage_to_shader_c(stage), .file_path = fp, .options = options };
+		if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+			CORE_ERROR("Renderer",
+				fmt::format("Failed to pre-process \"{}\"'s {} shader.\nError: {}", shader_source_path.string(),
+					ShaderUtils::shader_stage_to_string(stage), result.GetErrorMessage()));
 
-			const auto result = compiler.PreprocessGlsl(
-				preprocessor_options.source, preprocessor_options.stage, preprocessor_options.file_path, preprocessor_options.options);
+		auto& metadata = stages_metadata.at(stage);
+		metadata.HashValue = Hash::generate_fnv_hash(stage_source);
+		metadata.Headers = std::move(includer->get_include_data());
+		stage_macros.at(stage) = std::move(includer->get_parsed_special_macros());
 
-			if (result.GetCompilationStatus() != shaderc_compilation_status_success)
-				CORE_ERROR("Renderer",
-					fmt::format("Failed to pre-process \"{}\"'s {} shader.\nError: {}", shader_source_path.string(),
-						ShaderUtils::shader_stage_to_string(stage), result.GetErrorMessage()));
+		stage_source = std::string(result.begin(), result.end());
+		stage_timings.at(stage).pre_process_ms = Utils::milliseconds_since(start);
+	}
+
+	void VulkanShaderCompiler::end_pre_process()
+	{
+		for (auto& [stage, macros] : stage_macros)
+			acknowledged_macros.merge(macros);
 
-			stages_metadata[stage].HashValue = Hash::generate_fnv_hash(shader_source);
-			stages_metadata[stage].Headers = std::move(includer->get_include_data());
+		changed_stages = VulkanShaderCache::has_changed(this);
+	}
 
-			acknowledged_macros.merge(includer->get_parsed_special_macros());
+	bool VulkanShaderCompiler::compile_stage(VkShaderStageFlagBits stage, bool debug)
+	{
+		auto& output = debug ? spirv_debug_data.at(stage) : spirv_data.at(stage);
+		return compile_or_get_vulkan_binary(stage, output, debug, changed_stages, force_compile);
+	}
 
-			shader_source = std::string(result.begin(), result.end());
+	bool VulkanShaderCompiler::end_reload(bool compile_success)
+	{
+		if (!compile_success) {
+			core_assert_bool(false);
+			return false;
+		}
+
+		// Reflection
+		if (force_compile || changed_stages || !try_read_cached_reflection_data()) {
+			reflect_all_shader_stages(spirv_debug_data);
+			serialize_reflection_data();
+		}
+
+		float pre_process_ms = 0.0f;
+		float compile_ms = 0.0f;
+		float cache_ms = 0.0f;
+		uint32_t compiled_count = 0;
+		uint32_t cached_count = 0;
+		for (const auto& [stage, timings] : stage_timings) {
+			pre_process_ms += timings.pre_process_ms;
+			for (size_t i = 0; i < timings.binary_ms.size(); i++) {
+				(timings.from_cache[i] ? cache_ms : compile_ms) += timings.binary_ms[i];
+				(timings.from_cache[i] ? cached_count : compiled_count)++;
+			}
 		}
-		return shaderSources;
+		CORE_INFO("[Shader] {}: pre-processed in {:.2f} ms, {} binaries compiled in {:.2f} ms, {} read from cache in {:.2f} ms",
+			shader_source_path.filename().string(), pre_process_ms, compiled_count, compile_ms, cached_count, cache_ms);
+
+		return true;
 	}
 
 	std::string VulkanShaderCompiler::compile(
@@ -190,10 +229,9 @@ namespace ForgottenEngine {
 		const std::string& stage_source = shader_source.at(stage);
 
 		if (language == ShaderUtils::SourceLang::GLSL) {
-			static shaderc::Compiler compiler;
 			shaderc::CompileOptions shader_c_options;
 #ifdef FORGOTTEN_WINDOWS
-			shaderCOptions.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
+			shader_c_options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
 #elif defined(FORGOTTEN_MACOS)
 			shader_c_options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_1);
 #endif
@@ -205,7 +243,7 @@ namespace ForgottenEngine {
 				shader_c_options.SetOptimizationLevel(shaderc_optimization_level_performance);
 
 			// compile shader
-			const shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+			const shaderc::SpvCompilationResult module = Utils::get_thread_compiler().CompileGlslToSpv(
 				stage_source, ShaderUtils::shader_stage_to_shader_c(stage), shader_source_path.string().c_str(), shader_c_options);
 
 			if (module.GetCompilationStatus() != shaderc_compilation_status_success)
@@ -220,15 +258,76 @@ namespace ForgottenEngine {
 
 	Reference<VulkanShader> VulkanShaderCompiler::compile(const std::filesystem::path& shader_source_path, bool force_compile, bool disable_optim)
 	{
-		auto new_name = shader_source_path.filename().stem().string();
+		Reference<VulkanShaderCompiler> compiler = Reference<VulkanShaderCompiler>::create(shader_source_path, disable_optim);
+		compiler->reload(force_compile);
+		VulkanShaderCache::flush();
+
+		return create_shader(compiler);
+	}
+
+	std::vector<Reference<VulkanShader>> VulkanShaderCompiler::compile(
+		std::span<const std::filesystem::path> shader_source_paths, bool force_compile, bool disable_optim)
+	{
+		const auto start = Utils::Clock::now();
+
+		struct StageJob {
+			VulkanShaderCompiler* compiler;
+			VkShaderStageFlagBits stage;
+		};
+
+		std::vector<Reference<VulkanShaderCompiler>> compilers;
+		std::vector<size_t> first_jobs; // Into stage_jobs, per compiler, plus one past the end.
+		std::vector<StageJob> stage_jobs;
+		compilers.reserve(shader_source_paths.size());
+		for (const auto& path : shader_source_paths) {
+			auto& compiler = compilers.emplace_back(Reference<VulkanShaderCompiler>::create(path, disable_optim));
+			compiler->begin_reload(force_compile);
+
+			first_jobs.push_back(stage_jobs.size());
+			for (const auto& [stage, source] : compiler->shader_source)
+				stage_jobs.push_back({ compiler.raw(), stage });
+		}
+		first_jobs.push_back(stage_jobs.size());
+
+		auto& pool = ThreadPool::get();
+		pool.parallel_for(static_cast<uint32_t>(stage_jobs.size()), [&stage_jobs](uint32_t i) {
+			stage_jobs[i].compiler->pre_process_stage(stage_jobs[i].stage);
+		});
+
+		// The shader registry is shared, so the change check stays on this thread.
+		for (auto& compiler : compilers)
+			compiler->end_pre_process();
+
+		// Debug and release binaries of every stage at once.
+		std::vector<uint8_t> compiled(stage_jobs.size() * 2);
+		pool.parallel_for(static_cast<uint32_t>(compiled.size()), [&stage_jobs, &compiled](uint32_t i) {
+			const StageJob& job = stage_jobs[i / 2];
+			compiled[i] = job.compiler->compile_stage(job.stage, i % 2 == 0);
+		});
+
+		std::vector<Reference<VulkanShader>> shaders;
+		shaders.reserve(compilers.size());
+		for (size_t i = 0; i < compilers.size(); i++) {
+			const bool success = std::all_of(compiled.begin() + first_jobs[i] * 2, compiled.begin() + first_jobs[i + 1] * 2, [](uint8_t c) { return c; });
+			compilers[i]->end_reload(success);
+			shaders.push_back(create_shader(compilers[i]));
+		}
+
+		VulkanShaderCache::flush();
+
+		CORE_INFO("[Shader] Loaded {} shaders ({} stages) in {:.2f} ms on {} threads.", compilers.size(), stage_jobs.size(),
+			Utils::milliseconds_since(start), pool.get_thread_count());
+		return shaders;
+	}
+
+	Reference<VulkanShader> VulkanShaderCompiler::create_shader(const Reference<VulkanShaderCompiler>& compiler)
+	{
+		auto new_name = compiler->shader_source_path.filename().stem().string();
 
 		Reference<VulkanShader> shader = Reference<VulkanShader>::create();
-		shader->asset_path = shader_source_path;
+		shader->asset_path = compiler->shader_source_path;
 		shader->name = new_name;
-		shader->disable_optimisations = disable_optim;
-
-		Reference<VulkanShaderCompiler> compiler = Reference<VulkanShaderCompiler>::create(shader_source_path, disable_optim);
-		compiler->reload(force_compile);
+		shader->disable_optimisations = compiler->disable_optimization;
 
 		shader->load_and_create_shaders(compiler->get_spirv_data());
 		shader->set_reflection_data(compiler->reflection_data);
@@ -243,6 +342,7 @@ namespace ForgottenEngine {
 	{
 		Reference<VulkanShaderCompiler> compiler = Reference<VulkanShaderCompiler>::create(shader->asset_path, shader->disable_optimisations);
 		bool compile_success = compiler->reload(true);
+		VulkanShaderCache::flush();
 		if (!compile_success)
 			return false;
 
@@ -258,26 +358,12 @@ namespace ForgottenEngine {
 		return true;
 	}
 
-	bool VulkanShaderCompiler::compile_or_get_vulkan_binaries(std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputDebugBinary,
-		std::unordered_map<VkShaderStageFlagBits, std::vector<uint32_t>>& outputBinary, const VkShaderStageFlagBits changedStages,
-		const bool force_compile)
-	{
-		for (auto&& [stage, source] : shader_source) {
-			auto compiled_debug = compile_or_get_vulkan_binary(stage, outputDebugBinary[stage], true, changedStages, force_compile);
-			if (!compiled_debug)
-				return false;
-
-			auto compiled = compile_or_get_vulkan_binary(stage, outputBinary[stage], false, changedStages, force_compile);
-			if (!compiled)
-				return false;
-		}
-		return true;
-	}
-
 	bool VulkanShaderCompiler::compile_or_get_vulkan_binary(
 		VkShaderStageFlagBits stage, std::vector<uint32_t>& output_binary, bool debug, VkShaderStageFlagBits changed_stages, bool force_compile)
 	{
+		const auto start = Utils::Clock::now();
 		const std::filesystem::path cache_dir = Utils::get_cache_directory();
+		auto& timings = stage_timings.at(stage);
 
 		// compile shader with debug info so we can reflect
 		const auto extension = ShaderUtils::shader_stage_cached_file_extension(stage, debug);
@@ -285,6 +371,7 @@ namespace ForgottenEngine {
 		{
 			try_get_vulkan_cached_binary(cache_dir, extension, output_binary);
 		}
+		timings.from_cache[debug] = !output_binary.empty();
 
 		if (output_binary.empty()) {
 			CompilationOptions options;
@@ -320,6 +407,7 @@ namespace ForgottenEngine {
 			}
 		}
 
+		timings.binary_ms[debug] = Utils::milliseconds_since(start);
 		return true;
 	}
 
@@ -538,9 +626,8 @@ namespace ForgottenEngine {
 			uint32_t binding = compiler.get_decoration(resource.id, spv::DecorationBinding);
 			uint32_t descriptorSet = compiler.get_decoration(resource.id, spv::DecorationDescriptorSet);
 			uint32_t dimension = baseType.image.dim;
-			uint32_t arraySize = type.array[0];
-			if (arraySize == 0)
-				arraySize = 1;
+			// An unsized array (sampler2D u_Textures[]) keeps ArraySize 0, which marks the bindless texture table.
+			uint32_t arraySize = type.array.empty() ? 1 : type.array[0];
 			if (descriptorSet >= reflection_data.shader_descriptor_sets.size())
 				reflection_data.shader_descriptor_sets.resize(descriptorSet + 1);
 